@@ -518,6 +518,83 @@ public:
      */
     UXR_AGENT_EXPORT bool load_config_file(const std::string& file_path);
 
+    /**
+     * @brief Makes the FastDDS DataWriters publish asynchronously, so that writes do not wait for the network.
+     *        It shall be called before any client is created. A publisher profile named after a topic,
+     *        loaded through the configuration file, overrides this mode for that topic.
+     * @param max_bytes_per_period  The bytes the DataWriters of a participant may send per period, 0 for no limit.
+     * @param period_ms             The flow controller period in milliseconds.
+     * @param scheduler             The flow controller scheduler: "fifo", "round-robin", "high-priority"
+     *                              or "priority-reservation".
+     * @return true in case of success and false in other case.
+     */
+    UXR_AGENT_EXPORT bool enable_async_publishing(
+            int32_t max_bytes_per_period = 0,
+            uint64_t period_ms = 100,
+            const std::string& scheduler = "fifo");
+
+    /**
+     * @brief Makes the FastDDS participants use a shared memory transport, sized for the given segment,
+     *        along with UDPv4 for remote hosts. It shall be called before any client is created.
+     *        Participants whose profile defines their own transports are not modified.
+     *        See enable_data_sharing for data-sharing delivery.
+     * @param segment_size  The shared memory segment size in bytes.
+     * @return true in case of success and false in other case.
+     */
+    UXR_AGENT_EXPORT bool enable_shared_memory(
+            uint32_t segment_size);
+
+    /**
+     * @brief Bounds the samples of the FastDDS types, so that co-located applications get the samples of unkeyed
+     *        topics through Fast DDS data-sharing. It shall be called before any client is created.
+     *        Larger samples are not published, and profiles turning data-sharing off are honored.
+     * @param max_sample_size   The maximum serialized sample size in bytes.
+     * @return true in case of success and false in other case.
+     */
+    UXR_AGENT_EXPORT bool enable_data_sharing(
+            uint32_t max_sample_size);
+
+    /**
+     * @brief Sets how the instance keys of a keyed type are found in its serialized samples.
+     *        It shall be called before any client is created. Topics of this type become keyed.
+     * @param key_layout    The "<type_name>=<offset>:<length>[:<element_size>],..." specification of the key members,
+     *                      with offsets relative to the serialized sample and little endian elements.
+     * @return true in case of success and false in other case.
+     */
+    UXR_AGENT_EXPORT bool set_key_layout(
+            const std::string& key_layout);
+
+    /**
+     * @brief Sets how many samples the CED middleware keeps per topic for its readers.
+     *        It applies to the topics created afterwards.
+     * @param topic_name    The name of the topic, or an empty string to change the default depth.
+     * @param depth         The number of samples, greater than zero.
+     * @return true in case of success and false in other case.
+     */
+    UXR_AGENT_EXPORT bool set_ced_history_depth(
+            const std::string& topic_name,
+            uint16_t depth);
+
+    /**
+     * @brief Makes the CED topics created afterwards live in host shared memory, so that the clients of
+     *        several agent processes of the same host exchange samples through them. Only on Linux.
+     * @param max_sample_size   The size of the largest sample of the topics, in bytes.
+     *                          Zero goes back to process local topics.
+     * @return true in case of success and false in other case.
+     */
+    UXR_AGENT_EXPORT bool enable_ced_shared_memory(
+            uint32_t max_sample_size);
+
+    /**
+     * @brief Paces all the traffic sent to each client created afterwards to the rate of its link,
+     *        so that concurrent reads do not oversubscribe slow serial or CAN links.
+     *        A client may override it through its "uxr_lr" property.
+     * @param link_rate The link rate in bytes per second, such as the baud rate / 10 for serial links.
+     *                  Zero does not limit the rate.
+     */
+    UXR_AGENT_EXPORT void set_link_rate(
+            uint32_t link_rate);
+
     /**
      * @brief Resets the Root object, that is, removes all the ProxyClients and their entities.
      */
@@ -16,10 +16,11 @@
 #define UXR_AGENT_ROOT_HPP_
 
 #include <uxr/agent/client/ProxyClient.hpp>
+#include <uxr/agent/utils/RcuMap.hpp>
 
 #include <thread>
 #include <memory>
-#include <map>
+#include <vector>
 #include <mutex>
 
 namespace eprosima{
@@ -51,14 +52,52 @@ public:
 
     bool load_config_file(const std::string& file_path);
 
+    bool enable_async_publishing(
+            int32_t max_bytes_per_period,
+            uint64_t period_ms,
+            const std::string& scheduler);
+
+    bool enable_shared_memory(
+            uint32_t segment_size);
+
+    bool enable_data_sharing(
+            uint32_t max_sample_size);
+
+    bool set_key_layout(
+            const std::string& key_layout);
+
+    bool set_ced_history_depth(
+            const std::string& topic_name,
+            uint16_t depth);
+
+    bool enable_ced_shared_memory(
+            uint32_t max_sample_size);
+
+    void set_link_rate(
+            uint32_t link_rate);
+
     void set_verbose_level(uint8_t verbose_level);
 
     void reset();
 
 private:
+    /* Fibonacci hashing, client keys are not guaranteed to be evenly distributed. */
+    struct ClientKeyHash
+    {
+        size_t operator()(uint32_t raw_client_key) const { return size_t((raw_client_key * 2654435761u) >> 16); }
+    };
+
+    /* Lookups take no lock, create and delete serialize on mtx_. */
+    using ClientMap = utils::RcuMap<uint32_t, std::shared_ptr<ProxyClient>, ClientKeyHash>;
+
+    void release_clients();
+
+private:
+    ClientMap clients_;
     std::mutex mtx_;
-    std::map<dds::xrce::ClientKey, std::shared_ptr<ProxyClient>> clients_;
-    std::map<dds::xrce::ClientKey, std::shared_ptr<ProxyClient>>::iterator current_client_;
+    std::mutex iteration_mtx_;
+    std::vector<std::shared_ptr<ProxyClient>> current_clients_;
+    size_t current_client_;
 };
 
 } // uxr
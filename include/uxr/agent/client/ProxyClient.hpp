@@ -18,12 +18,34 @@
 #include <uxr/agent/middleware/Middleware.hpp>
 #include <uxr/agent/participant/Participant.hpp>
 #include <uxr/agent/client/session/Session.hpp>
+#include <uxr/agent/utils/Pacer.hpp>
 #include <unordered_map>
 #include <array>
+#include <atomic>
 
 namespace eprosima {
 namespace uxr {
 
+class DataWriter;
+class DataReader;
+class Requester;
+class Replier;
+
+template<typename T>
+struct HandleKind;
+
+template<>
+struct HandleKind<DataWriter> { static constexpr dds::xrce::ObjectKind value = dds::xrce::OBJK_DATAWRITER; };
+
+template<>
+struct HandleKind<DataReader> { static constexpr dds::xrce::ObjectKind value = dds::xrce::OBJK_DATAREADER; };
+
+template<>
+struct HandleKind<Requester> { static constexpr dds::xrce::ObjectKind value = dds::xrce::OBJK_REQUESTER; };
+
+template<>
+struct HandleKind<Replier> { static constexpr dds::xrce::ObjectKind value = dds::xrce::OBJK_REPLIER; };
+
 class ProxyClient : public std::enable_shared_from_this<ProxyClient>
 {
 public:
@@ -34,12 +56,57 @@ public:
         to_remove
     };
 
+    /**
+     * @brief Typed reference to a data-path object (DataWriter, DataReader, Requester or Replier).
+     *        The object cannot be destroyed while a handle to it is alive.
+     */
+    template<typename T>
+    class Handle
+    {
+    public:
+        Handle(
+                std::atomic<uint32_t>* readers,
+                T* object)
+            : readers_(readers)
+            , object_(object)
+        {}
+
+        Handle(Handle&& other)
+            : readers_(other.readers_)
+            , object_(other.object_)
+        {
+            other.readers_ = nullptr;
+        }
+
+        ~Handle()
+        {
+            if (nullptr != readers_)
+            {
+                readers_->fetch_sub(1);
+            }
+        }
+
+        Handle(const Handle&) = delete;
+        Handle& operator=(Handle&&) = delete;
+        Handle& operator=(const Handle&) = delete;
+
+        explicit operator bool() const { return nullptr != object_; }
+
+        T* operator->() const { return object_; }
+
+        T& operator*() const { return *object_; }
+
+    private:
+        std::atomic<uint32_t>* readers_;
+        T* object_;
+    };
+
     explicit ProxyClient(
             const dds::xrce::CLIENT_Representation& representation,
             Middleware::Kind middleware_kind = Middleware::Kind(0),
             std::unordered_map<std::string, std::string>&& properties = {});
 
-    ~ProxyClient() = default;
+    ~ProxyClient();
 
     ProxyClient(ProxyClient&&) = delete;
     ProxyClient(const ProxyClient&) = delete;
@@ -62,12 +129,19 @@ public:
 
     std::shared_ptr<XRCEObject> get_object(const dds::xrce::ObjectId& object_id);
 
+    /* Lock-free, RTTI-free lookup for the WRITE_DATA/READ_DATA paths. */
+    template<typename T>
+    Handle<T> get_handle(const dds::xrce::ObjectId& object_id);
+
     const dds::xrce::ClientKey& get_client_key() const { return representation_.client_key(); }
 
     dds::xrce::SessionId get_session_id() const { return representation_.session_id(); }
 
     void release();
 
+    /* Released clients are being deleted and must not be used anymore. */
+    bool is_released() const { return released_.load(); }
+
     Session& session();
 
     State get_state();
@@ -79,6 +153,13 @@ public:
     bool has_hard_liveliness_check() const { return hard_liveliness_check_; }
 
     uint8_t & get_hard_liveliness_check_tries() { return hard_liveliness_check_tries_; }
+
+    /* Meters all the traffic sent to the client against its link rate. */
+    utils::Pacer& get_link_pacer() { return link_pacer_; }
+
+    /* Link rate in bytes per second of the clients created afterwards, 0 for no limit. */
+    static void set_default_link_rate(uint32_t link_rate);
+
 private:
     bool create_object(
             const dds::xrce::ObjectId& object_id,
@@ -128,11 +209,33 @@ private:
     bool delete_object_unlock(
             const dds::xrce::ObjectId& object_id);
 
+    void register_handle(
+            const dds::xrce::ObjectId& object_id,
+            XRCEObject* object);
+
+    void unregister_handle(
+            const dds::xrce::ObjectId& object_id);
+
+    static uint16_t handle_index(const dds::xrce::ObjectId& object_id)
+    {
+        return uint16_t((object_id[0] << 4) | (object_id[1] >> 4));
+    }
+
 private:
+    /* One slot per 12-bit object id, allocated on demand for each object kind.
+       Its readers count keeps the object alive, a deletion only waits for those of its own slot. */
+    struct HandleSlot
+    {
+        std::atomic<void*> object{nullptr};
+        std::atomic<uint32_t> readers{0};
+    };
+    using HandleSlots = std::array<HandleSlot, 4096>;
+
     const dds::xrce::CLIENT_Representation representation_;
     std::unique_ptr<Middleware> middleware_;
     std::mutex mtx_;
     XRCEObject::ObjectContainer objects_;
+    std::array<std::atomic<HandleSlots*>, 16> handles_;
     Session session_;
     std::mutex state_mtx_;
     State state_;
@@ -141,8 +244,30 @@ private:
     std::chrono::milliseconds client_dead_time_;
     bool hard_liveliness_check_;
     uint8_t  hard_liveliness_check_tries_;
+    utils::Pacer link_pacer_;
+    std::atomic<bool> released_;
 };
 
+template<typename T>
+inline ProxyClient::Handle<T> ProxyClient::get_handle(const dds::xrce::ObjectId& object_id)
+{
+    std::atomic<uint32_t>* readers = nullptr;
+    T* object = nullptr;
+    if (HandleKind<T>::value == (object_id[1] & 0x0F))
+    {
+        HandleSlots* slots = handles_[HandleKind<T>::value].load();
+        if (nullptr != slots)
+        {
+            /* Counted before the object is loaded, paired with the exchange of unregister_handle. */
+            HandleSlot& slot = (*slots)[handle_index(object_id)];
+            readers = &slot.readers;
+            readers->fetch_add(1);
+            object = static_cast<T*>(slot.object.load());
+        }
+    }
+    return Handle<T>(readers, object);
+}
+
 } // namespace uxr
 } // namespace eprosima
 
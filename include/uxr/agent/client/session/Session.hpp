@@ -21,7 +21,10 @@
 #include <uxr/agent/utils/SharedMutex.hpp>
 
 #include <unordered_map>
+#include <algorithm>
 #include <memory>
+#include <vector>
+#include <chrono>
 
 namespace eprosima {
 namespace uxr {
@@ -41,11 +44,32 @@ inline bool is_reliable_stream(dds::xrce::StreamId stream_id)
     return (dds::xrce::STREAMID_BUILTIN_RELIABLE <= stream_id);
 }
 
+/**
+ * @brief   ACKNACK policy of a session.
+ *          An ACKNACK is sent once max_pending reliable messages have been received on a stream
+ *          or once the oldest unacknowledged one is max_delay old, whichever comes first.
+ */
+struct AckPolicy
+{
+    AckPolicy(
+            uint16_t pending = ACKNACK_MAX_PENDING,
+            std::chrono::milliseconds delay = ACKNACK_MAX_DELAY)
+        : max_pending{pending}
+        , max_delay{delay}
+    {}
+
+    uint16_t max_pending;
+    std::chrono::milliseconds max_delay;
+};
+
 class Session
 {
 public:
-    Session(const SessionInfo& info)
+    Session(
+            const SessionInfo& info,
+            const AckPolicy& ack_policy = AckPolicy{})
         : session_info_(info)
+        , ack_policy_(ack_policy)
         , none_ostream_{}
     {}
 
@@ -85,15 +109,40 @@ public:
             dds::xrce::StreamId stream_id,
             InputMessagePtr& message);
 
+    /* Acknowledgement functions. */
+    const SessionInfo& get_session_info() const { return session_info_; }
+
+    void schedule_acknack(
+            dds::xrce::StreamId stream_id);
+
+    bool pop_acknacks(
+            std::vector<dds::xrce::ACKNACK_Payload>& acknacks,
+            bool force);
+
+    /* Deadline of the earliest delayed ACKNACK, only if no timer is already armed to serve it. */
+    bool pop_acknack_deadline(
+            std::chrono::steady_clock::time_point& deadline);
+
     /* Output streams functions. */
     std::vector<uint8_t> get_output_streams();
 
+    /* format_flags carry the DataFormat of DATA submessages. */
     template<class T>
     bool push_output_submessage(
             dds::xrce::StreamId stream_id,
             dds::xrce::SubmessageId submessage_id,
             const T& submessage,
-            std::chrono::milliseconds timeout);
+            std::chrono::milliseconds timeout,
+            uint8_t format_flags = 0x00);
+
+    /* Non-blocking push, on_window is run once a full reliable window has room again. */
+    template<class T>
+    PushResult try_push_output_submessage(
+            dds::xrce::StreamId stream_id,
+            dds::xrce::SubmessageId submessage_id,
+            const T& submessage,
+            std::function<void()> on_window,
+            uint8_t format_flags = 0x00);
 
     bool get_next_output_message(
             dds::xrce::StreamId stream_id,
@@ -117,8 +166,16 @@ private:
             dds::xrce::StreamId stream_id,
             utils::SharedLock& shared_lock);
 
+private:
+    struct PendingAck
+    {
+        uint16_t count;
+        std::chrono::steady_clock::time_point since;
+    };
+
 private:
     const SessionInfo session_info_;
+    const AckPolicy ack_policy_;
 
     NoneInputStream none_istream_;
     std::unordered_map<dds::xrce::StreamId, BestEffortInputStream> best_effort_istreams_;
@@ -126,6 +183,10 @@ private:
     std::mutex best_effort_imtx_;
     std::mutex reliable_imtx_;
 
+    std::unordered_map<dds::xrce::StreamId, PendingAck> pending_acks_;
+    std::chrono::steady_clock::time_point acknack_timer_;
+    std::mutex ack_mtx_;
+
     NoneOutputStream none_ostream_;
     std::unordered_map<dds::xrce::StreamId, BestEffortOutputStream> best_effort_ostreams_;
     std::unordered_map<dds::xrce::StreamId, ReliableOutputStream> reliable_ostreams_;
@@ -149,6 +210,11 @@ inline void Session::reset()
     }
     reliable_ilock.unlock();
 
+    std::unique_lock<std::mutex> ack_lock(ack_mtx_);
+    pending_acks_.clear();
+    acknack_timer_ = std::chrono::steady_clock::time_point{};
+    ack_lock.unlock();
+
     none_ostream_.reset();
 
     std::unique_lock<std::mutex> best_effort_olock(best_effort_omtx_);
@@ -253,6 +319,79 @@ inline bool Session::pop_input_fragment_message(dds::xrce::StreamId stream_id, I
     return reliable_istreams_[stream_id].pop_fragment_message(message);
 }
 
+/**************************************************************************************************
+ * Acknowledgement Methods.
+ **************************************************************************************************/
+inline void Session::schedule_acknack(
+        dds::xrce::StreamId stream_id)
+{
+    if (is_reliable_stream(stream_id))
+    {
+        std::lock_guard<std::mutex> lock(ack_mtx_);
+        PendingAck& pending = pending_acks_[stream_id];
+        if (0 == pending.count)
+        {
+            pending.since = std::chrono::steady_clock::now();
+        }
+        pending.count = uint16_t(pending.count + 1);
+    }
+}
+
+inline bool Session::pop_acknacks(
+        std::vector<dds::xrce::ACKNACK_Payload>& acknacks,
+        bool force)
+{
+    bool rv = false;
+    auto now = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> lock(ack_mtx_);
+    for (auto& it : pending_acks_)
+    {
+        PendingAck& pending = it.second;
+        if ((0 != pending.count) &&
+            (force ||
+             (ack_policy_.max_pending <= pending.count) ||
+             (ack_policy_.max_delay <= (now - pending.since))))
+        {
+            dds::xrce::ACKNACK_Payload acknack;
+            fill_acknack(it.first, acknack);
+            acknack.stream_id(it.first);
+            acknacks.push_back(std::move(acknack));
+            pending.count = 0;
+            rv = true;
+        }
+    }
+    return rv;
+}
+
+inline bool Session::pop_acknack_deadline(
+        std::chrono::steady_clock::time_point& deadline)
+{
+    bool rv = false;
+    auto now = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> lock(ack_mtx_);
+    for (const auto& it : pending_acks_)
+    {
+        const PendingAck& pending = it.second;
+        if (0 != pending.count)
+        {
+            const auto pending_deadline = pending.since + ack_policy_.max_delay;
+            deadline = rv ? std::min(deadline, pending_deadline) : pending_deadline;
+            rv = true;
+        }
+    }
+
+    /* A timer that already went off is being served, a later one has to be moved forward. */
+    if (rv && ((acknack_timer_ <= now) || (deadline < acknack_timer_)))
+    {
+        acknack_timer_ = deadline;
+    }
+    else
+    {
+        rv = false;
+    }
+    return rv;
+}
+
 /**************************************************************************************************
  * Output Stream Methods.
  **************************************************************************************************/
@@ -273,23 +412,46 @@ inline bool Session::push_output_submessage(
         dds::xrce::StreamId stream_id,
         dds::xrce::SubmessageId submessage_id,
         const T& submessage,
-        std::chrono::milliseconds timeout)
+        std::chrono::milliseconds timeout,
+        uint8_t format_flags)
 {
     bool rv = false;
     if (is_none_stream(stream_id))
     {
-        rv = none_ostream_.push_submessage(session_info_, submessage_id, submessage);
+        rv = none_ostream_.push_submessage(session_info_, submessage_id, submessage, format_flags);
     }
     else if (is_besteffort_stream(stream_id))
     {
         std::lock_guard<std::mutex> lock(best_effort_omtx_);
-        rv = best_effort_ostreams_[stream_id].push_submessage(session_info_, stream_id, submessage_id, submessage);
+        rv = best_effort_ostreams_[stream_id].push_submessage(session_info_, stream_id, submessage_id, submessage, format_flags);
     }
     else
     {
         utils::SharedLock shared_lock(reliable_omtx_);
         rv = get_reliable_output_stream(stream_id, shared_lock).push_submessage(
-            session_info_, stream_id, submessage_id, submessage, timeout);
+            session_info_, stream_id, submessage_id, submessage, timeout, format_flags);
+    }
+    return rv;
+}
+
+template<class T>
+inline PushResult Session::try_push_output_submessage(
+        dds::xrce::StreamId stream_id,
+        dds::xrce::SubmessageId submessage_id,
+        const T& submessage,
+        std::function<void()> on_window,
+        uint8_t format_flags)
+{
+    PushResult rv = PushResult::error;
+    if (is_reliable_stream(stream_id))
+    {
+        utils::SharedLock shared_lock(reliable_omtx_);
+        rv = get_reliable_output_stream(stream_id, shared_lock).try_push_submessage(
+            session_info_, stream_id, submessage_id, submessage, std::move(on_window), format_flags);
+    }
+    else if (push_output_submessage(stream_id, submessage_id, submessage, std::chrono::milliseconds(0), format_flags))
+    {
+        rv = PushResult::pushed;
     }
     return rv;
 }
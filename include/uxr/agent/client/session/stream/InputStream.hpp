@@ -20,7 +20,10 @@
 #include <uxr/agent/utils/SeqNum.hpp>
 #include <uxr/agent/client/session/SessionInfo.hpp>
 
+#include <algorithm>
+#include <cstring>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <queue>
 
@@ -200,7 +203,9 @@ public:
     ReliableInputStream()
         : last_handled_(UINT16_MAX),
           last_announced_(UINT16_MAX),
-          fragment_msg_{},
+          fragment_buf_{},
+          fragment_capacity_(0),
+          fragment_len_(0),
           fragment_message_available_(false)
     {}
 
@@ -234,11 +239,16 @@ public:
 
     void reset();
 
+private:
+    void reserve_fragment_buffer(size_t capacity);
+
 private:
     SeqNum last_handled_;
     SeqNum last_announced_;
     std::map<uint16_t, InputMessagePtr> messages_;
-    std::vector<uint8_t> fragment_msg_;
+    std::unique_ptr<uint8_t[]> fragment_buf_;
+    size_t fragment_capacity_;
+    size_t fragment_len_;
     bool fragment_message_available_;
     std::mutex mtx_;
 };
@@ -363,25 +373,69 @@ inline void ReliableInputStream::reset()
     last_handled_ = UINT16_MAX;
     last_announced_ = UINT16_MAX;
     messages_.clear();
+    fragment_buf_.reset();
+    fragment_capacity_ = 0;
+    fragment_len_ = 0;
+    fragment_message_available_ = false;
+}
+
+inline void ReliableInputStream::reserve_fragment_buffer(size_t capacity)
+{
+    if (capacity > fragment_capacity_)
+    {
+        std::unique_ptr<uint8_t[]> buf(new uint8_t[capacity]);
+        if (0 != fragment_len_)
+        {
+            memcpy(buf.get(), fragment_buf_.get(), fragment_len_);
+        }
+        fragment_buf_ = std::move(buf);
+        fragment_capacity_ = capacity;
+    }
 }
 
 inline void ReliableInputStream::push_fragment(InputMessagePtr& message)
 {
     std::lock_guard<std::mutex> lock(mtx_);
 
+    size_t fragment_size = message->get_subheader().submessage_length();
+
     /* Add header in case. */
-    if (fragment_msg_.empty())
+    if (0 == fragment_len_)
     {
         std::array<uint8_t, 8> raw_header;
         uint8_t header_size = message->get_raw_header(raw_header);
-        fragment_msg_.insert(fragment_msg_.begin(), std::begin(raw_header), std::begin(raw_header) + header_size);
-    }
+        reserve_fragment_buffer(header_size + fragment_size);
+        memcpy(fragment_buf_.get(), raw_header.data(), header_size);
+        fragment_len_ = header_size;
 
-    /* Append fragment. */
-    size_t position = fragment_msg_.size();
-    size_t fragment_size = message->get_subheader().submessage_length();
-    fragment_msg_.resize(position + fragment_size);
-    message->get_raw_payload(fragment_msg_.data() + position, fragment_size);
+        /* The first fragment starts with the subheader of the reassembled submessage,
+           so the whole buffer can be reserved up-front. */
+        if (message->get_raw_payload(fragment_buf_.get() + fragment_len_, fragment_size))
+        {
+            const size_t subheader_size = dds::xrce::SubmessageHeader{}.getCdrSerializedSize();
+            const uint8_t* subheader = fragment_buf_.get() + fragment_len_;
+            fragment_len_ += fragment_size;
+            if (subheader_size <= fragment_size)
+            {
+                uint16_t submessage_length = (0 != (subheader[1] & 0x01))
+                    ? uint16_t(subheader[2] | (subheader[3] << 8))
+                    : uint16_t((subheader[2] << 8) | subheader[3]);
+                reserve_fragment_buffer(header_size + subheader_size + submessage_length);
+            }
+        }
+    }
+    else
+    {
+        /* Grow geometrically whenever the size hint falls short. */
+        if (fragment_len_ + fragment_size > fragment_capacity_)
+        {
+            reserve_fragment_buffer((std::max)(fragment_len_ + fragment_size, 2 * fragment_capacity_));
+        }
+        if (message->get_raw_payload(fragment_buf_.get() + fragment_len_, fragment_size))
+        {
+            fragment_len_ += fragment_size;
+        }
+    }
 
     /* Check if last message. */
     fragment_message_available_ = (0 != (dds::xrce::FLAG_LAST_FRAGMENT & message->get_subheader().flags()));
@@ -393,10 +447,12 @@ inline bool ReliableInputStream::pop_fragment_message(InputMessagePtr& message)
     std::lock_guard<std::mutex> lock(mtx_);
     if (fragment_message_available_)
     {
-        message.reset(new InputMessage(fragment_msg_.data(), fragment_msg_.size()));
-        fragment_msg_.clear();
+        /* Hand the reassembled buffer over to the message. */
+        message.reset(new InputMessage(std::move(fragment_buf_), fragment_len_));
+        fragment_capacity_ = 0;
+        fragment_len_ = 0;
         fragment_message_available_ = false;
-        return true;
+        rv = true;
     }
     return rv;
 }
@@ -27,10 +27,20 @@
 #include <array>
 #include <map>
 #include <condition_variable>
+#include <functional>
+#include <vector>
 
 namespace eprosima {
 namespace uxr {
 
+/* Outcome of a non-blocking push. */
+enum class PushResult : uint8_t
+{
+    pushed,
+    window_full,
+    error
+};
+
 /****************************************************************************************
  * None Output Stream.
  ****************************************************************************************/
@@ -52,7 +62,8 @@ public:
     bool push_submessage(
             const SessionInfo& session_info,
             dds::xrce::SubmessageId id,
-            const T& submessage);
+            const T& submessage,
+            uint8_t format_flags = 0x00);
 
     bool pop_message(OutputMessagePtr& output_message);
 
@@ -74,7 +85,8 @@ template<class T>
 inline bool NoneOutputStream::push_submessage(
         const SessionInfo& session_info,
         dds::xrce::SubmessageId id,
-        const T& submessage)
+        const T& submessage,
+        uint8_t format_flags)
 {
     bool rv = false;
     std::lock_guard<std::mutex> lock(mtx_);
@@ -89,7 +101,7 @@ inline bool NoneOutputStream::push_submessage(
 
         /* Create message. */
         OutputMessagePtr output_message(new OutputMessage(message_header, session_info.mtu));
-        if (output_message->append_submessage(id, submessage))
+        if (output_message->append_submessage(id, submessage, dds::xrce::FLAG_LITTLE_ENDIANNESS | format_flags))
         {
             /* Push message. */
             messages_.push(std::move(output_message));
@@ -138,7 +150,8 @@ public:
             const SessionInfo& session_info,
             dds::xrce::StreamId stream_id,
             dds::xrce::SubmessageId submessage_id,
-            const T& submessage);
+            const T& submessage,
+            uint8_t format_flags = 0x00);
 
     bool pop_message(OutputMessagePtr& output_message);
 
@@ -163,7 +176,8 @@ inline bool BestEffortOutputStream::push_submessage(
         const SessionInfo& session_info,
         dds::xrce::StreamId stream_id,
         dds::xrce::SubmessageId submessage_id,
-        const T& submessage)
+        const T& submessage,
+        uint8_t format_flags)
 {
     bool rv = false;
     std::lock_guard<std::mutex> lock(mtx_);
@@ -187,7 +201,7 @@ inline bool BestEffortOutputStream::push_submessage(
                 session_info.mtu);
             rv = true;
         }
-        else if (output_message->append_submessage(submessage_id, submessage))
+        else if (output_message->append_submessage(submessage_id, submessage, dds::xrce::FLAG_LITTLE_ENDIANNESS | format_flags))
         {
             /* Push message. */
             messages_.push(std::move(output_message));
@@ -233,7 +247,21 @@ public:
             dds::xrce::StreamId stream_id,
             dds::xrce::SubmessageId submessage_id,
             const T& submessage,
-            std::chrono::milliseconds timeout);
+            std::chrono::milliseconds timeout,
+            uint8_t format_flags = 0x00);
+
+    /**
+     * Non-blocking push. When the window is full, on_window (if any) is run once, as soon as an ACKNACK
+     * or a reset frees window space.
+     */
+    template<class T>
+    PushResult try_push_submessage(
+            const SessionInfo& session_info,
+            dds::xrce::StreamId stream_id,
+            dds::xrce::SubmessageId submessage_id,
+            const T& submessage,
+            std::function<void()> on_window,
+            uint8_t format_flags = 0x00);
 
     bool get_next_message(OutputMessagePtr& output_message);
 
@@ -245,6 +273,20 @@ public:
 
     bool fill_heartbeat(dds::xrce::HEARTBEAT_Payload& heartbeat);
 
+private:
+    bool has_window() const
+    {
+        return last_unacked_ < first_unacked_ + SeqNum(RELIABLE_STREAM_DEPTH - 1);
+    }
+
+    template<class T>
+    bool push_submessage_unlock(
+            const SessionInfo& session_info,
+            dds::xrce::StreamId stream_id,
+            dds::xrce::SubmessageId submessage_id,
+            const T& submessage,
+            uint8_t format_flags);
+
 private:
     std::map<uint16_t, OutputMessagePtr> messages_;
     SeqNum last_unacked_;
@@ -252,6 +294,7 @@ private:
     SeqNum first_unacked_;
     std::mutex mtx_;
     std::condition_variable cv_;
+    std::vector<std::function<void()>> window_waiters_;
 };
 
 //inline bool ReliableOutputStream::push_message(OutputMessagePtr& output_message)
@@ -269,11 +312,19 @@ private:
 //
 inline void ReliableOutputStream::reset()
 {
-    std::lock_guard<std::mutex> lock(mtx_);
-    last_unacked_ = UINT16_MAX;
-    last_sent_ = UINT16_MAX;
-    first_unacked_ = 0x0000;
-    messages_.clear();
+    std::vector<std::function<void()>> window_waiters;
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        last_unacked_ = UINT16_MAX;
+        last_sent_ = UINT16_MAX;
+        first_unacked_ = 0x0000;
+        messages_.clear();
+        window_waiters.swap(window_waiters_);
+    }
+    for (auto& on_window : window_waiters)
+    {
+        on_window();
+    }
 }
 
 template<class T>
@@ -282,97 +333,128 @@ inline bool ReliableOutputStream::push_submessage(
         dds::xrce::StreamId stream_id,
         dds::xrce::SubmessageId submessage_id,
         const T& submessage,
-        std::chrono::milliseconds timeout)
+        std::chrono::milliseconds timeout,
+        uint8_t format_flags)
 {
     bool rv = false;
     std::unique_lock<std::mutex> lock(mtx_);
     auto now = std::chrono::steady_clock::now();
 
-    if (cv_.wait_until(
-            lock,
-            now + timeout, [&](){ return last_unacked_ < first_unacked_ + SeqNum(RELIABLE_STREAM_DEPTH - 1); }))
+    if (cv_.wait_until(lock, now + timeout, [&](){ return has_window(); }))
     {
-        /* Message header. */
-        dds::xrce::MessageHeader message_header;
-        message_header.session_id(session_info.session_id);
-        message_header.stream_id(stream_id);
-        message_header.client_key(session_info.client_key);
+        rv = push_submessage_unlock(session_info, stream_id, submessage_id, submessage, format_flags);
+    }
+    return rv;
+}
 
-        /* Submessage header. */
-        dds::xrce::SubmessageHeader submessage_header;
-        submessage_header.submessage_id(submessage_id);
-        submessage_header.flags(dds::xrce::FLAG_LITTLE_ENDIANNESS);
-        submessage_header.submessage_length(uint16_t(submessage.getCdrSerializedSize()));
+template<class T>
+inline PushResult ReliableOutputStream::try_push_submessage(
+        const SessionInfo& session_info,
+        dds::xrce::StreamId stream_id,
+        dds::xrce::SubmessageId submessage_id,
+        const T& submessage,
+        std::function<void()> on_window,
+        uint8_t format_flags)
+{
+    PushResult rv = PushResult::window_full;
+    std::lock_guard<std::mutex> lock(mtx_);
+    if (has_window())
+    {
+        rv = push_submessage_unlock(session_info, stream_id, submessage_id, submessage, format_flags)
+            ? PushResult::pushed
+            : PushResult::error;
+    }
+    else if (on_window)
+    {
+        window_waiters_.push_back(std::move(on_window));
+    }
+    return rv;
+}
 
-        /* Compute message size. */
-        const size_t header_size = message_header.getCdrSerializedSize();
-        const size_t subheader_size = submessage_header.getCdrSerializedSize();
-        const size_t submessage_size = subheader_size + submessage.getCdrSerializedSize();
+template<class T>
+inline bool ReliableOutputStream::push_submessage_unlock(
+        const SessionInfo& session_info,
+        dds::xrce::StreamId stream_id,
+        dds::xrce::SubmessageId submessage_id,
+        const T& submessage,
+        uint8_t format_flags)
+{
+    bool rv = false;
 
-        /* Push submessage. */
-        if ((header_size + submessage_size) <= session_info.mtu)
+    /* Message header. */
+    dds::xrce::MessageHeader message_header;
+    message_header.session_id(session_info.session_id);
+    message_header.stream_id(stream_id);
+    message_header.client_key(session_info.client_key);
+
+    /* Submessage header. */
+    dds::xrce::SubmessageHeader submessage_header;
+    submessage_header.submessage_id(submessage_id);
+    submessage_header.flags(dds::xrce::FLAG_LITTLE_ENDIANNESS | format_flags);
+    submessage_header.submessage_length(uint16_t(submessage.getCdrSerializedSize()));
+
+    /* Compute message size. */
+    const size_t header_size = message_header.getCdrSerializedSize();
+    const size_t subheader_size = submessage_header.getCdrSerializedSize();
+    const size_t submessage_size = subheader_size + submessage.getCdrSerializedSize();
+
+    /* Push submessage. */
+    if ((header_size + submessage_size) <= session_info.mtu)
+    {
+        /* Create message. */
+        last_unacked_ += 1;
+        message_header.sequence_nr(last_unacked_);
+        OutputMessagePtr output_message(new OutputMessage(message_header, header_size + submessage_size));
+        if (output_message->append_submessage(submessage_id, submessage, submessage_header.flags()))
         {
-            /* Create message. */
-            last_unacked_ += 1;
-            message_header.sequence_nr(last_unacked_);
-            OutputMessagePtr output_message(new OutputMessage(message_header, header_size + submessage_size));
-            if (output_message->append_submessage(submessage_id, submessage))
-            {
-                /* Push message. */
-                messages_.insert(std::make_pair(last_unacked_, std::move(output_message)));
-                rv = true;
-            }
+            /* Push message. */
+            messages_.insert(std::make_pair(last_unacked_, std::move(output_message)));
+            rv = true;
         }
-        else
+    }
+    else
+    {
+        /* Serialize submessage once, fragments reference slices of this shared payload. */
+        std::shared_ptr<uint8_t> buf(new uint8_t[submessage_size], std::default_delete<uint8_t[]>());
+        fastcdr::FastBuffer fastbuffer(reinterpret_cast<char*>(buf.get()), submessage_size);
+        fastcdr::Cdr serializer(fastbuffer, eprosima::fastcdr::Cdr::DEFAULT_ENDIAN, eprosima::fastcdr::CdrVersion::XCDRv1);
+        submessage_header.serialize(serializer);
+        submessage.serialize(serializer);
+        std::shared_ptr<const uint8_t> payload(std::move(buf));
+
+        const size_t max_fragment_size = session_info.mtu - header_size - subheader_size;
+        dds::xrce::SubmessageHeader fragment_subheader;
+        fragment_subheader.submessage_id(dds::xrce::FRAGMENT);
+        fragment_subheader.flags(dds::xrce::FLAG_LITTLE_ENDIANNESS);
+        fragment_subheader.submessage_length(uint16_t(max_fragment_size));
+
+        size_t serialized_size = 0;
+        do
         {
-            /* Serialize submessage. */
-            std::unique_ptr<uint8_t[]> buf(new uint8_t[submessage_size]);
-            fastcdr::FastBuffer fastbuffer(reinterpret_cast<char*>(buf.get()), submessage_size);
-            fastcdr::Cdr serializer(fastbuffer, eprosima::fastcdr::Cdr::DEFAULT_ENDIAN, eprosima::fastcdr::CdrVersion::XCDRv1);
-            submessage_header.serialize(serializer);
-            submessage.serialize(serializer);
-
-            const size_t max_fragment_size = session_info.mtu - header_size - subheader_size;
-            dds::xrce::SubmessageHeader fragment_subheader;
-            fragment_subheader.submessage_id(dds::xrce::FRAGMENT);
-            fragment_subheader.flags(dds::xrce::FLAG_LITTLE_ENDIANNESS);
-            fragment_subheader.submessage_length(uint16_t(max_fragment_size));
-
-            uint16_t serialized_size = 0;
-            do
+            uint16_t fragment_size;
+            if (session_info.mtu < (header_size + subheader_size + (submessage_size - serialized_size)))
             {
-                uint16_t fragment_size;
-                if (session_info.mtu < (header_size + subheader_size + (submessage_size - serialized_size)))
-                {
-                    fragment_size = uint16_t(max_fragment_size);
-                }
-                else
-                {
-                    fragment_size = uint16_t(submessage_size - serialized_size);
-                    fragment_subheader.flags(submessage_header.flags() | dds::xrce::FLAG_LAST_FRAGMENT);
-                }
-                fragment_subheader.submessage_length(fragment_size);
-
-                const size_t current_message_size = header_size + subheader_size + fragment_size;
-
-                /* Create message. */
-                last_unacked_ += 1;
-                message_header.sequence_nr(last_unacked_);
-                OutputMessagePtr output_message(new OutputMessage(message_header, current_message_size));
-                if (output_message->append_fragment(fragment_subheader,  buf.get() + serialized_size, fragment_size))
-                {
-                    /* Push message. */
-                    messages_.insert(std::make_pair(last_unacked_, std::move(output_message)));
-                    serialized_size += fragment_size;
-                }
-                else
-                {
-                    break;
-                }
-
-            } while (serialized_size < submessage_size);
-            rv = (serialized_size == submessage_size);
-        }
+                fragment_size = uint16_t(max_fragment_size);
+            }
+            else
+            {
+                fragment_size = uint16_t(submessage_size - serialized_size);
+                fragment_subheader.flags(dds::xrce::FLAG_LITTLE_ENDIANNESS | dds::xrce::FLAG_LAST_FRAGMENT);
+            }
+            fragment_subheader.submessage_length(fragment_size);
+
+            /* Create message. */
+            last_unacked_ += 1;
+            message_header.sequence_nr(last_unacked_);
+            OutputMessagePtr output_message(
+                new OutputMessage(message_header, fragment_subheader, payload, serialized_size, fragment_size));
+
+            /* Push message. */
+            messages_.insert(std::make_pair(last_unacked_, std::move(output_message)));
+            serialized_size += fragment_size;
+
+        } while (serialized_size < submessage_size);
+        rv = (serialized_size == submessage_size);
     }
     return rv;
 }
@@ -407,15 +489,28 @@ inline bool ReliableOutputStream::get_message(
 
 inline void ReliableOutputStream::update_from_acknack(SeqNum first_unacked)
 {
-    std::lock_guard<std::mutex> lock(mtx_);
-    if (first_unacked <= last_sent_ + 1)
+    std::vector<std::function<void()>> window_waiters;
     {
-        while (first_unacked > first_unacked_)
+        std::lock_guard<std::mutex> lock(mtx_);
+        if (first_unacked <= last_sent_ + 1)
         {
-            messages_.erase(first_unacked_);
-            first_unacked_ += 1;
+            while (first_unacked > first_unacked_)
+            {
+                messages_.erase(first_unacked_);
+                first_unacked_ += 1;
+            }
+            cv_.notify_one();
+            if (has_window())
+            {
+                window_waiters.swap(window_waiters_);
+            }
         }
-        cv_.notify_one();
+    }
+
+    /* Out of the lock, the waiters may push again right away. */
+    for (auto& on_window : window_waiters)
+    {
+        on_window();
     }
 }
 
@@ -17,6 +17,7 @@
 
 #include <uxr/agent/object/XRCEObject.hpp>
 #include <uxr/agent/reader/Reader.hpp>
+#include <uxr/agent/types/SampleFilter.hpp>
 #if defined(UAGENT_RESTRICT) || defined(UAGENT_PROTECT)
 #include <map>
 #endif
@@ -65,6 +66,21 @@ private:
         std::vector<uint8_t>& data,
         std::chrono::milliseconds timeout);
 
+    /* Encodes the batch as the whole DATA payload of the read data format. */
+    void batch_fn(
+        std::vector<std::vector<uint8_t>>& samples,
+        const std::vector<std::chrono::system_clock::time_point>& sample_times,
+        std::vector<uint8_t>& data);
+
+    size_t batch_size_fn(
+        size_t batch_size,
+        size_t sample_size) const;
+
+    template<class T>
+    void serialize_batch(
+        T& payload,
+        std::vector<uint8_t>& data) const;
+
 #if defined(UAGENT_RESTRICT) || defined(UAGENT_PROTECT)
     std::chrono::system_clock::time_point get_read_time() const;
 #endif
@@ -72,6 +88,12 @@ private:
 private:
     std::shared_ptr<ProxyClient> proxy_client_;
     Reader<bool> reader_;
+    dds::xrce::DataFormat data_format_;
+    dds::xrce::RequestId request_id_;
+    uint32_t sequence_number_;
+    std::chrono::steady_clock::time_point read_time_;
+    std::chrono::system_clock::time_point source_timestamp_;
+    SampleFilter filter_;
 #if defined(UAGENT_RESTRICT) || defined(UAGENT_PROTECT)
 public:
 	struct TopicInfo
@@ -16,6 +16,7 @@
 #define UXR_AGENT_DATAWRITER_DATAWRITER_HPP_
 
 #include <uxr/agent/object/XRCEObject.hpp>
+#include <uxr/agent/middleware/Middleware.hpp>
 #include <string>
 #include <set>
 #if defined(UAGENT_RESTRICT) || defined(UAGENT_PROTECT)
@@ -28,7 +29,6 @@ namespace uxr {
 class Publisher;
 class ProxyClient;
 class Topic;
-class Middleware;
 
 class DataWriter : public XRCEObject
 {
@@ -58,8 +58,12 @@ private:
     std::chrono::system_clock::time_point get_read_time() const;
 #endif
 
+    bool write_middleware(const std::vector<uint8_t>& data);
+
 private:
     std::shared_ptr<ProxyClient> proxy_client_;
+    /* Resolved at creation, so that the samples skip the middleware lookup by id. */
+    Middleware::DataWriterHandle* handle_;
 #if defined(UAGENT_RESTRICT) || defined(UAGENT_PROTECT)
 public:
 	struct TopicInfo
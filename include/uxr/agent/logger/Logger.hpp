@@ -137,6 +137,12 @@
 #define UXR_AGENT_LOG_HEX(...) void(0)
 #endif
 
+#ifdef UAGENT_LOGGER_PROFILE
+#define UXR_AGENT_LOG_MESSAGE_ENABLED() spdlog::default_logger()->should_log(spdlog::level::debug)
+#else
+#define UXR_AGENT_LOG_MESSAGE_ENABLED() false
+#endif
+
 #ifdef UAGENT_LOGGER_PROFILE
 #define UXR_AGENT_LOG_MESSAGE(STATUS, CLIENT_KEY, BUF, LEN) \
     if (spdlog::default_logger()->should_log(spdlog::level::trace)) \
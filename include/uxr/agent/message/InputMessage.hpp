@@ -21,6 +21,8 @@
 #include <fastcdr/Cdr.h>
 #include <fastcdr/exceptions/Exception.h>
 
+#include <memory>
+
 namespace eprosima {
 namespace uxr {
 
@@ -44,6 +46,22 @@ public:
         valid_xrce_message_ = valid_xrce_message_ && count_submessages() > 0;
     }
 
+    /* Takes ownership of an already filled buffer (e.g. a reassembled message) without copying it. */
+    InputMessage(
+            std::unique_ptr<uint8_t[]>&& buf,
+            size_t len)
+        : buf_(buf.release()),
+          len_(len),
+          header_(),
+          subheader_(),
+          fastbuffer_(reinterpret_cast<char*>(buf_), len_),
+          deserializer_(fastbuffer_, eprosima::fastcdr::Cdr::DEFAULT_ENDIAN, eprosima::fastcdr::CdrVersion::XCDRv1)
+    {
+        // A valid XRCE message must have a valid header and at least 1 submessage
+        valid_xrce_message_ = deserialize(header_);
+        valid_xrce_message_ = valid_xrce_message_ && count_submessages() > 0;
+    }
+
     uint8_t* get_buf() const { return buf_; }
 
     size_t get_len() const { return len_; }
@@ -22,6 +22,12 @@
 #include <fastcdr/Cdr.h>
 #include <fastcdr/exceptions/Exception.h>
 
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <vector>
+
 namespace eprosima {
 namespace uxr {
 
@@ -39,6 +45,52 @@ public:
         serialize(header);
     }
 
+    /* Puts submessages in front of those of a complete message without copying it: the message header
+       and the new submessages are owned, the submessages of the message are shared. */
+    template<class T>
+    OutputMessage(
+            const std::shared_ptr<const OutputMessage>& message,
+            size_t header_len,
+            dds::xrce::SubmessageId submessage_id,
+            const std::vector<T>& submessages)
+        : buf_(new uint8_t[get_prepended_head_len(header_len, submessages)]{0}),
+          len_(get_prepended_head_len(header_len, submessages)),
+          fastbuffer_(reinterpret_cast<char*>(buf_), len_),
+          serializer_(fastbuffer_, eprosima::fastcdr::Cdr::DEFAULT_ENDIAN, eprosima::fastcdr::CdrVersion::XCDRv1)
+    {
+        memcpy(buf_, message->buf_, header_len);
+        serializer_.jump(header_len);
+        for (const auto& submessage : submessages)
+        {
+            append_submessage(submessage_id, submessage);
+        }
+        serializer_.jump((4 - ((serializer_.get_current_position() - serializer_.get_buffer_pointer()) & 3)) & 3);
+
+        payload_ = std::shared_ptr<const uint8_t>(message, message->buf_);
+        payload_offset_ = header_len;
+        payload_len_ = message->get_head_len() - header_len;
+    }
+
+    /* Fragment message: only the message header and the fragment subheader are owned,
+       the fragment data is a slice of a payload shared by all the fragments. */
+    OutputMessage(
+            const dds::xrce::MessageHeader& header,
+            const dds::xrce::SubmessageHeader& subheader,
+            const std::shared_ptr<const uint8_t>& payload,
+            size_t offset,
+            size_t len)
+        : buf_(new uint8_t[header.getCdrSerializedSize() + subheader.getCdrSerializedSize()]{0}),
+          len_(header.getCdrSerializedSize() + subheader.getCdrSerializedSize()),
+          fastbuffer_(reinterpret_cast<char*>(buf_), len_),
+          serializer_(fastbuffer_, eprosima::fastcdr::Cdr::DEFAULT_ENDIAN, eprosima::fastcdr::CdrVersion::XCDRv1),
+          payload_(payload),
+          payload_offset_(offset),
+          payload_len_(len)
+    {
+        serialize(header);
+        serialize(subheader);
+    }
+
     ~OutputMessage()
     {
         delete[] buf_;
@@ -49,9 +101,19 @@ public:
     OutputMessage& operator=(OutputMessage&&) = delete;
     OutputMessage& operator=(const OutputMessage&) = delete;
 
-    uint8_t* get_buf() const { return buf_; }
+    /* Contiguous view of the message, fragment messages are flattened on first use. */
+    uint8_t* get_buf() const;
+
+    size_t get_len() const { return get_head_len() + payload_len_; }
+
+    /* Scatter-gather view of the message, suitable for vectored I/O. */
+    const uint8_t* get_head() const { return buf_; }
+
+    size_t get_head_len() const { return serializer_.get_serialized_data_length(); }
 
-    size_t get_len() const { return serializer_.get_serialized_data_length(); }
+    const uint8_t* get_payload() const { return payload_ ? payload_.get() + payload_offset_ : nullptr; }
+
+    size_t get_payload_len() const { return payload_len_; }
 
     template<class T>
     bool append_submessage(
@@ -70,7 +132,33 @@ public:
             uint8_t* buf,
             size_t len);
 
+    /* Whether submessages may go in front of those of the message: the client tells fragment
+       messages by their first submessage, so these are left alone. */
+    static bool is_prependable(
+            const OutputMessage& message,
+            size_t header_len)
+    {
+        return (0 == message.payload_len_)
+               && (header_len < message.get_head_len())
+               && (dds::xrce::FRAGMENT != message.buf_[header_len]);
+    }
+
+    /* Length of a message after putting the submessages in front of those of the given one. */
+    template<class T>
+    static size_t get_prepended_len(
+            const OutputMessage& message,
+            size_t header_len,
+            const std::vector<T>& submessages)
+    {
+        return get_prepended_head_len(header_len, submessages) + message.get_head_len() - header_len;
+    }
+
 private:
+    template<class T>
+    static size_t get_prepended_head_len(
+            size_t header_len,
+            const std::vector<T>& submessages);
+
     bool append_subheader(
             dds::xrce::SubmessageId submessage_id,
             uint8_t flags,
@@ -86,8 +174,44 @@ private:
     size_t len_;
     fastcdr::FastBuffer fastbuffer_;
     fastcdr::Cdr serializer_;
+    std::shared_ptr<const uint8_t> payload_;
+    size_t payload_offset_ = 0;
+    size_t payload_len_ = 0;
+    mutable std::unique_ptr<uint8_t[]> flat_buf_;
+    mutable std::once_flag flat_flag_;
 };
 
+inline uint8_t* OutputMessage::get_buf() const
+{
+    if (0 == payload_len_)
+    {
+        return buf_;
+    }
+
+    std::call_once(flat_flag_, [this]()
+    {
+        const size_t head_len = get_head_len();
+        flat_buf_.reset(new uint8_t[head_len + payload_len_]);
+        memcpy(flat_buf_.get(), buf_, head_len);
+        memcpy(flat_buf_.get() + head_len, get_payload(), payload_len_);
+    });
+    return flat_buf_.get();
+}
+
+template<class T>
+inline size_t OutputMessage::get_prepended_head_len(
+        size_t header_len,
+        const std::vector<T>& submessages)
+{
+    size_t len = header_len;
+    for (const auto& submessage : submessages)
+    {
+        len = ((len + 3) & ~size_t(3)) + dds::xrce::SubmessageHeader{}.getCdrSerializedSize()
+              + submessage.getCdrSerializedSize();
+    }
+    return (len + 3) & ~size_t(3);
+}
+
 template<class T>
 inline bool OutputMessage::append_submessage(
         dds::xrce::SubmessageId submessage_id,
@@ -34,6 +34,16 @@ namespace uxr {
 class Middleware
 {
 public:
+    /* DataWriter of the middleware, resolved once so that its samples skip the lookup by id. */
+    class DataWriterHandle
+    {
+    public:
+        virtual ~DataWriterHandle() = default;
+
+        virtual bool write(
+                const std::vector<uint8_t>& data) = 0;
+    };
+
     enum class Kind : uint8_t
     {
         NONE,
@@ -195,6 +205,16 @@ public:
             uint16_t datawriter_id,
             const std::vector<uint8_t>& data) = 0;
 
+    /**
+     * Resolves a DataWriter, the handle being valid until it is deleted. Returns nullptr if the
+     * middleware has none, in which case the samples go through write_data.
+     */
+    virtual DataWriterHandle* get_datawriter_handle(
+            uint16_t /*datawriter_id*/)
+    {
+        return nullptr;
+    }
+
     virtual bool write_request(
             uint16_t requester_id,
             uint32_t sequence_number,
@@ -209,6 +229,21 @@ public:
             std::vector<uint8_t>& data,
             std::chrono::milliseconds timeout) = 0;
 
+    /* Same as read_data, along with the source timestamp of the sample, or its reception time if unknown. */
+    virtual bool read_timestamped_data(
+            uint16_t datareader_id,
+            std::vector<uint8_t>& data,
+            std::chrono::system_clock::time_point& source_timestamp,
+            std::chrono::milliseconds timeout)
+    {
+        bool rv = read_data(datareader_id, data, timeout);
+        if (rv)
+        {
+            source_timestamp = std::chrono::system_clock::now();
+        }
+        return rv;
+    }
+
     virtual bool read_request(
             uint16_t replier_id,
             std::vector<uint8_t>& data,
@@ -220,6 +255,36 @@ public:
             std::vector<uint8_t>& data,
             std::chrono::milliseconds timeout) = 0;
 
+/**********************************************************************************************************************
+ * Notification functions.
+ **********************************************************************************************************************/
+    /**
+     * Installs (or clears, if empty) a callback invoked whenever the DataReader has new data.
+     * Returns false if the middleware cannot notify, in which case the DataReader has to be polled.
+     */
+    virtual bool set_data_available_callback(
+            uint16_t /*datareader_id*/,
+            std::function<void ()> /*callback*/)
+    {
+        return false;
+    }
+
+    /* Same as set_data_available_callback, for the replies read by a Requester. */
+    virtual bool set_reply_available_callback(
+            uint16_t /*requester_id*/,
+            std::function<void ()> /*callback*/)
+    {
+        return false;
+    }
+
+    /* Same as set_data_available_callback, for the requests read by a Replier. */
+    virtual bool set_request_available_callback(
+            uint16_t /*replier_id*/,
+            std::function<void ()> /*callback*/)
+    {
+        return false;
+    }
+
 /**********************************************************************************************************************
  * Matched functions.
  **********************************************************************************************************************/
@@ -15,10 +15,12 @@
 #ifndef UXR_AGENT_MIDDLEWARE_CED_CED_ENTITIES_HPP_
 #define UXR_AGENT_MIDDLEWARE_CED_CED_ENTITIES_HPP_
 
-#include <uxr/agent/utils/SeqNum.hpp>
+#include <uxr/agent/middleware/Middleware.hpp>
 
 #include <string>
 #include <array>
+#include <atomic>
+#include <chrono>
 #include <vector>
 #include <mutex>
 #include <condition_variable>
@@ -26,6 +28,7 @@
 #include <unordered_map>
 #include <memory>
 #include <set>
+#include <type_traits>
 
 namespace eprosima {
 namespace uxr {
@@ -62,6 +65,7 @@ enum class ReadAccess : uint8_t
  * CedTopicManager
  **********************************************************************************************************************/
 class CedGlobalTopic;
+class CedSharedRing;
 typedef const std::function<void (int16_t)> OnNewDomain;
 typedef const std::function<void (int16_t, const std::string&)> OnNewTopic;
 
@@ -88,7 +92,33 @@ public:
             int16_t domain_id,
             std::shared_ptr<CedGlobalTopic>& topic);
 
+    /**
+     * Samples kept by the topics created from now on with this name, or by default for an empty topic_name.
+     */
+    static void set_history_depth(
+            const std::string& topic_name,
+            uint16_t depth);
+
+    static constexpr uint16_t default_history_depth = 16;
+
+    /**
+     * Makes the topics created from now on live in shared memory, for samples up to max_sample_size bytes,
+     * so that they connect the clients of every agent process of the host. Zero restores process local topics.
+     * Only supported on Linux.
+     */
+    static bool set_shared_memory(
+            uint32_t max_sample_size);
+
 private:
+    typedef std::unordered_map<int16_t, std::unordered_map<std::string, std::weak_ptr<CedGlobalTopic>>> TopicMap;
+
+    /* Topics of a shard, read without locking and replaced by a modified copy under the shard mutex. */
+    struct Shard
+    {
+        std::mutex mtx;
+        std::shared_ptr<const TopicMap> topics = std::make_shared<const TopicMap>();
+    };
+
     CedTopicManager() = default;
     ~CedTopicManager() = default;
 
@@ -96,10 +126,58 @@ private:
             const std::string& topic_name,
             int16_t domain_id);
 
+    static Shard& get_shard(
+            const std::string& topic_name,
+            int16_t domain_id);
+
+    static std::shared_ptr<CedGlobalTopic> find_topic(
+            const TopicMap& topics,
+            const std::string& topic_name,
+            int16_t domain_id);
+
+    static void get_topic_config(
+            const std::string& topic_name,
+            uint16_t& history_depth,
+            uint32_t& shared_sample_size);
+
+    static void notify_new_topic(
+            const std::string& topic_name,
+            int16_t domain_id);
+
+    /* Callbacks run outside mtx_, unregistering one waits until none of its runs is in flight. */
+    template<typename Fn>
+    struct Callback
+    {
+        explicit Callback(Fn& callback_fn)
+            : fn(callback_fn)
+            , running(0)
+        {}
+
+        typename std::decay<Fn>::type fn;
+        size_t running;
+    };
+
+    template<typename Fn>
+    static void unregister_callback(
+            std::unordered_map<uint32_t, std::shared_ptr<Callback<Fn>>>& callbacks,
+            uint32_t key);
+
+    static void release_callback(
+            size_t& running);
+
 private:
-    static std::unordered_map<uint32_t, OnNewDomain> on_new_domain_map_;
-    static std::unordered_map<uint32_t, OnNewTopic> on_new_topic_map_;
-    static std::unordered_map<int16_t, std::unordered_map<std::string, std::weak_ptr<CedGlobalTopic>>> topics_;
+    static constexpr size_t shard_count = 32;
+    static std::array<Shard, shard_count> shards_;
+
+    /* Topics per domain, a domain is new when it gets its first one. */
+    static std::unordered_map<int16_t, size_t> domains_;
+    static std::mutex domains_mtx_;
+
+    static std::unordered_map<uint32_t, std::shared_ptr<Callback<OnNewDomain>>> on_new_domain_map_;
+    static std::unordered_map<uint32_t, std::shared_ptr<Callback<OnNewTopic>>> on_new_topic_map_;
+    static std::condition_variable callbacks_cv_;
+    static std::unordered_map<std::string, uint16_t> history_depths_;
+    static uint32_t shared_sample_size_;
     static std::mutex mtx_;
 };
 
@@ -113,13 +191,34 @@ class CedGlobalTopic
 public:
     CedGlobalTopic(
             const std::string& topic_name,
-            int16_t domain_id);
+            int16_t domain_id,
+            uint16_t history_depth = CedTopicManager::default_history_depth,
+            uint32_t shared_sample_size = 0);
 
     ~CedGlobalTopic();
 
     const std::string& name() const;
 
+    size_t history_depth() const;
+
+    bool is_shared() const { return bool(shared_ring_); }
+
 private:
+    /*
+     * Holds sample seq when (seq << 1) is stored, ((seq << 1) | 1) while it is being written.
+     * Buffers only grow and the outgrown ones are kept until the topic goes away, so that a reader
+     * racing with a writer copies stale bytes at worst, which the sequence check then discards.
+     */
+    struct Slot
+    {
+        std::atomic<uint64_t> seq{0};
+        std::atomic<uint8_t*> data{nullptr};
+        std::atomic<size_t> size{0};
+        std::atomic<uint8_t> src{0};
+        size_t capacity = 0;
+        std::vector<std::unique_ptr<uint8_t[]>> buffers;
+    };
+
     bool write(
             const std::vector<uint8_t>& data,
             WriteAccess write_access,
@@ -129,7 +228,7 @@ private:
     bool read(
             std::vector<uint8_t>& data,
             std::chrono::milliseconds timeout,
-            SeqNum& last_read,
+            uint64_t& next_read,
             ReadAccess read_access,
             uint8_t& errcode);
 
@@ -139,21 +238,47 @@ private:
 
     bool check_read_access(
             ReadAccess read_access,
-            size_t index);
+            TopicSource topic_src);
 
     bool get_data(
             std::vector<uint8_t>& data,
-            SeqNum& last_read,
+            uint64_t& next_read,
             ReadAccess read_access);
 
+    /* Run by the writers once the sample is stored, so they are expected to just post work. */
+    uint32_t add_data_available_callback(
+            std::function<void ()> callback);
+
+    /* Once it returns the callback is not running and will not run anymore. */
+    void remove_data_available_callback(
+            uint32_t id);
+
 private:
     const std::string name_;
     int16_t domain_id_;
-    SeqNum last_write_;
-    std::mutex mtx_;
+
+    /*
+     * Ring of the last samples, written by the writers one at a time and read without locking:
+     * each reader keeps its own cursor and each slot is guarded by a sequence lock.
+     */
+    const size_t depth_;
+    std::unique_ptr<Slot[]> history_;
+    std::atomic<uint64_t> write_count_;
+    std::mutex write_mtx_;
+
+    /* Only readers without data wait, writers only signal when there are any. */
+    std::atomic<uint32_t> waiters_;
+    std::mutex wait_mtx_;
     std::condition_variable cv_;
-    std::array<std::vector<uint8_t>, 16> history_; // TODO (review history size)
-    std::array<TopicSource, 16> srcs_; // TODO (review history size)
+
+    /* Only taken by writers when there are callbacks. */
+    std::atomic<size_t> callbacks_count_;
+    std::mutex callbacks_mtx_;
+    std::unordered_map<uint32_t, std::function<void ()>> callbacks_;
+    uint32_t last_callback_;
+
+    /* Replaces the ring above when the topic is in shared memory. */
+    std::shared_ptr<CedSharedRing> shared_ring_;
 };
 
 /**********************************************************************************************************************
@@ -247,7 +372,7 @@ private:
 /**********************************************************************************************************************
  * CedDataWriter
  **********************************************************************************************************************/
-class CedDataWriter
+class CedDataWriter : public Middleware::DataWriterHandle
 {
 public:
     CedDataWriter(
@@ -262,6 +387,9 @@ public:
     {}
     ~CedDataWriter() = default;
 
+    bool write(
+        const std::vector<uint8_t>& data) override;
+
     bool write(
         const std::vector<uint8_t>& data,
         uint8_t& errcode) const;
@@ -287,23 +415,29 @@ public:
             const ReadAccess read_access)
         : subscriber_(subscriber)
         , topic_(topic)
-        , last_read_(UINT16_MAX)
+        , next_read_(0)
         , read_access_(read_access)
+        , callback_id_(0)
     {}
-    ~CedDataReader() = default;
+    ~CedDataReader();
 
     bool read(
             std::vector<uint8_t>& data,
             std::chrono::milliseconds timeout,
             uint8_t& errcode);
 
+    /* False if the topic is in shared memory, where other processes write without notifying. */
+    bool set_data_available_callback(
+            std::function<void ()> callback);
+
     const std::string& topic_name() const { return topic_->get_global_topic()->name(); }
 
 private:
     const std::shared_ptr<CedSubscriber> subscriber_;
     const std::shared_ptr<CedTopic> topic_;
-    SeqNum last_read_;
+    uint64_t next_read_;
     const ReadAccess read_access_;
+    uint32_t callback_id_;
 };
 
 } // namespace uxr
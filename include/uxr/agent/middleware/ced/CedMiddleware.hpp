@@ -404,6 +404,14 @@ public:
             uint16_t datawriter_id,
             const std::vector<uint8_t>& data) override;
 
+    /**
+     * @brief Returns the CedDataWriter identified by the datawriter_id parameter.
+     * @param datawriter_id The CedDataWriter identifier.
+     * @return  the CedDataWriter, or nullptr if it does not exist.
+     */
+    DataWriterHandle* get_datawriter_handle(
+            uint16_t datawriter_id) override;
+
     /**
      * @brief Not implemented.
      */
@@ -449,6 +457,17 @@ public:
             std::vector<uint8_t>&,
             std::chrono::milliseconds) override { return false; };
 
+    /**
+     * @brief Installs (or clears, if empty) a callback invoked whenever the CedDataReader has new data.
+     * @param datareader_id The CedDataReader's identifier.
+     * @param callback      The callback, run by the writer thread, so it is expected to just post work.
+     * @return  true in case of success, and false if the CedDataReader does not exist or its topic is in shared
+     *          memory, where other processes write without notifying.
+     */
+    bool set_data_available_callback(
+            uint16_t datareader_id,
+            std::function<void ()> callback) override;
+
     /**
      * @brief Checks whether an existing CedParticipant, identified by the participant_id, matches with a new
      *        CedParticipant that would result from the creation of a new one using the domain_id and the reference
@@ -0,0 +1,102 @@
+// Copyright 2019 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef UXR_AGENT_MIDDLEWARE_CED_CED_SHARED_RING_HPP_
+#define UXR_AGENT_MIDDLEWARE_CED_CED_SHARED_RING_HPP_
+
+#include <uxr/agent/middleware/ced/CedEntities.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace eprosima {
+namespace uxr {
+
+/**********************************************************************************************************************
+ * CedSharedRing
+ **********************************************************************************************************************/
+/**
+ * History of a CED topic in a named POSIX shared memory segment, shared by every agent process of the host
+ * that opens the same topic and domain. Samples are copied in and out of fixed size slots, each one guarded
+ * by a sequence lock, writers serialize on a robust process-shared mutex and readers wait on a futex.
+ * The segment is removed when its last user closes it.
+ */
+class CedSharedRing
+{
+public:
+    /**
+     * Opens the ring of the topic, creating it with the given depth and slot size if it does not exist yet.
+     * An existing ring keeps the parameters of its creator. Returns nullptr on failure.
+     */
+    static std::unique_ptr<CedSharedRing> open(
+            const std::string& topic_name,
+            int16_t domain_id,
+            uint16_t depth,
+            uint32_t slot_size);
+
+    ~CedSharedRing();
+
+    CedSharedRing(CedSharedRing&&) = delete;
+    CedSharedRing(const CedSharedRing&) = delete;
+    CedSharedRing& operator=(CedSharedRing&&) = delete;
+    CedSharedRing& operator=(const CedSharedRing&) = delete;
+
+    /* Fails if the sample does not fit in a slot. */
+    bool write(
+            const std::vector<uint8_t>& data,
+            TopicSource topic_src);
+
+    /* Copies out the sample at next_read, or the oldest one still kept, and advances the cursor. */
+    bool read(
+            std::vector<uint8_t>& data,
+            TopicSource& topic_src,
+            uint64_t& next_read);
+
+    /* Waits until the sample at next_read is written, false on timeout. */
+    bool wait(
+            uint64_t next_read,
+            std::chrono::steady_clock::time_point deadline);
+
+    const std::string& name() const { return name_; }
+    uint16_t depth() const;
+    uint32_t slot_size() const;
+
+private:
+    struct Header;
+    struct Slot;
+
+    CedSharedRing(
+            const std::string& name,
+            int fd,
+            void* address,
+            size_t size);
+
+    Slot& get_slot(
+            uint64_t seq);
+
+private:
+    const std::string name_;
+    int fd_;
+    void* address_;
+    size_t size_;
+    Header* header_;
+};
+
+} // namespace uxr
+} // namespace eprosima
+
+#endif // UXR_AGENT_MIDDLEWARE_CED_CED_SHARED_RING_HPP_
@@ -25,6 +25,8 @@
 #include <unordered_map>
 #include <condition_variable>
 #include <atomic>
+#include <functional>
+#include <mutex>
 
 namespace eprosima {
 namespace fastrtps {
@@ -64,6 +66,19 @@ public:
     void onSubscriptionMatched(
         fastrtps::Subscriber*,
         fastrtps::rtps::MatchingInfo& info) final;
+
+    void onNewDataMessage(
+        fastrtps::Subscriber* subscriber) final;
+
+    /* Installs (or clears, if empty) the callback of the subscriber, run on the DDS listener thread to just post work.
+       Once it returns the previous callback is not running and will not run anymore. */
+    void set_data_available_callback(
+        const fastrtps::Subscriber* subscriber,
+        std::function<void ()> callback);
+
+private:
+    std::mutex callbacks_mtx_;
+    std::unordered_map<const fastrtps::Subscriber*, std::function<void ()>> callbacks_;
 };
 
 /**********************************************************************************************************************
@@ -188,7 +203,7 @@ private:
 /**********************************************************************************************************************
  * FastDataWriter
  **********************************************************************************************************************/
-class FastDataWriter
+class FastDataWriter : public Middleware::DataWriterHandle
 {
 public:
     FastDataWriter(
@@ -202,7 +217,7 @@ public:
             const fastrtps::PublisherAttributes& attrs) const;
 
     bool write(
-            const std::vector<uint8_t>& data);
+            const std::vector<uint8_t>& data) override;
 
     bool write(
             const std::vector<uint8_t>& data,
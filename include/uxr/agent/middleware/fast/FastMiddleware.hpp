@@ -177,6 +177,9 @@ public:
             uint16_t datawriter_id,
             const std::vector<uint8_t>& data) override;
 
+    DataWriterHandle* get_datawriter_handle(
+            uint16_t datawriter_id) override;
+
     bool write_request(
             uint16_t requester_id,
             uint32_t sequence_number,
@@ -191,6 +194,12 @@ public:
             std::vector<uint8_t>& data,
             std::chrono::milliseconds timeout) override;
 
+    bool read_timestamped_data(
+            uint16_t datareader_id,
+            std::vector<uint8_t>& data,
+            std::chrono::system_clock::time_point& source_timestamp,
+            std::chrono::milliseconds timeout) override;
+
     bool read_request(
             uint16_t replier_id,
             std::vector<uint8_t>& data,
@@ -202,6 +211,21 @@ public:
             std::vector<uint8_t>& data,
             std::chrono::milliseconds timeout) override;
 
+/**********************************************************************************************************************
+ * Notification functions.
+ **********************************************************************************************************************/
+    bool set_data_available_callback(
+            uint16_t datareader_id,
+            std::function<void ()> callback) override;
+
+    bool set_reply_available_callback(
+            uint16_t requester_id,
+            std::function<void ()> callback) override;
+
+    bool set_request_available_callback(
+            uint16_t replier_id,
+            std::function<void ()> callback) override;
+
 /**********************************************************************************************************************
  * Matched functions.
  **********************************************************************************************************************/
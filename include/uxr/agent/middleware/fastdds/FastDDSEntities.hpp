@@ -22,10 +22,17 @@
 #include <fastdds/dds/publisher/DataWriter.hpp>
 #include <fastdds/dds/subscriber/Subscriber.hpp>
 #include <fastdds/dds/subscriber/DataReader.hpp>
+#include <fastdds/dds/subscriber/DataReaderListener.hpp>
+#include <fastdds/rtps/flowcontrol/FlowControllerSchedulerPolicy.hpp>
 #include <fastrtps/attributes/all_attributes.h>
+#include <uxr/agent/middleware/Middleware.hpp>
 #include <uxr/agent/types/TopicPubSubType.hpp>
 #include <uxr/agent/types/XRCETypes.hpp>
 
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
 #include <unordered_map>
 
 namespace eprosima {
@@ -34,6 +41,47 @@ namespace uxr {
 class FastDDSType;
 class FastDDSTopic;
 
+/* Wall-clock time point of a DDS timestamp. */
+inline std::chrono::system_clock::time_point to_time_point(
+        const fastrtps::rtps::Time_t& time)
+{
+    return std::chrono::system_clock::time_point(
+        std::chrono::duration_cast<std::chrono::system_clock::duration>(
+            std::chrono::seconds(time.seconds()) + std::chrono::nanoseconds(time.nanosec())));
+}
+
+/**********************************************************************************************************************
+ * FastDDSPublishMode
+ **********************************************************************************************************************/
+/* Agent-wide publication mode of the DataWriters, to be set before any client is created. */
+struct FastDDSPublishMode
+{
+    bool asynchronous = false;
+
+    /* Flow controller of the asynchronous DataWriters, no limit if max_bytes_per_period is 0. */
+    int32_t max_bytes_per_period = 0;
+    uint64_t period_ms = 100;
+    fastdds::rtps::FlowControllerSchedulerPolicy scheduler = fastdds::rtps::FlowControllerSchedulerPolicy::FIFO;
+
+    static constexpr const char* flow_controller_name = "uxr_agent_flow_controller";
+
+    static FastDDSPublishMode& get_default();
+};
+
+/**********************************************************************************************************************
+ * FastDDSTransports
+ **********************************************************************************************************************/
+/* Agent-wide transports of the DomainParticipants, to be set before any client is created. */
+struct FastDDSTransports
+{
+    /* Shared memory segment size, the Fast DDS builtin transports are kept if 0. */
+    uint32_t shm_segment_size = 0;
+
+    /* Bound of the samples of the types, which allows data-sharing delivery on unkeyed topics, unbounded if 0. */
+    uint32_t max_sample_size = 0;
+
+    static FastDDSTransports& get_default();
+};
 
 /**********************************************************************************************************************
  * FastDDSParticipant
@@ -121,6 +169,8 @@ private:
     fastdds::dds::DomainParticipant* ptr_;
     fastdds::dds::DomainParticipantFactory* factory_;
     int16_t domain_id_;
+    /* Participants may be shared by several clients (see FastDDSMiddleware). */
+    mutable std::mutex register_mtx_;
     std::unordered_map<std::string, std::weak_ptr<FastDDSType>> type_register_;
     std::unordered_map<std::string, std::weak_ptr<FastDDSTopic>> topic_register_;
 };
@@ -242,6 +292,7 @@ public:
 
 
     std::shared_ptr<FastDDSParticipant> get_participant() const { return participant_; }
+    const fastdds::dds::SubscriberQos& get_qos() const { return ptr_->get_qos(); }
 
 private:
     std::shared_ptr<FastDDSParticipant> participant_;
@@ -252,7 +303,7 @@ private:
 /**********************************************************************************************************************
  * FastDDSDataWriter
  **********************************************************************************************************************/
-class FastDDSDataWriter
+class FastDDSDataWriter : public Middleware::DataWriterHandle
 {
 public:
     FastDDSDataWriter(const std::shared_ptr<FastDDSPublisher>& publisher)
@@ -272,7 +323,7 @@ public:
         std::shared_ptr<eprosima::uxr::FastDDSTopic> topic);
     bool match(const fastrtps::PublisherAttributes& attrs) const;
     bool match_from_bin(const dds::xrce::OBJK_DataWriter_Binary& datawriter_xrce) const;
-    bool write(const std::vector<uint8_t>& data);
+    bool write(const std::vector<uint8_t>& data) override;
     const fastdds::dds::DataWriter* ptr() const;
     const fastdds::dds::DomainParticipant* participant() const;
     std::shared_ptr<FastDDSTopic> topic_;
@@ -291,6 +342,10 @@ public:
     FastDDSDataReader(const std::shared_ptr<FastDDSSubscriber>& subscriber)
         : subscriber_{subscriber}
         , ptr_{nullptr}
+        , listener_{*this}
+        , callbacks_mtx_{}
+        , callbacks_{}
+        , last_callback_{0}
     {}
 
     ~FastDDSDataReader();
@@ -313,9 +368,122 @@ public:
     const fastdds::dds::DomainParticipant* participant() const;
     std::shared_ptr<FastDDSTopic> topic_;
 
+    /* Callbacks run on the DDS listener thread, so they are expected to just post work. */
+    uint32_t add_data_available_callback(std::function<void ()> callback);
+    void remove_data_available_callback(uint32_t id);
+
 private:
+    class Listener : public fastdds::dds::DataReaderListener
+    {
+    public:
+        Listener(FastDDSDataReader& owner) : owner_(owner) {}
+        void on_data_available(fastdds::dds::DataReader* reader) override;
+
+    private:
+        FastDDSDataReader& owner_;
+    };
+
     std::shared_ptr<FastDDSSubscriber> subscriber_;
     fastdds::dds::DataReader* ptr_;
+    Listener listener_;
+    std::mutex callbacks_mtx_;
+    std::unordered_map<uint32_t, std::function<void ()>> callbacks_;
+    uint32_t last_callback_;
+};
+
+/**********************************************************************************************************************
+ * FastDDSReaderFanOut
+ **********************************************************************************************************************/
+/**
+ * Takes each sample once from a DataReader shared by several clients and queues a reference to it
+ * for every subscription. Whichever subscription finds its queue empty takes the next sample on behalf
+ * of all the others.
+ */
+class FastDDSReaderFanOut
+{
+public:
+    FastDDSReaderFanOut(
+            const std::shared_ptr<FastDDSDataReader>& reader,
+            const fastdds::dds::SubscriberQos& subscriber_qos);
+
+    uint32_t subscribe();
+    void unsubscribe(uint32_t subscription);
+    bool read(
+            uint32_t subscription,
+            std::vector<uint8_t>& data,
+            std::chrono::milliseconds timeout,
+            fastrtps::rtps::GUID_t& writer_guid,
+            std::chrono::system_clock::time_point& source_timestamp);
+
+    const std::shared_ptr<FastDDSDataReader>& get_reader() const { return reader_; }
+    const fastdds::dds::SubscriberQos& get_subscriber_qos() const { return subscriber_qos_; }
+
+private:
+    struct Sample
+    {
+        std::shared_ptr<const std::vector<uint8_t>> data;
+        fastrtps::rtps::GUID_t writer_guid;
+        std::chrono::system_clock::time_point source_timestamp;
+    };
+
+    std::shared_ptr<FastDDSDataReader> reader_;
+    fastdds::dds::SubscriberQos subscriber_qos_;
+    size_t max_queued_;
+    std::mutex mtx_;
+    std::condition_variable cv_;
+    bool taking_;
+    uint32_t last_subscription_;
+    std::unordered_map<uint32_t, std::deque<Sample>> queues_;
+};
+
+/**
+ * A client's view of a shared DataReader.
+ */
+class FastDDSReaderSubscription
+{
+public:
+    FastDDSReaderSubscription(const std::shared_ptr<FastDDSReaderFanOut>& fan_out)
+        : fan_out_{fan_out}
+        , id_{fan_out->subscribe()}
+    {}
+
+    ~FastDDSReaderSubscription() { fan_out_->unsubscribe(id_); }
+
+    FastDDSReaderSubscription(const FastDDSReaderSubscription&) = delete;
+    FastDDSReaderSubscription& operator=(const FastDDSReaderSubscription&) = delete;
+
+    bool read(
+            std::vector<uint8_t>& data,
+            std::chrono::milliseconds timeout,
+            fastrtps::rtps::GUID_t& writer_guid,
+            std::chrono::system_clock::time_point& source_timestamp)
+    {
+        return fan_out_->read(id_, data, timeout, writer_guid, source_timestamp);
+    }
+
+private:
+    std::shared_ptr<FastDDSReaderFanOut> fan_out_;
+    uint32_t id_;
+};
+
+/**********************************************************************************************************************
+ * FastDDSNotifier
+ **********************************************************************************************************************/
+/**
+ * Forwards the data available notifications of a DataReader to a callback that can be replaced at any time.
+ * The callback runs on the DDS listener thread, so it is expected to just post work.
+ */
+class FastDDSNotifier : public fastdds::dds::DataReaderListener
+{
+public:
+    /* Once it returns the previous callback is not running and will not run anymore. */
+    void set_callback(std::function<void ()> callback);
+
+    void on_data_available(fastdds::dds::DataReader* reader) override;
+
+private:
+    std::mutex mtx_;
+    std::function<void ()> callback_;
 };
 
 /**********************************************************************************************************************
@@ -364,6 +532,9 @@ public:
 
     const fastdds::dds::DataReader* get_reply_datareader() const;
 
+    /* Notifies the samples arriving at its DataReader. */
+    void set_data_available_callback(std::function<void ()> callback);
+
 private:
     bool match(const fastrtps::RequesterAttributes& attrs) const;
 
@@ -381,6 +552,7 @@ private:
 
     fastdds::dds::Subscriber* subscriber_ptr_;
     fastdds::dds::DataReader* datareader_ptr_;
+    FastDDSNotifier notifier_;
 
     dds::GUID_t publisher_id_;
     std::map<int64_t, uint32_t> sequence_to_sequence_;
@@ -423,6 +595,9 @@ public:
 
     const fastdds::dds::DataReader* get_request_datareader() const;
 
+    /* Notifies the samples arriving at its DataReader. */
+    void set_data_available_callback(std::function<void ()> callback);
+
     const fastdds::dds::DataWriter* get_reply_datawriter() const;
 
 private:
@@ -448,6 +623,7 @@ private:
 
     fastdds::dds::Subscriber* subscriber_ptr_;
     fastdds::dds::DataReader* datareader_ptr_;
+    FastDDSNotifier notifier_;
 };
 
 } // namespace uxr
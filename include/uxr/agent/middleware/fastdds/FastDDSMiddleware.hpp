@@ -19,8 +19,10 @@
 #include <uxr/agent/middleware/fastdds/FastDDSEntities.hpp>
 
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <unordered_map>
+#include <unordered_set>
 
 namespace eprosima {
 namespace uxr {
@@ -32,8 +34,19 @@ class FastDDSMiddleware : public Middleware
 {
 public:
     FastDDSMiddleware();
-    FastDDSMiddleware(bool intraprocess_enabled);
-    ~FastDDSMiddleware() final = default;
+
+    /**
+     * @param intraprocess_enabled Filter out samples published by this same client.
+     * @param shared_participants  Reuse an agent-wide participant for clients requesting
+     *                             the same domain and profile.
+     * @param shared_readers       Back DataReaders with the same topic and QoS on a shared
+     *                             participant by a single DDS DataReader.
+     */
+    FastDDSMiddleware(
+            bool intraprocess_enabled,
+            bool shared_participants = false,
+            bool shared_readers = false);
+    ~FastDDSMiddleware() final;
 
 /**********************************************************************************************************************
  * Create functions.
@@ -175,6 +188,9 @@ public:
             uint16_t datawriter_id,
             const std::vector<uint8_t>& data) override;
 
+    DataWriterHandle* get_datawriter_handle(
+            uint16_t datawriter_id) override;
+
     bool write_request(
             uint16_t requester_id,
             uint32_t sequence_number,
@@ -189,6 +205,12 @@ public:
             std::vector<uint8_t>& data,
             std::chrono::milliseconds timeout) override;
 
+    bool read_timestamped_data(
+            uint16_t datareader_id,
+            std::vector<uint8_t>& data,
+            std::chrono::system_clock::time_point& source_timestamp,
+            std::chrono::milliseconds timeout) override;
+
     bool read_request(
             uint16_t replier_id,
             std::vector<uint8_t>& data,
@@ -200,6 +222,21 @@ public:
             std::vector<uint8_t>& data,
             std::chrono::milliseconds timeout) override;
 
+/**********************************************************************************************************************
+ * Notification functions.
+ **********************************************************************************************************************/
+    bool set_data_available_callback(
+            uint16_t datareader_id,
+            std::function<void ()> callback) override;
+
+    bool set_reply_available_callback(
+            uint16_t requester_id,
+            std::function<void ()> callback) override;
+
+    bool set_request_available_callback(
+            uint16_t replier_id,
+            std::function<void ()> callback) override;
+
 /**********************************************************************************************************************
  * Matched functions.
  **********************************************************************************************************************/
@@ -286,18 +323,50 @@ private:
         std::shared_ptr<FastDDSParticipant>& participant,
         const fastrtps::ReplierAttributes& attrs);
 
+    std::shared_ptr<FastDDSParticipant> acquire_participant(
+        const std::string& key,
+        int16_t domain_id,
+        const std::function<bool(FastDDSParticipant&)>& create,
+        bool& created);
+
+    bool release_participant(
+        const std::shared_ptr<FastDDSParticipant>& participant);
+
+    std::shared_ptr<FastDDSDataReader> acquire_datareader(
+        uint16_t datareader_id,
+        const std::shared_ptr<FastDDSSubscriber>& subscriber,
+        const std::string& key,
+        const std::function<bool(FastDDSDataReader&)>& create);
+
     int16_t get_domain_id_from_env();
 
+    struct GUIDHash
+    {
+        size_t operator()(
+                const fastrtps::rtps::GUID_t& guid) const;
+    };
+
+    typedef std::unordered_set<fastrtps::rtps::GUID_t, GUIDHash> GUIDSet;
+
     int16_t agent_domain_id_ = 0;
+    bool shared_participants_ = false;
+    bool shared_readers_ = false;
     std::unordered_map<uint16_t, std::shared_ptr<FastDDSParticipant>> participants_;
     std::unordered_map<uint16_t, std::shared_ptr<FastDDSTopic>> topics_;
     std::unordered_map<uint16_t, std::shared_ptr<FastDDSPublisher>> publishers_;
     std::unordered_map<uint16_t, std::shared_ptr<FastDDSSubscriber>> subscribers_;
     std::unordered_map<uint16_t, std::shared_ptr<FastDDSDataWriter>> datawriters_;
     std::unordered_map<uint16_t, std::shared_ptr<FastDDSDataReader>> datareaders_;
+    std::unordered_map<uint16_t, std::unique_ptr<FastDDSReaderSubscription>> reader_subscriptions_;
+    std::unordered_map<uint16_t, uint32_t> reader_callbacks_;
     std::unordered_map<uint16_t, std::shared_ptr<FastDDSRequester>> requesters_;
     std::unordered_map<uint16_t, std::shared_ptr<FastDDSReplier>> repliers_;
 
+    /* Local writers, for filtering self-echoes in intraprocess mode. */
+    GUIDSet datawriter_guids_;
+    GUIDSet requester_guids_;
+    GUIDSet replier_guids_;
+
     middleware::CallbackFactory& callback_factory_;
 };
 
@@ -17,10 +17,9 @@
 
 #include <uxr/client/client.h>
 #include <array>
-#include <thread>
+#include <chrono>
 #include <set>
 #include <mutex>
-#include <atomic>
 
 namespace eprosima {
 namespace uxr {
@@ -29,6 +28,9 @@ class Agent;
 
 const uint8_t internal_client_history = 8; // TODO (julian): take from config.
 
+/* How often a session with unconfirmed output is run, to send its heartbeats. */
+constexpr std::chrono::milliseconds internal_client_heartbeat_period(10);
+
 class InternalClient
 {
 public:
@@ -45,19 +47,25 @@ public:
 
     bool stop();
 
+    /* Creates the entities of the new domains and topics, then sends and receives without blocking. */
+    void run_session();
+
     Agent& get_agent() { return agent_; }
 
+    int get_fd() const { return transport_.platform.poll_fd.fd; }
+
+    /* When run_session shall be called again even if nothing is received. */
+    std::chrono::steady_clock::time_point get_deadline() const { return deadline_; }
+
 private:
     void set_callback();
 
     void create_streams();
 
-    void create_domain_entities();
+    bool create_domain_entities();
 
     void create_topic_entities();
 
-    void loop();
-
     void on_new_domain(int16_t domain);
 
     void on_new_topic(
@@ -86,8 +94,7 @@ private:
     uxrStreamId out_stream_id_;
     uxrStreamId in_stream_id_;
 
-    std::atomic<bool> running_cond_;
-    std::thread thread_;
+    std::chrono::steady_clock::time_point deadline_;
     std::mutex mtx_;
 };
 
@@ -15,9 +15,12 @@
 #ifndef UXR_AGENT_P2P_INTERNAL_CLIENT_MANAGER_HPP_
 #define UXR_AGENT_P2P_INTERNAL_CLIENT_MANAGER_HPP_
 
+#include <array>
+#include <atomic>
 #include <map>
 #include <mutex>
 #include <memory>
+#include <thread>
 
 struct uxrAgentAddress;
 
@@ -42,6 +45,9 @@ public:
 
     void delete_clients();
 
+    /* Makes the loop run every session, for work queued from other threads. */
+    void wake_up();
+
 private:
     InternalClientManager();
     ~InternalClientManager();
@@ -51,10 +57,22 @@ private:
     InternalClientManager& operator=(InternalClientManager&&) = delete;
     InternalClientManager& operator=(const InternalClientManager&) = delete;
 
+    bool start_loop();
+
+    void loop();
+
 private:
     std::mutex mtx_;
     uint32_t local_client_key_;
     std::map<uint32_t, std::unique_ptr<InternalClient>> clients_;
+
+    /* Single epoll loop running the sessions of every client. */
+    int epoll_fd_;
+    /* Opened and closed under event_mtx_, since other threads wake the loop up, also while holding mtx_. */
+    std::mutex event_mtx_;
+    int event_fd_;
+    std::thread thread_;
+    std::atomic<bool> running_cond_;
 };
 
 } // namespace uxr
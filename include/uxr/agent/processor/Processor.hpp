@@ -25,6 +25,7 @@ namespace dds {
 namespace xrce {
 
 class TransportAddress;
+class ACKNACK_Payload;
 
 }
 }
@@ -48,6 +49,8 @@ struct OutputPacket;
 
 struct WriteFnArgs;
 
+enum class WriteResult : uint8_t;
+
 template<typename EndPoint>
 class Processor
 {
@@ -66,13 +69,16 @@ public:
             InputPacket<EndPoint>&& input_packet,
             OutputPacket<EndPoint>& output_packet) const;
 
-    bool process_get_info_packet(
-            InputPacket<IPv4EndPoint>&& input_packet,
-            std::vector<dds::xrce::TransportAddress>& address,
-            OutputPacket<IPv4EndPoint>& output_packet) const;
+    /* Serializes the INFO submessage answering the discovery GET_INFOs, with a zero related request. */
+    bool get_info_submessage(
+            const std::vector<dds::xrce::TransportAddress>& address,
+            std::vector<uint8_t>& submessage) const;
 
     void check_heartbeats();
 
+    void check_acknacks(
+            const std::vector<uint32_t>& raw_client_keys);
+
 private:
     void process_input_message(
             ProxyClient& client,
@@ -125,7 +131,26 @@ private:
             ProxyClient& client,
             InputPacket<EndPoint>& input_packet);
 
-    bool read_data_callback(
+    /* Retransmissions are not fresh, the pending ACKNACKs do not ride on them. */
+    void push_output_packet(
+            ProxyClient& client,
+            OutputPacket<EndPoint>&& output_packet,
+            bool fresh = true);
+
+    void push_output_packet(
+            OutputPacket<EndPoint>&& output_packet);
+
+    void flush_acknacks(
+            ProxyClient& client,
+            const EndPoint& destination,
+            bool force);
+
+    void push_acknacks(
+            ProxyClient& client,
+            const EndPoint& destination,
+            const std::vector<dds::xrce::ACKNACK_Payload>& acknacks);
+
+    WriteResult read_data_callback(
             const WriteFnArgs& write_args,
             const std::vector<uint8_t>& buffer,
             std::chrono::milliseconds timeout);
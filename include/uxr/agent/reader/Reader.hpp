@@ -16,12 +16,14 @@
 #define UXR_AGENT_READER_READER_HPP_
 
 #include <uxr/agent/types/XRCETypes.hpp>
-#include <uxr/agent/utils/TokenBucket.hpp>
+#include <uxr/agent/reader/ReaderExecutor.hpp>
+#include <uxr/agent/utils/Pacer.hpp>
 
 #include <atomic>
-#include <thread>
+#include <functional>
 #include <mutex>
 #include <chrono>
+#include <memory>
 #include <type_traits>
 
 namespace eprosima {
@@ -36,6 +38,16 @@ struct WriteFnArgs
     dds::xrce::StreamId stream_id;
     dds::xrce::ObjectId object_id;
     dds::xrce::RequestId request_id;
+    dds::xrce::DataFormat data_format;
+    std::function<void()> resume;
+};
+
+/* Outcome of a write: done, or not done and retried either after a while or once the reader is resumed. */
+enum class WriteResult : uint8_t
+{
+    written,
+    retry,
+    parked
 };
 
 template<typename RA, typename WA = const WriteFnArgs&>
@@ -43,9 +55,15 @@ class Reader
 {
 public:
     typedef const std::function<bool (RA, std::vector<uint8_t>&, std::chrono::milliseconds)> ReadFn;
-    typedef const std::function<bool (WA, const std::vector<uint8_t>&, std::chrono::milliseconds)> WriteFn;
+    typedef const std::function<WriteResult (WA, const std::vector<uint8_t>&, std::chrono::milliseconds)> WriteFn;
+    typedef std::chrono::system_clock::time_point SampleTime;
+    typedef const std::function<void (std::vector<std::vector<uint8_t>>&, const std::vector<SampleTime>&,
+                                      std::vector<uint8_t>&)> BatchFn;
+    typedef const std::function<size_t (size_t, size_t)> BatchSizeFn;
+    typedef const std::function<SampleTime ()> SampleTimeFn;
 
 public:
+    Reader();
     ~Reader();
 
     bool start_reading(
@@ -57,30 +75,137 @@ public:
 
     bool stop_reading();
 
+    /**
+     * Event-driven delivery: instead of polling read_fn, the read task waits to be woken up
+     * through notify() whenever new data is available.
+     */
+    void set_notified(
+        bool notified);
+
+    void notify();
+
+    /**
+     * Batched delivery: up to max_samples samples are read and encoded together by batch_fn into
+     * a single write of at most max_bytes, unless a single sample is larger. size_fn gives the encoded
+     * size of a batch once a sample of the given size is appended to it, zero being an empty batch.
+     * An empty batch_fn restores one sample per write. time_fn, if any, gives the timestamp of the
+     * sample just read, batch_fn gets them along with the samples.
+     */
+    void set_batching(
+        BatchFn batch_fn,
+        BatchSizeFn size_fn,
+        uint16_t max_samples,
+        size_t max_bytes,
+        SampleTimeFn time_fn = nullptr);
+
+    /**
+     * Link-level pacing: writes wait, without blocking, until the pacer shared by every reader
+     * of the client lets them go. A null pacer only keeps the per-read max_bytes_per_second.
+     */
+    void set_link_pacer(
+            utils::Pacer* link_pacer);
+
+    /**
+     * Callback waking the reader up after write_fn returned WriteResult::parked, such as when the
+     * reliable window of the client frees up. It may outlive the reader.
+     */
+    std::function<void()> get_resume_fn() const;
+
 private:
-    void read_task(
-        ReadFn read_fn,
-        WriteFn write_fn);
+    bool read_batch();
+
+    bool read_latest();
+
+    void read_step();
 
 private:
     dds::xrce::DataDeliveryControl delivery_control_;
     typename std::decay<RA>::type read_args_;
     typename std::decay<WA>::type write_args_;
+    typename std::decay<ReadFn>::type read_fn_;
+    typename std::decay<WriteFn>::type write_fn_;
     std::atomic<bool> running_cond_;
-    std::thread thread_;
     std::mutex mtx_;
 
+    /* Read task, registered once and reused by every READ_DATA. */
+    ReaderExecutor::TaskId task_id_;
+    bool notified_;
+    utils::Pacer rate_pacer_;
+    utils::Pacer* link_pacer_;
+    std::chrono::steady_clock::time_point final_time_;
+    std::chrono::milliseconds poll_period_;
+    uint16_t message_count_;
+    std::vector<uint8_t> data_;
+    bool data_pending_;
+    uint16_t data_samples_;
+
+    /* Time-based filter (min_pace_period): only the latest sample is delivered once per period. */
+    std::chrono::milliseconds pace_period_;
+    std::chrono::steady_clock::time_point next_pace_time_;
+    std::vector<uint8_t> latest_;
+    SampleTime latest_time_;
+
+    typename std::decay<BatchFn>::type batch_fn_;
+    typename std::decay<BatchSizeFn>::type batch_size_fn_;
+    typename std::decay<SampleTimeFn>::type sample_time_fn_;
+    uint16_t batch_max_samples_;
+    size_t batch_max_bytes_;
+    std::vector<std::vector<uint8_t>> batch_;
+    std::vector<SampleTime> batch_times_;
+    std::vector<uint8_t> batch_carry_;
+    SampleTime batch_carry_time_;
+    bool batch_carry_pending_;
+
     static constexpr uint8_t rw_timeout = 100;
+    static constexpr uint8_t step_samples = 16;
+    static constexpr uint8_t retry_period = 10;
+    static constexpr uint16_t notified_poll_period = 1000;
     static constexpr uint16_t max_samples_zero = 0;
     static constexpr uint16_t max_samples_unlimited = 0xFFFF;
     static constexpr uint16_t max_elapsed_time_unlimited = 0;
     static constexpr uint16_t max_bytes_per_second_unlimited = 0;
 };
 
+template<typename RA, typename WA>
+inline Reader<RA, WA>::Reader()
+    : delivery_control_{}
+    , read_args_{}
+    , write_args_{}
+    , read_fn_{}
+    , write_fn_{}
+    , running_cond_{false}
+    , mtx_{}
+    , task_id_{ReaderExecutor::instance().add(std::bind(&Reader<RA, WA>::read_step, this))}
+    , notified_{false}
+    , rate_pacer_{}
+    , link_pacer_{nullptr}
+    , final_time_{}
+    , poll_period_{1}
+    , message_count_{0}
+    , data_{}
+    , data_pending_{false}
+    , data_samples_{0}
+    , pace_period_{0}
+    , next_pace_time_{}
+    , latest_{}
+    , latest_time_{}
+    , batch_fn_{}
+    , batch_size_fn_{}
+    , sample_time_fn_{}
+    , batch_max_samples_{1}
+    , batch_max_bytes_{SIZE_MAX}
+    , batch_{}
+    , batch_times_{}
+    , batch_carry_{}
+    , batch_carry_time_{}
+    , batch_carry_pending_{false}
+{
+}
+
 template<typename RA, typename WA>
 inline Reader<RA, WA>::~Reader()
 {
-    stop_reading();
+    ReaderExecutor::instance().remove(task_id_);
 }
 
 template<typename RA, typename WA>
@@ -91,15 +216,37 @@ inline bool Reader<RA, WA>::start_reading(
         WriteFn write_fn,
         WA write_args)
 {
+    using namespace std::chrono;
+
     std::lock_guard<std::mutex> lock(mtx_);
     bool rv = false;
     if (!running_cond_)
     {
+        /* A read that finished on its own may still be wrapping up its last step. */
+        ReaderExecutor& executor = ReaderExecutor::instance();
+        executor.cancel(task_id_);
+
         delivery_control_ = delivery_control;
+        read_fn_ = read_fn;
         read_args_ = read_args;
+        write_fn_ = write_fn;
         write_args_ = write_args;
+
+        /* Up to a second worth of bytes at once, like a bucket of max_bytes_per_second tokens. */
+        const size_t rate = delivery_control_.max_bytes_per_second();
+        rate_pacer_.reset(rate, rate);
+        final_time_ = (max_elapsed_time_unlimited == delivery_control_.max_elapsed_time())
+            ? steady_clock::time_point::max()
+            : steady_clock::now() + seconds(delivery_control_.max_elapsed_time());
+        poll_period_ = milliseconds(1);
+        pace_period_ = milliseconds(delivery_control_.min_pace_period());
+        next_pace_time_ = steady_clock::now();
+        message_count_ = 0;
+        data_pending_ = false;
+        batch_carry_pending_ = false;
+
         running_cond_ = true;
-        thread_ = std::thread(&Reader<RA, WA>::read_task, this, read_fn, write_fn);
+        executor.post(task_id_);
         rv = true;
     }
     return rv;
@@ -109,70 +256,262 @@ template<typename RA, typename WA>
 inline bool Reader<RA, WA>::stop_reading()
 {
     std::lock_guard<std::mutex> lock(mtx_);
-    bool rv = true;
+    running_cond_ = false;
+    ReaderExecutor::instance().cancel(task_id_);
+    return true;
+}
+
+template<typename RA, typename WA>
+inline void Reader<RA, WA>::set_notified(
+        bool notified)
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    notified_ = notified;
+}
+
+template<typename RA, typename WA>
+inline void Reader<RA, WA>::notify()
+{
     if (running_cond_)
     {
-        running_cond_ = false;
-        if (thread_.joinable())
+        ReaderExecutor::instance().post(task_id_);
+    }
+}
+
+template<typename RA, typename WA>
+inline void Reader<RA, WA>::set_batching(
+        BatchFn batch_fn,
+        BatchSizeFn size_fn,
+        uint16_t max_samples,
+        size_t max_bytes,
+        SampleTimeFn time_fn)
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    batch_fn_ = batch_fn;
+    batch_size_fn_ = size_fn;
+    sample_time_fn_ = time_fn;
+    batch_max_samples_ = std::max(uint16_t(1), max_samples);
+    batch_max_bytes_ = max_bytes;
+}
+
+template<typename RA, typename WA>
+inline void Reader<RA, WA>::set_link_pacer(
+        utils::Pacer* link_pacer)
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    link_pacer_ = link_pacer;
+}
+
+template<typename RA, typename WA>
+inline std::function<void()> Reader<RA, WA>::get_resume_fn() const
+{
+    /* Task ids are never reused, posting a removed one does nothing. */
+    const ReaderExecutor::TaskId task_id = task_id_;
+    return [task_id]()
+    {
+        ReaderExecutor::instance().post(task_id);
+    };
+}
+
+template<typename RA, typename WA>
+inline bool Reader<RA, WA>::read_batch()
+{
+    using namespace std::chrono;
+
+    uint16_t limit = batch_max_samples_;
+    if (max_samples_unlimited != delivery_control_.max_samples())
+    {
+        limit = std::min(limit, uint16_t(delivery_control_.max_samples() - message_count_));
+    }
+
+    size_t bytes = 0;
+    batch_.clear();
+    batch_times_.clear();
+    while (batch_.size() < limit)
+    {
+        std::vector<uint8_t> sample;
+        SampleTime sample_time{};
+        if (batch_carry_pending_)
+        {
+            sample.swap(batch_carry_);
+            sample_time = batch_carry_time_;
+            batch_carry_pending_ = false;
+        }
+        else if (read_fn_(read_args_, sample, milliseconds(0)))
+        {
+            sample_time = sample_time_fn_ ? sample_time_fn_() : SampleTime{};
+        }
+        else
+        {
+            break;
+        }
+
+        const size_t batch_bytes = batch_size_fn_ ? batch_size_fn_(bytes, sample.size()) : bytes + sample.size();
+        if (!batch_.empty() && (batch_max_bytes_ < batch_bytes))
+        {
+            /* Does not fit, it opens the next batch. */
+            batch_carry_.swap(sample);
+            batch_carry_time_ = sample_time;
+            batch_carry_pending_ = true;
+            break;
+        }
+        bytes = batch_bytes;
+        batch_.push_back(std::move(sample));
+        batch_times_.push_back(sample_time);
+    }
+
+    data_samples_ = uint16_t(batch_.size());
+    if (!batch_.empty())
+    {
+        batch_fn_(batch_, batch_times_, data_);
+    }
+    return !batch_.empty();
+}
+
+template<typename RA, typename WA>
+inline bool Reader<RA, WA>::read_latest()
+{
+    using namespace std::chrono;
+
+    /* Older samples are dropped before being encoded for the client. */
+    bool rv = false;
+    std::vector<uint8_t> sample;
+    while (read_fn_(read_args_, sample, milliseconds(0)))
+    {
+        latest_.swap(sample);
+        latest_time_ = sample_time_fn_ ? sample_time_fn_() : SampleTime{};
+        rv = true;
+    }
+
+    if (rv)
+    {
+        data_samples_ = 1;
+        if (batch_fn_)
         {
-            thread_.join();
+            batch_.clear();
+            batch_.push_back(std::move(latest_));
+            batch_times_.assign(1, latest_time_);
+            batch_fn_(batch_, batch_times_, data_);
         }
         else
         {
-            rv = false;
+            data_.swap(latest_);
         }
     }
     return rv;
 }
 
 template<typename RA, typename WA>
-inline void Reader<RA, WA>::read_task(
-        ReadFn read_fn,
-        WriteFn write_fn)
+inline void Reader<RA, WA>::read_step()
 {
-    using namespace eprosima::uxr::utils;
     using namespace std::chrono;
 
-    constexpr std::chrono::milliseconds max_timeout{rw_timeout};
-
-    size_t rate = (max_bytes_per_second_unlimited == delivery_control_.max_bytes_per_second())
-        ? SIZE_MAX
-        : delivery_control_.max_bytes_per_second();
-    TokenBucket token_bucket{rate};
-    bool stop_cond = false;
-    uint16_t message_count = 0;
-    std::vector<uint8_t> data;
-    time_point<steady_clock> init_time = steady_clock::now();
-    time_point<steady_clock> final_time = (max_elapsed_time_unlimited == delivery_control_.max_elapsed_time()) 
-        ? time_point<steady_clock>::max()
-        : init_time + seconds(delivery_control_.max_elapsed_time());
-
-    milliseconds timeout;
-    while (running_cond_ && !stop_cond)
+    if (running_cond_)
     {
-        timeout = std::min(max_timeout, duration_cast<milliseconds>(final_time - steady_clock::now()));
-        if (read_fn(read_args_, data, timeout))
+        /* Deliver what is already available without blocking, a bounded amount per step. */
+        bool stop_cond = false;
+        bool blocked = false;
+        bool parked = false;
+        bool paced = (milliseconds(0) < pace_period_) && (steady_clock::now() < next_pace_time_);
+        uint8_t step_count = 0;
+        steady_clock::time_point resume_time{};
+        while (!stop_cond && !blocked && !paced && (step_count < step_samples))
         {
-            bool submessage_pushed = false;
-            do {
-                if (token_bucket.consume_tokens(data.size(), timeout))
+            /* Rate limits only delay the next step, samples are kept in the middleware meanwhile. */
+            const steady_clock::time_point write_time = steady_clock::now();
+            resume_time = rate_pacer_.get_eligible_time(write_time);
+            if (nullptr != link_pacer_)
+            {
+                resume_time = std::max(resume_time, link_pacer_->get_eligible_time(write_time));
+            }
+            if (write_time < resume_time)
+            {
+                blocked = true;
+                break;
+            }
+
+            if (!data_pending_)
+            {
+                if (milliseconds(0) < pace_period_)
+                {
+                    data_pending_ = read_latest();
+                }
+                else if (batch_fn_)
+                {
+                    data_pending_ = read_batch();
+                }
+                else
                 {
-                    do {
-                        timeout = std::min(max_timeout, duration_cast<milliseconds>(final_time - steady_clock::now()));
-                        submessage_pushed = write_fn(write_args_, data, timeout);
-                    } while (running_cond_ && !submessage_pushed);
-
-                    if (submessage_pushed)
-                    {
-                        ++message_count;
-                    }
+                    data_pending_ = read_fn_(read_args_, data_, milliseconds(0));
+                    data_samples_ = 1;
                 }
-            } while(running_cond_ && !submessage_pushed);
+                if (!data_pending_)
+                {
+                    break;
+                }
+            }
+
+            const WriteResult write_result = write_fn_(write_args_, data_, milliseconds(0));
+            if (WriteResult::written == write_result)
+            {
+                rate_pacer_.consume(data_.size(), write_time);
+                data_pending_ = false;
+                message_count_ = uint16_t(message_count_ + data_samples_);
+                ++step_count;
+                stop_cond = (max_samples_unlimited != delivery_control_.max_samples()) &&
+                            (message_count_ >= delivery_control_.max_samples());
+                if (milliseconds(0) < pace_period_)
+                {
+                    next_pace_time_ = steady_clock::now() + pace_period_;
+                    paced = true;
+                }
+            }
+            else
+            {
+                blocked = true;
+                parked = (WriteResult::parked == write_result);
+                resume_time = write_time + milliseconds(retry_period);
+            }
         }
 
-        stop_cond = ((max_samples_unlimited != delivery_control_.max_samples()) &&
-                     (message_count == delivery_control_.max_samples())) || 
-                    (std::chrono::steady_clock::now() > final_time);
+        ReaderExecutor& executor = ReaderExecutor::instance();
+        const steady_clock::time_point now = steady_clock::now();
+        if (stop_cond || (now > final_time_))
+        {
+            running_cond_ = false;
+        }
+        else if (parked)
+        {
+            /* Output window full, the sample is kept until the ACKNACK freeing it resumes the reader. */
+            executor.post_at(task_id_, std::min(final_time_, now + milliseconds(notified_poll_period)));
+        }
+        else if (blocked)
+        {
+            /* Rate limit or output stream full, retry when due. */
+            executor.post_at(task_id_, std::min(final_time_, resume_time));
+        }
+        else if (paced)
+        {
+            /* Samples arriving meanwhile stay in the middleware, the latest is taken when due. */
+            executor.post_at(task_id_, std::min(final_time_, next_pace_time_));
+        }
+        else if (step_count == step_samples)
+        {
+            executor.post(task_id_);
+        }
+        else if (notified_)
+        {
+            /* Wait for a notification, with a slow poll in case one is missed. */
+            executor.post_at(task_id_, std::min(final_time_, now + milliseconds(notified_poll_period)));
+        }
+        else
+        {
+            /* No notifications, poll backing off while idle. */
+            poll_period_ = (0 == step_count)
+                ? std::min(milliseconds(rw_timeout), 2 * poll_period_)
+                : milliseconds(1);
+            executor.post_at(task_id_, std::min(final_time_, now + poll_period_));
+        }
     }
 }
 
@@ -0,0 +1,333 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef UXR_AGENT_READER_READEREXECUTOR_HPP_
+#define UXR_AGENT_READER_READEREXECUTOR_HPP_
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace eprosima {
+namespace uxr {
+
+/**
+ * Small pool of workers running the delivery steps of all the readers of the agent.
+ * A task runs when posted (data readiness) or when its timer expires, and never concurrently
+ * with itself; a post received while running makes it run once more.
+ */
+class ReaderExecutor
+{
+public:
+    typedef uint64_t TaskId;
+    typedef std::function<void()> Task;
+    typedef std::chrono::steady_clock::time_point TimePoint;
+
+    explicit ReaderExecutor(
+            size_t workers);
+
+    ~ReaderExecutor();
+
+    ReaderExecutor(ReaderExecutor&&) = delete;
+    ReaderExecutor(const ReaderExecutor&) = delete;
+    ReaderExecutor& operator=(ReaderExecutor&&) = delete;
+    ReaderExecutor& operator=(const ReaderExecutor&) = delete;
+
+    /**
+     * Agent-wide executor. Its size defaults to the number of cores (2 to 4) and may be set
+     * through the UXR_AGENT_READER_THREADS environment variable.
+     */
+    static ReaderExecutor& instance();
+
+    TaskId add(
+            Task task);
+
+    /* Waits for a running step to finish, unless called from the step itself. */
+    void remove(
+            TaskId id);
+
+    /* Like remove, but the task is kept registered to be posted again. */
+    void cancel(
+            TaskId id);
+
+    void post(
+            TaskId id);
+
+    /* Replaces any previous timer of the task. */
+    void post_at(
+            TaskId id,
+            TimePoint time);
+
+    size_t get_workers() const { return workers_.size(); }
+
+private:
+    struct Entry
+    {
+        std::shared_ptr<Task> task;
+        TimePoint timer;
+        bool queued;
+        bool running;
+        bool pending;
+        std::thread::id runner;
+    };
+
+    typedef std::pair<TimePoint, TaskId> Timer;
+
+    void enqueue(
+            TaskId id,
+            Entry& entry);
+
+    std::unordered_map<TaskId, Entry>::iterator wait_idle(
+            std::unique_lock<std::mutex>& lock,
+            TaskId id);
+
+    void worker_loop();
+
+private:
+    std::mutex mtx_;
+    std::condition_variable cv_;
+    std::condition_variable idle_cv_;
+    std::unordered_map<TaskId, Entry> tasks_;
+    std::deque<TaskId> ready_;
+    std::priority_queue<Timer, std::vector<Timer>, std::greater<Timer>> timers_;
+    TaskId last_id_;
+    bool running_;
+    std::vector<std::thread> workers_;
+};
+
+inline ReaderExecutor::ReaderExecutor(
+        size_t workers)
+    : mtx_{}
+    , cv_{}
+    , idle_cv_{}
+    , tasks_{}
+    , ready_{}
+    , timers_{}
+    , last_id_{0}
+    , running_{true}
+    , workers_{}
+{
+    workers = std::max(size_t(1), workers);
+    workers_.reserve(workers);
+    for (size_t i = 0; i < workers; ++i)
+    {
+        workers_.emplace_back(&ReaderExecutor::worker_loop, this);
+    }
+}
+
+inline ReaderExecutor::~ReaderExecutor()
+{
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        running_ = false;
+    }
+    cv_.notify_all();
+    for (auto& worker : workers_)
+    {
+        if (worker.joinable())
+        {
+            worker.join();
+        }
+    }
+}
+
+inline ReaderExecutor& ReaderExecutor::instance()
+{
+    static ReaderExecutor executor([]()
+    {
+        size_t workers = std::min(4u, std::max(2u, std::thread::hardware_concurrency()));
+        const char* env_workers = std::getenv("UXR_AGENT_READER_THREADS");
+        if (nullptr != env_workers && 0 < std::atoi(env_workers))
+        {
+            workers = size_t(std::atoi(env_workers));
+        }
+        return workers;
+    }());
+    return executor;
+}
+
+inline ReaderExecutor::TaskId ReaderExecutor::add(
+        Task task)
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    Entry entry{std::make_shared<Task>(std::move(task)), TimePoint::max(), false, false, false, std::thread::id{}};
+    tasks_.emplace(++last_id_, std::move(entry));
+    return last_id_;
+}
+
+inline std::unordered_map<ReaderExecutor::TaskId, ReaderExecutor::Entry>::iterator ReaderExecutor::wait_idle(
+        std::unique_lock<std::mutex>& lock,
+        TaskId id)
+{
+    auto it = tasks_.find(id);
+    while (tasks_.end() != it && it->second.running && std::this_thread::get_id() != it->second.runner)
+    {
+        idle_cv_.wait(lock);
+        it = tasks_.find(id);
+    }
+    return it;
+}
+
+inline void ReaderExecutor::remove(
+        TaskId id)
+{
+    std::unique_lock<std::mutex> lock(mtx_);
+    auto it = wait_idle(lock, id);
+    if (tasks_.end() != it)
+    {
+        tasks_.erase(it);
+    }
+}
+
+inline void ReaderExecutor::cancel(
+        TaskId id)
+{
+    std::unique_lock<std::mutex> lock(mtx_);
+    auto it = wait_idle(lock, id);
+    if (tasks_.end() != it)
+    {
+        /* Stale ready and timer entries are discarded by the workers. */
+        it->second.queued = false;
+        it->second.pending = false;
+        it->second.timer = TimePoint::max();
+    }
+}
+
+inline void ReaderExecutor::post(
+        TaskId id)
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    auto it = tasks_.find(id);
+    if (tasks_.end() != it)
+    {
+        enqueue(id, it->second);
+    }
+}
+
+inline void ReaderExecutor::post_at(
+        TaskId id,
+        TimePoint time)
+{
+    bool earliest = false;
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        auto it = tasks_.find(id);
+        if (tasks_.end() != it)
+        {
+            it->second.timer = time;
+            earliest = timers_.empty() || (time < timers_.top().first);
+            timers_.emplace(time, id);
+        }
+    }
+    if (earliest)
+    {
+        cv_.notify_one();
+    }
+}
+
+inline void ReaderExecutor::enqueue(
+        TaskId id,
+        Entry& entry)
+{
+    if (entry.running)
+    {
+        entry.pending = true;
+    }
+    else if (!entry.queued)
+    {
+        entry.queued = true;
+        ready_.push_back(id);
+        cv_.notify_one();
+    }
+}
+
+inline void ReaderExecutor::worker_loop()
+{
+    std::unique_lock<std::mutex> lock(mtx_);
+    while (running_)
+    {
+        /* Fire expired timers, stale ones (removed or re-armed tasks) are discarded. */
+        const TimePoint now = std::chrono::steady_clock::now();
+        while (!timers_.empty() && (timers_.top().first <= now))
+        {
+            Timer timer = timers_.top();
+            timers_.pop();
+            auto it = tasks_.find(timer.second);
+            if ((tasks_.end() != it) && (it->second.timer == timer.first))
+            {
+                it->second.timer = TimePoint::max();
+                enqueue(timer.second, it->second);
+            }
+        }
+
+        if (ready_.empty())
+        {
+            if (timers_.empty())
+            {
+                cv_.wait(lock);
+            }
+            else
+            {
+                cv_.wait_until(lock, timers_.top().first);
+            }
+            continue;
+        }
+
+        const TaskId id = ready_.front();
+        ready_.pop_front();
+        auto it = tasks_.find(id);
+        if ((tasks_.end() == it) || !it->second.queued)
+        {
+            continue;
+        }
+
+        it->second.queued = false;
+        it->second.running = true;
+        it->second.runner = std::this_thread::get_id();
+        std::shared_ptr<Task> task = it->second.task;
+
+        lock.unlock();
+        (*task)();
+        lock.lock();
+
+        it = tasks_.find(id);
+        if (tasks_.end() != it)
+        {
+            it->second.running = false;
+            it->second.runner = std::thread::id{};
+            if (it->second.pending)
+            {
+                it->second.pending = false;
+                enqueue(id, it->second);
+            }
+        }
+        idle_cv_.notify_all();
+    }
+}
+
+} // namespace uxr
+} // namespace eprosima
+
+#endif // UXR_AGENT_READER_READEREXECUTOR_HPP_
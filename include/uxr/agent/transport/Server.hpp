@@ -23,6 +23,11 @@
 #include <uxr/agent/processor/Processor.hpp>
 
 #include <thread>
+#include <queue>
+#include <vector>
+#include <chrono>
+#include <functional>
+#include <condition_variable>
 
 namespace eprosima {
 namespace uxr {
@@ -58,6 +63,11 @@ private:
     void push_output_packet(
             OutputPacket<EndPoint>&& output_packet);
 
+    /* Wakes the heartbeat thread at the deadline to flush the delayed ACKNACKs of the client. */
+    void push_acknack_timer(
+            uint32_t raw_client_key,
+            std::chrono::steady_clock::time_point deadline);
+
     virtual bool init() = 0;
 
     virtual bool fini() = 0;
@@ -126,6 +136,10 @@ private:
     TransportRc transport_rc_;
     std::mutex error_mtx_;
     std::condition_variable error_cv_;
+    typedef std::pair<std::chrono::steady_clock::time_point, uint32_t> AckNackTimer;
+    std::priority_queue<AckNackTimer, std::vector<AckNackTimer>, std::greater<AckNackTimer>> acknack_timers_;
+    std::mutex acknack_mtx_;
+    std::condition_variable acknack_cv_;
 };
 
 } // namespace uxr
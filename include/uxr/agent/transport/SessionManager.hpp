@@ -16,8 +16,14 @@
 #define UXR_AGENT_TRANSPORT_SESSIONMANAGER_HPP_
 
 #include <uxr/agent/logger/Logger.hpp>
+#include <uxr/agent/transport/endpoint/IPv4EndPoint.hpp>
+#include <uxr/agent/transport/endpoint/IPv6EndPoint.hpp>
+#include <uxr/agent/transport/endpoint/CanEndPoint.hpp>
+#include <uxr/agent/transport/endpoint/SerialEndPoint.hpp>
+#include <uxr/agent/transport/endpoint/MultiSerialEndPoint.hpp>
+#include <uxr/agent/utils/RcuMap.hpp>
 
-#include <memory>
+#include <array>
 #include <mutex>
 #include <map>
 
@@ -29,6 +35,150 @@ inline constexpr bool has_session_client_key(uint8_t session_id)
     return 128 > session_id;
 }
 
+/**
+ * @brief Ordered map behind a mutex, with the interface of utils::RcuMap.
+ */
+template<typename Key, typename T>
+class LockedMap
+{
+public:
+    bool get(
+            const Key& key,
+            T& value) const
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        auto it = map_.find(key);
+        bool rv = (it != map_.end());
+        if (rv)
+        {
+            value = it->second;
+        }
+        return rv;
+    }
+
+    void assign(
+            const Key& key,
+            const T& value)
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        map_[key] = value;
+    }
+
+    bool erase(
+            const Key& key)
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        return (0 < map_.erase(key));
+    }
+
+private:
+    mutable std::mutex mtx_;
+    std::map<Key, T> map_;
+};
+
+/**
+ * @brief Packs an endpoint into a fixed-width key suitable for hashed lookups.
+ *        Endpoints without a packed representation fall back to an ordered map.
+ */
+template<typename EndPoint>
+struct EndPointKey
+{
+    using key = EndPoint;
+
+    template<typename T>
+    using map = LockedMap<EndPoint, T>;
+
+    static const EndPoint& pack(const EndPoint& endpoint) { return endpoint; }
+};
+
+template<>
+struct EndPointKey<IPv4EndPoint>
+{
+    using key = uint64_t;
+
+    template<typename T>
+    using map = utils::RcuMap<uint64_t, T>;
+
+    static uint64_t pack(const IPv4EndPoint& endpoint)
+    {
+        return (uint64_t(endpoint.get_addr()) << 16) | endpoint.get_port();
+    }
+};
+
+template<>
+struct EndPointKey<IPv6EndPoint>
+{
+    struct Key
+    {
+        std::array<uint64_t, 2> addr;
+        uint16_t port;
+
+        bool operator==(const Key& other) const
+        {
+            return (addr == other.addr) && (port == other.port);
+        }
+    };
+
+    struct Hash
+    {
+        size_t operator()(const Key& key) const
+        {
+            return std::hash<uint64_t>()(key.addr[0] ^ (key.addr[1] * 0x9E3779B97F4A7C15ull) ^ key.port);
+        }
+    };
+
+    using key = Key;
+
+    template<typename T>
+    using map = utils::RcuMap<Key, T, Hash>;
+
+    static Key pack(const IPv6EndPoint& endpoint)
+    {
+        Key key{};
+        const std::array<uint8_t, 16>& addr = endpoint.get_addr();
+        for (size_t i = 0; i < addr.size(); ++i)
+        {
+            key.addr[i / 8] = (key.addr[i / 8] << 8) | addr[i];
+        }
+        key.port = endpoint.get_port();
+        return key;
+    }
+};
+
+template<>
+struct EndPointKey<CanEndPoint>
+{
+    using key = uint32_t;
+
+    template<typename T>
+    using map = utils::RcuMap<uint32_t, T>;
+
+    static uint32_t pack(const CanEndPoint& endpoint) { return endpoint.get_can_id(); }
+};
+
+template<>
+struct EndPointKey<SerialEndPoint>
+{
+    using key = uint8_t;
+
+    template<typename T>
+    using map = utils::RcuMap<uint8_t, T>;
+
+    static uint8_t pack(const SerialEndPoint& endpoint) { return endpoint.get_addr(); }
+};
+
+template<>
+struct EndPointKey<MultiSerialEndPoint>
+{
+    using key = int;
+
+    template<typename T>
+    using map = utils::RcuMap<int, T>;
+
+    /* Multi-serial endpoints are ordered by file descriptor only. */
+    static int pack(const MultiSerialEndPoint& endpoint) { return endpoint.get_fd(); }
+};
+
 template<typename EndPoint>
 class SessionManager
 {
@@ -53,8 +203,9 @@ public:
             EndPoint& endpoint);
 
 private:
-    std::map<EndPoint, uint32_t> endpoint_to_client_map_;
-    std::map<uint32_t, EndPoint> client_to_endpoint_map_;
+    /* Lookups take no lock, writers serialize on mtx_. */
+    typename EndPointKey<EndPoint>::template map<uint32_t> endpoint_to_client_map_;
+    utils::RcuMap<uint32_t, EndPoint> client_to_endpoint_map_;
     std::mutex mtx_;
 };
 
@@ -66,11 +217,13 @@ void SessionManager<EndPoint>::establish_session(
 {
     std::lock_guard<std::mutex> lock(mtx_);
 
-    auto it_client = client_to_endpoint_map_.find(client_key);
-    if (it_client != client_to_endpoint_map_.end())
+    typename EndPointKey<EndPoint>::key previous_key;
+    if (client_to_endpoint_map_.find(client_key, [&](const EndPoint& previous)
+        {
+            previous_key = EndPointKey<EndPoint>::pack(previous);
+        }))
     {
-        endpoint_to_client_map_.erase(it_client->second);
-        it_client->second = endpoint;
+        endpoint_to_client_map_.erase(previous_key);
         UXR_AGENT_LOG_INFO(
             UXR_DECORATE_GREEN("session re-established"),
             "client_key: 0x{:08X}, address: {}",
@@ -79,25 +232,17 @@ void SessionManager<EndPoint>::establish_session(
     }
     else
     {
-        client_to_endpoint_map_.emplace(client_key, endpoint);
         UXR_AGENT_LOG_INFO(
             UXR_DECORATE_GREEN("session established"),
             "client_key: 0x{:08X}, address: {}",
             client_key,
             endpoint);
     }
+    client_to_endpoint_map_.assign(client_key, endpoint);
 
     if (!has_session_client_key(session_id))
     {
-        auto it_endpoint = endpoint_to_client_map_.find(endpoint);
-        if (it_endpoint != endpoint_to_client_map_.end())
-        {
-            it_endpoint->second = client_key;
-        }
-        else
-        {
-            endpoint_to_client_map_.emplace(endpoint, client_key);
-        }
+        endpoint_to_client_map_.assign(EndPointKey<EndPoint>::pack(endpoint), client_key);
     }
 }
 
@@ -107,16 +252,16 @@ void SessionManager<EndPoint>::destroy_session(
 {
     std::lock_guard<std::mutex> lock(mtx_);
 
-    auto it = endpoint_to_client_map_.find(endpoint);
-    if (it != endpoint_to_client_map_.end())
+    uint32_t client_key;
+    if (endpoint_to_client_map_.get(EndPointKey<EndPoint>::pack(endpoint), client_key))
     {
         UXR_AGENT_LOG_INFO(
             UXR_DECORATE_GREEN("session closed"),
             "client_key: 0x{:08X}, address: {}",
-            it->second,
+            client_key,
             endpoint);
-        client_to_endpoint_map_.erase(it->second);
-        endpoint_to_client_map_.erase(it->first);
+        client_to_endpoint_map_.erase(client_key);
+        endpoint_to_client_map_.erase(EndPointKey<EndPoint>::pack(endpoint));
     }
 }
 
@@ -126,16 +271,19 @@ void SessionManager<EndPoint>::destroy_session(
 {
     std::lock_guard<std::mutex> lock(mtx_);
 
-    auto it = client_to_endpoint_map_.find(client_key);
-    if (it != client_to_endpoint_map_.end())
+    typename EndPointKey<EndPoint>::key key;
+    if (client_to_endpoint_map_.find(client_key, [&](const EndPoint& endpoint)
+        {
+            UXR_AGENT_LOG_INFO(
+                UXR_DECORATE_GREEN("session closed"),
+                "client_key: 0x{:08X}, address: {}",
+                client_key,
+                endpoint);
+            key = EndPointKey<EndPoint>::pack(endpoint);
+        }))
     {
-        UXR_AGENT_LOG_INFO(
-            UXR_DECORATE_GREEN("session closed"),
-            "client_key: 0x{:08X}, address: {}",
-            client_key,
-            it->second);
-        endpoint_to_client_map_.erase(it->second);
-        client_to_endpoint_map_.erase(it->first);
+        endpoint_to_client_map_.erase(key);
+        client_to_endpoint_map_.erase(client_key);
     }
 }
 
@@ -144,17 +292,7 @@ bool SessionManager<EndPoint>::get_client_key(
         const EndPoint& endpoint,
         uint32_t& client_key)
 {
-    bool rv = false;
-    std::lock_guard<std::mutex> lock(mtx_);
-
-    auto it = endpoint_to_client_map_.find(endpoint);
-    if (it != endpoint_to_client_map_.end())
-    {
-        client_key = it->second;
-        rv = true;
-    }
-
-    return rv;
+    return endpoint_to_client_map_.get(EndPointKey<EndPoint>::pack(endpoint), client_key);
 }
 
 template<typename EndPoint>
@@ -162,17 +300,7 @@ bool SessionManager<EndPoint>::get_endpoint(
         uint32_t client_key,
         EndPoint& endpoint)
 {
-    bool rv = false;
-    std::lock_guard<std::mutex> lock(mtx_);
-
-    auto it = client_to_endpoint_map_.find(client_key);
-    if (it != client_to_endpoint_map_.end())
-    {
-        endpoint = it->second;
-        rv = true;
-    }
-
-    return rv;
+    return client_to_endpoint_map_.get(client_key, endpoint);
 }
 
 } // namespace uxr
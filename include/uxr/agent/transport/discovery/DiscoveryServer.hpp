@@ -18,10 +18,13 @@
 #include <uxr/agent/message/Packet.hpp>
 #include <uxr/agent/transport/endpoint/IPv4EndPoint.hpp>
 #include <uxr/agent/transport/endpoint/IPv6EndPoint.hpp>
+#include <uxr/agent/utils/RateLimiter.hpp>
 
+#include <array>
 #include <thread>
 #include <atomic>
 #include <mutex>
+#include <vector>
 
 namespace eprosima {
 namespace uxr {
@@ -41,12 +44,27 @@ public:
     template<typename T>
     bool run(
             uint16_t discovery_port,
+            uint16_t agent_port,
             T&& transport_addresses);
 
     bool stop();
 
     void set_filter_port(uint16_t filter_port) { filter_port_ = filter_port; }
 
+protected:
+    /**
+     * Reply to a GET_INFO: its head holds the request message header, the INFO subheader and the related request,
+     * and it is followed by the cached INFO submessage from info_tail_offset on.
+     */
+    struct InfoReply
+    {
+        IPv4EndPoint destination;
+        std::array<uint8_t, 16> head;
+        size_t head_len;
+    };
+
+    static constexpr size_t info_tail_offset = 8;
+
 private:
     virtual bool init(
             uint16_t discovery_port) = 0;
@@ -57,8 +75,16 @@ private:
             InputPacket<IPv4EndPoint>& input_packet,
             int timeout) = 0;
 
-    virtual bool send_message(
-            OutputPacket<IPv4EndPoint>&& output_packet) = 0;
+    virtual bool send_replies(
+            const std::vector<InfoReply>& replies,
+            const std::vector<uint8_t>& info_submessage) = 0;
+
+    /* Gets the transport addresses again if the interfaces changed since the last call. */
+    virtual bool update_transport_addresses() = 0;
+
+    bool build_reply(
+            InputPacket<IPv4EndPoint>& input_packet,
+            InfoReply& reply) const;
 
     void discovery_loop();
 
@@ -67,6 +93,9 @@ private:
     std::thread thread_;
     std::atomic<bool> running_cond_;
     const Processor<EndPoint>& processor_;
+    std::vector<uint8_t> info_submessage_;
+    /* Keyed by source address and port. */
+    utils::RateLimiter<uint64_t> rate_limiter_;
 
 protected:
     std::vector<dds::xrce::TransportAddress> transport_addresses_;
@@ -80,10 +109,12 @@ template<typename T>
 inline
 bool DiscoveryServer<EndPoint>::run(
         uint16_t discovery_port,
+        uint16_t agent_port,
         T&& transport_addresses)
 {
     std::lock_guard<std::mutex> lock(mtx_);
 
+    agent_port_ = agent_port;
     transport_addresses_ = std::forward<T>(transport_addresses);
     if (running_cond_ || !init(discovery_port))
     {
@@ -22,6 +22,7 @@
 #include <atomic>
 #include <sys/poll.h>
 #include <type_traits>
+#include <vector>
 
 namespace eprosima {
 namespace uxr {
@@ -45,11 +46,18 @@ private:
             InputPacket<IPv4EndPoint>& input_packet,
             int timeout) final;
 
-    bool send_message(
-            OutputPacket<IPv4EndPoint>&& output_packet) final;
+    bool send_replies(
+            const std::vector<typename DiscoveryServer<EndPoint>::InfoReply>& replies,
+            const std::vector<uint8_t>& info_submessage) final;
+
+    bool update_transport_addresses() final;
 
 private:
     struct pollfd poll_fd_;
+
+    /* Netlink socket notified of the address changes. */
+    int netlink_fd_;
+    bool interfaces_changed_;
     uint8_t buffer_[128];
 };
 
@@ -45,8 +45,12 @@ private:
             InputPacket<IPv4EndPoint>& input_packet,
             int timeout) final;
 
-    bool send_message(
-            OutputPacket<IPv4EndPoint>&& output_packet) final;
+    bool send_replies(
+            const std::vector<typename DiscoveryServer<EndPoint>::InfoReply>& replies,
+            const std::vector<uint8_t>& info_submessage) final;
+
+    /* Interface changes are not tracked, the addresses found at start up are kept. */
+    bool update_transport_addresses() final { return false; }
 
 private:
     struct pollfd poll_fd_;
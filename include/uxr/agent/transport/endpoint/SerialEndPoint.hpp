@@ -16,6 +16,7 @@
 #define _UXR_AGENT_TRANSPORT_SERIAL_ENDPOINT_HPP_
 
 #include <stdint.h>
+#include <ostream>
 
 namespace eprosima {
 namespace uxr {
@@ -0,0 +1,116 @@
+// Copyright 2017 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef UXR_AGENT_TYPES_KEYLAYOUT_HPP_
+#define UXR_AGENT_TYPES_KEYLAYOUT_HPP_
+
+#include <cstdint>
+#include <cstdlib>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace eprosima {
+namespace uxr {
+
+/**
+ * Key member of a serialized (little endian CDR) sample, made of length bytes at offset from the start of the
+ * sample. Its elements of element_size bytes are put in big endian order to build the instance key.
+ */
+struct KeyMember
+{
+    uint32_t offset;
+    uint32_t length;
+    uint32_t element_size;
+};
+
+typedef std::vector<KeyMember> KeyLayout;
+
+/**
+ * Parses a "<type_name>=<offset>:<length>[:<element_size>],..." key layout specification.
+ */
+inline bool parse_key_layout(
+        const std::string& spec,
+        std::string& type_name,
+        KeyLayout& layout)
+{
+    bool rv = false;
+    const size_t separator = spec.rfind('=');
+    if ((std::string::npos != separator) && (0 < separator))
+    {
+        type_name = spec.substr(0, separator);
+        layout.clear();
+        rv = true;
+
+        std::istringstream members(spec.substr(separator + 1));
+        std::string member;
+        while (rv && std::getline(members, member, ','))
+        {
+            std::vector<unsigned long> fields;
+            std::istringstream values(member);
+            std::string value;
+            while (std::getline(values, value, ':'))
+            {
+                char* end = nullptr;
+                fields.push_back(std::strtoul(value.c_str(), &end, 10));
+                rv &= !value.empty() && ('\0' == *end);
+            }
+
+            rv &= (2 == fields.size()) || (3 == fields.size());
+            if (rv)
+            {
+                KeyMember key_member{
+                    uint32_t(fields[0]),
+                    uint32_t(fields[1]),
+                    (3 == fields.size()) ? uint32_t(fields[2]) : 1u};
+                rv = (0 < key_member.length) && (0 < key_member.element_size)
+                    && (0 == key_member.length % key_member.element_size);
+                layout.push_back(key_member);
+            }
+        }
+        rv &= !layout.empty();
+    }
+    return rv;
+}
+
+/**
+ * Builds the key of a serialized sample, false if the sample is too short for the layout.
+ */
+inline bool extract_key(
+        const uint8_t* data,
+        size_t size,
+        const KeyLayout& layout,
+        std::vector<uint8_t>& key)
+{
+    bool rv = true;
+    key.clear();
+    for (auto it = layout.begin(); rv && (it != layout.end()); ++it)
+    {
+        rv = (size >= it->offset) && (size - it->offset >= it->length);
+        for (uint32_t element = 0; rv && (element < it->length); element += it->element_size)
+        {
+            const uint8_t* first = data + it->offset + element;
+            key.insert(key.end(),
+                std::reverse_iterator<const uint8_t*>(first + it->element_size),
+                std::reverse_iterator<const uint8_t*>(first));
+        }
+    }
+    return rv;
+}
+
+} // namespace uxr
+} // namespace eprosima
+
+#endif // UXR_AGENT_TYPES_KEYLAYOUT_HPP_
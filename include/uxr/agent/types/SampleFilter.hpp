@@ -0,0 +1,275 @@
+// Copyright 2017 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef UXR_AGENT_TYPES_SAMPLEFILTER_HPP_
+#define UXR_AGENT_TYPES_SAMPLEFILTER_HPP_
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace eprosima {
+namespace uxr {
+
+/**
+ * Condition on a primitive member of a serialized (little endian CDR) sample, found at offset bytes
+ * from the start of the sample.
+ */
+struct FilterCondition
+{
+    enum Kind
+    {
+        UINT,
+        INT,
+        FLOAT
+    };
+
+    enum Operator
+    {
+        EQUAL,
+        NOT_EQUAL,
+        LESS,
+        LESS_EQUAL,
+        GREATER,
+        GREATER_EQUAL
+    };
+
+    uint32_t offset;
+    uint8_t size;
+    Kind kind;
+    Operator op;
+    uint64_t uint_value;
+    int64_t int_value;
+    double float_value;
+};
+
+/* Conditions that must all hold, an empty filter matches every sample. */
+typedef std::vector<FilterCondition> SampleFilter;
+
+namespace detail {
+
+inline bool parse_member(
+        const std::string& token,
+        FilterCondition& condition)
+{
+    struct MemberType
+    {
+        const char* name;
+        uint8_t size;
+        FilterCondition::Kind kind;
+    };
+    static const MemberType member_types[] = {
+        {"u8", 1, FilterCondition::UINT}, {"u16", 2, FilterCondition::UINT},
+        {"u32", 4, FilterCondition::UINT}, {"u64", 8, FilterCondition::UINT},
+        {"i8", 1, FilterCondition::INT}, {"i16", 2, FilterCondition::INT},
+        {"i32", 4, FilterCondition::INT}, {"i64", 8, FilterCondition::INT},
+        {"f32", 4, FilterCondition::FLOAT}, {"f64", 8, FilterCondition::FLOAT}};
+
+    bool rv = false;
+    const size_t separator = token.find(':');
+    if ((std::string::npos != separator) && (0 < separator))
+    {
+        char* end = nullptr;
+        condition.offset = uint32_t(std::strtoul(token.c_str(), &end, 10));
+        if (token.c_str() + separator == end)
+        {
+            const std::string type = token.substr(separator + 1);
+            for (const auto& member_type : member_types)
+            {
+                if (type == member_type.name)
+                {
+                    condition.size = member_type.size;
+                    condition.kind = member_type.kind;
+                    rv = true;
+                }
+            }
+        }
+    }
+    return rv;
+}
+
+inline bool parse_operator(
+        const std::string& token,
+        FilterCondition& condition)
+{
+    struct OperatorName
+    {
+        const char* name;
+        FilterCondition::Operator op;
+    };
+    static const OperatorName operator_names[] = {
+        {"=", FilterCondition::EQUAL}, {"<>", FilterCondition::NOT_EQUAL},
+        {"<", FilterCondition::LESS}, {"<=", FilterCondition::LESS_EQUAL},
+        {">", FilterCondition::GREATER}, {">=", FilterCondition::GREATER_EQUAL}};
+
+    bool rv = false;
+    for (const auto& operator_name : operator_names)
+    {
+        if (token == operator_name.name)
+        {
+            condition.op = operator_name.op;
+            rv = true;
+        }
+    }
+    return rv;
+}
+
+inline bool parse_value(
+        const std::string& token,
+        FilterCondition& condition)
+{
+    char* end = nullptr;
+    switch (condition.kind)
+    {
+        case FilterCondition::UINT:
+            condition.uint_value = std::strtoull(token.c_str(), &end, 0);
+            break;
+        case FilterCondition::INT:
+            condition.int_value = std::strtoll(token.c_str(), &end, 0);
+            break;
+        case FilterCondition::FLOAT:
+            condition.float_value = std::strtod(token.c_str(), &end);
+            break;
+    }
+    return !token.empty() && ('\0' == *end);
+}
+
+template<typename T>
+inline bool compare(
+        T lhs,
+        FilterCondition::Operator op,
+        T rhs)
+{
+    bool rv = false;
+    switch (op)
+    {
+        case FilterCondition::EQUAL:
+            rv = (lhs == rhs);
+            break;
+        case FilterCondition::NOT_EQUAL:
+            rv = (lhs != rhs);
+            break;
+        case FilterCondition::LESS:
+            rv = (lhs < rhs);
+            break;
+        case FilterCondition::LESS_EQUAL:
+            rv = (lhs <= rhs);
+            break;
+        case FilterCondition::GREATER:
+            rv = (lhs > rhs);
+            break;
+        case FilterCondition::GREATER_EQUAL:
+            rv = (lhs >= rhs);
+            break;
+    }
+    return rv;
+}
+
+} // namespace detail
+
+/**
+ * Parses a "<offset>:<type> <operator> <value> [AND ...]" filter expression, where type is one of
+ * u8, u16, u32, u64, i8, i16, i32, i64, f32 or f64 and operator one of =, <>, <, <=, > or >=.
+ */
+inline bool parse_sample_filter(
+        const std::string& expression,
+        SampleFilter& filter)
+{
+    bool rv = true;
+    filter.clear();
+
+    std::istringstream tokens(expression);
+    std::string member;
+    while (rv && (tokens >> member))
+    {
+        if (!filter.empty())
+        {
+            rv = ("AND" == member) && (tokens >> member);
+        }
+
+        std::string op;
+        std::string value;
+        FilterCondition condition{};
+        rv = rv && (tokens >> op) && (tokens >> value)
+            && detail::parse_member(member, condition)
+            && detail::parse_operator(op, condition)
+            && detail::parse_value(value, condition);
+        filter.push_back(condition);
+    }
+    return rv;
+}
+
+/**
+ * Evaluates the filter on a serialized sample, which does not match if it is too short for any condition.
+ */
+inline bool match_sample_filter(
+        const uint8_t* data,
+        size_t size,
+        const SampleFilter& filter)
+{
+    bool rv = true;
+    for (auto it = filter.begin(); rv && (it != filter.end()); ++it)
+    {
+        rv = (size >= it->offset) && (size - it->offset >= it->size);
+        if (rv)
+        {
+            uint64_t raw = 0;
+            for (uint8_t i = 0; i < it->size; ++i)
+            {
+                raw |= uint64_t(data[it->offset + i]) << (8 * i);
+            }
+
+            switch (it->kind)
+            {
+                case FilterCondition::UINT:
+                    rv = detail::compare(raw, it->op, it->uint_value);
+                    break;
+                case FilterCondition::INT:
+                {
+                    /* Sign extension of the narrower members. */
+                    const unsigned shift = 64u - 8u * it->size;
+                    const int64_t value = int64_t(raw << shift) >> shift;
+                    rv = detail::compare(value, it->op, it->int_value);
+                    break;
+                }
+                case FilterCondition::FLOAT:
+                {
+                    double value = 0.0;
+                    if (4 == it->size)
+                    {
+                        float narrow = 0.0f;
+                        const uint32_t raw32 = uint32_t(raw);
+                        std::memcpy(&narrow, &raw32, sizeof(narrow));
+                        value = narrow;
+                    }
+                    else
+                    {
+                        std::memcpy(&value, &raw, sizeof(value));
+                    }
+                    rv = detail::compare(value, it->op, it->float_value);
+                    break;
+                }
+            }
+        }
+    }
+    return rv;
+}
+
+} // namespace uxr
+} // namespace eprosima
+
+#endif // UXR_AGENT_TYPES_SAMPLEFILTER_HPP_
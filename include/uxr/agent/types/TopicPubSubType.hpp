@@ -16,7 +16,11 @@
 #define _UXR_AGENT_TYPES_TOPICPUBSUBTYPES_HPP_
 
 #include <fastrtps/TopicDataType.h>
+#include <uxr/agent/types/KeyLayout.hpp>
 
+#include <memory>
+#include <mutex>
+#include <string>
 #include <vector>
 
 using namespace eprosima::fastrtps;
@@ -28,14 +32,48 @@ class TopicPubSubType: public TopicDataType
 public:
     typedef std::vector<unsigned char> type;
 
-    explicit TopicPubSubType(bool with_key);
+    /* Samples larger than a non-zero max_sample_size are not serialized. */
+    explicit TopicPubSubType(
+            bool with_key,
+            uint32_t max_sample_size = 0);
     ~TopicPubSubType() override = default;
+    bool is_bounded() const override;
     bool serialize(void* data, rtps::SerializedPayload_t* payload) override;
     bool deserialize(rtps::SerializedPayload_t* payload, void* data) override;
     std::function<uint32_t()> getSerializedSizeProvider(void* data) override;
     bool getKey(void* data, rtps::InstanceHandle_t* ihandle, bool force_md5 = false) override;
     void* createData() override;
     void deleteData(void* data) override;
+
+    /* Key layout of the keyed topics of a type, to be set before the type is used. */
+    static void set_key_layout(
+            const std::string& type_name,
+            const KeyLayout& layout);
+
+    static std::shared_ptr<const KeyLayout> find_key_layout(
+            const std::string& type_name);
+
+    /* Leaves room in front of the samples deserialized by the calling thread while it lives. */
+    class Headroom
+    {
+    public:
+        explicit Headroom(
+                size_t size);
+
+        ~Headroom();
+
+        Headroom(const Headroom&) = delete;
+        Headroom& operator=(const Headroom&) = delete;
+
+    private:
+        size_t previous_size_;
+    };
+
+private:
+
+    const uint32_t max_sample_size_;
+    std::once_flag key_layout_flag_;
+    std::shared_ptr<const KeyLayout> key_layout_;
 };
 
 } // namespace uxr
@@ -474,6 +474,17 @@ public:
         , refs_("-r", "--refs")
         , verbose_("-v", "--verbose", static_cast<uint16_t>(DEFAULT_VERBOSE_LEVEL),
             {0, 1, 2, 3, 4, 5, 6})
+        , async_publish_("-a", "--async-publish", ArgumentKind::NO_VALUE)
+        , flow_max_bytes_("-B", "--flow-max-bytes", static_cast<uint32_t>(0), {}, false)
+        , flow_period_("-F", "--flow-period", static_cast<uint32_t>(100), {}, false)
+        , flow_scheduler_("-S", "--flow-scheduler", std::string("fifo"),
+            {"fifo", "round-robin", "high-priority", "priority-reservation"})
+        , shm_segment_size_("-M", "--shm-segment-size", static_cast<uint32_t>(1024 * 1024), {}, false)
+        , data_sharing_("-Z", "--data-sharing-max-size", static_cast<uint32_t>(1024), {}, false)
+        , key_layout_("-k", "--key-layout")
+        , ced_history_("-H", "--ced-history")
+        , ced_shm_("-C", "--ced-shm", static_cast<uint32_t>(4096), {}, false)
+        , link_rate_("-L", "--link-rate", static_cast<uint32_t>(0), {}, false)
 #if defined(UAGENT_RESTRICT) || defined(UAGENT_PROTECT)
         , topic_("-t", "--topic")
 #endif
@@ -536,6 +547,20 @@ public:
             result.first = false;
             return result;
         }
+        if ((ParseResult::INVALID == async_publish_.parse_argument(argc, argv)) ||
+            (ParseResult::INVALID == flow_max_bytes_.parse_argument(argc, argv)) ||
+            (ParseResult::INVALID == flow_period_.parse_argument(argc, argv)) ||
+            (ParseResult::INVALID == flow_scheduler_.parse_argument(argc, argv)) ||
+            (ParseResult::INVALID == shm_segment_size_.parse_argument(argc, argv)) ||
+            (ParseResult::INVALID == data_sharing_.parse_argument(argc, argv)) ||
+            (ParseResult::INVALID == key_layout_.parse_argument(argc, argv)) ||
+            (ParseResult::INVALID == ced_history_.parse_argument(argc, argv)) ||
+            (ParseResult::INVALID == ced_shm_.parse_argument(argc, argv)) ||
+            (ParseResult::INVALID == link_rate_.parse_argument(argc, argv)))
+        {
+            result.first = false;
+            return result;
+        }
 #if defined(UAGENT_RESTRICT) || defined(UAGENT_PROTECT)
         ParseResult topic = topic_.parse_argument(argc, argv);
         if (ParseResult::VALID == topic)
@@ -631,6 +656,79 @@ public:
         {
             server->set_verbose_level(verbose_.value());
         }
+        if (async_publish_.found())
+        {
+            if (!server->enable_async_publishing(
+                    static_cast<int32_t>(flow_max_bytes_.value()), flow_period_.value(), flow_scheduler_.value()))
+            {
+                UXR_AGENT_LOG_WARN(
+                        UXR_DECORATE_YELLOW("Asynchronous publishing error"),
+                        "Not supported by the middleware or invalid flow controller",
+                        "");
+            }
+        }
+        if (shm_segment_size_.found())
+        {
+            if (!server->enable_shared_memory(shm_segment_size_.value()))
+            {
+                UXR_AGENT_LOG_WARN(
+                        UXR_DECORATE_YELLOW("Shared memory transport error"),
+                        "Not supported by the middleware or invalid segment size",
+                        "");
+            }
+        }
+        if (data_sharing_.found())
+        {
+            if (!server->enable_data_sharing(data_sharing_.value()))
+            {
+                UXR_AGENT_LOG_WARN(
+                        UXR_DECORATE_YELLOW("Data-sharing error"),
+                        "Not supported by the middleware or invalid sample size",
+                        "");
+            }
+        }
+        if (key_layout_.found())
+        {
+            if (!server->set_key_layout(key_layout_.value()))
+            {
+                UXR_AGENT_LOG_WARN(
+                        UXR_DECORATE_YELLOW("Key layout error"),
+                        "Not supported by the middleware or invalid layout: {}",
+                        key_layout_.value());
+            }
+        }
+        if (ced_history_.found())
+        {
+            /* "<topic_name>=<depth>", or just "<depth>" for every topic. */
+            const std::string& spec = ced_history_.value();
+            const size_t separator = spec.rfind('=');
+            const std::string topic_name = (std::string::npos == separator) ? std::string() : spec.substr(0, separator);
+            const std::string depth = (std::string::npos == separator) ? spec : spec.substr(separator + 1);
+            char* end = nullptr;
+            const unsigned long value = std::strtoul(depth.c_str(), &end, 10);
+            if (depth.empty() || ('\0' != *end) || (UINT16_MAX < value) ||
+                !server->set_ced_history_depth(topic_name, static_cast<uint16_t>(value)))
+            {
+                UXR_AGENT_LOG_WARN(
+                        UXR_DECORATE_YELLOW("CED history error"),
+                        "Not supported by the middleware or invalid depth: {}",
+                        spec);
+            }
+        }
+        if (ced_shm_.found())
+        {
+            if (!server->enable_ced_shared_memory(ced_shm_.value()))
+            {
+                UXR_AGENT_LOG_WARN(
+                        UXR_DECORATE_YELLOW("CED shared memory error"),
+                        "Not supported by the middleware or the platform",
+                        "");
+            }
+        }
+        if (link_rate_.found())
+        {
+            server->set_link_rate(link_rate_.value());
+        }
     }
 
     const std::string get_help() const
@@ -640,6 +738,16 @@ public:
         ss << "    " << middleware_.get_help() << std::endl;
         ss << "    " << refs_.get_help() << std::endl;
         ss << "    " << verbose_.get_help() << std::endl;
+        ss << "    " << async_publish_.get_help() << std::endl;
+        ss << "    " << flow_max_bytes_.get_help() << std::endl;
+        ss << "    " << flow_period_.get_help() << std::endl;
+        ss << "    " << flow_scheduler_.get_help() << std::endl;
+        ss << "    " << shm_segment_size_.get_help() << std::endl;
+        ss << "    " << data_sharing_.get_help() << std::endl;
+        ss << "    " << key_layout_.get_help() << std::endl;
+        ss << "    " << ced_history_.get_help() << std::endl;
+        ss << "    " << ced_shm_.get_help() << std::endl;
+        ss << "    " << link_rate_.get_help() << std::endl;
 #ifdef UAGENT_DISCOVERY_PROFILE
         ss << "    " << discovery_.get_help() << std::endl;
 #endif
@@ -654,6 +762,16 @@ private:
     Argument<std::string> middleware_;
     Argument<std::string> refs_;
     Argument<uint8_t> verbose_;
+    Argument<dummy_type> async_publish_;
+    Argument<uint32_t> flow_max_bytes_;
+    Argument<uint32_t> flow_period_;
+    Argument<std::string> flow_scheduler_;
+    Argument<uint32_t> shm_segment_size_;
+    Argument<uint32_t> data_sharing_;
+    Argument<std::string> key_layout_;
+    Argument<std::string> ced_history_;
+    Argument<uint32_t> ced_shm_;
+    Argument<uint32_t> link_rate_;
 #if defined(UAGENT_RESTRICT) || defined(UAGENT_PROTECT)
     Argument<std::string> topic_;
 #endif
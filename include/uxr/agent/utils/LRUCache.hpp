@@ -0,0 +1,137 @@
+// Copyright 2017 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef UXR_AGENT_UTILS_LRUCACHE_HPP_
+#define UXR_AGENT_UTILS_LRUCACHE_HPP_
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+namespace eprosima {
+namespace uxr {
+namespace utils {
+
+/**
+ * Thread-safe, bounded cache of immutable values, evicting the least recently used entry.
+ */
+template<typename Key, typename Value>
+class LRUCache
+{
+public:
+    explicit LRUCache(
+            size_t capacity);
+
+    LRUCache(LRUCache&&) = delete;
+    LRUCache(const LRUCache&) = delete;
+    LRUCache& operator=(LRUCache&&) = delete;
+    LRUCache& operator=(const LRUCache&) = delete;
+
+    std::shared_ptr<const Value> get(
+            const Key& key);
+
+    void put(
+            const Key& key,
+            std::shared_ptr<const Value> value);
+
+    void clear();
+
+    size_t get_capacity() const { return capacity_; }
+    size_t get_size();
+
+private:
+    typedef std::list<std::pair<Key, std::shared_ptr<const Value>>> Entries;
+
+    const size_t capacity_;
+    std::mutex mtx_;
+    Entries entries_;
+    std::unordered_map<Key, typename Entries::iterator> index_;
+};
+
+template<typename Key, typename Value>
+inline LRUCache<Key, Value>::LRUCache(
+        size_t capacity)
+    : capacity_(capacity)
+    , mtx_{}
+    , entries_{}
+    , index_{}
+{
+}
+
+template<typename Key, typename Value>
+inline std::shared_ptr<const Value> LRUCache<Key, Value>::get(
+        const Key& key)
+{
+    std::shared_ptr<const Value> rv;
+    std::lock_guard<std::mutex> lock(mtx_);
+    auto it = index_.find(key);
+    if (index_.end() != it)
+    {
+        entries_.splice(entries_.begin(), entries_, it->second);
+        rv = it->second->second;
+    }
+    return rv;
+}
+
+template<typename Key, typename Value>
+inline void LRUCache<Key, Value>::put(
+        const Key& key,
+        std::shared_ptr<const Value> value)
+{
+    if (0 == capacity_)
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mtx_);
+    auto it = index_.find(key);
+    if (index_.end() != it)
+    {
+        it->second->second = std::move(value);
+        entries_.splice(entries_.begin(), entries_, it->second);
+    }
+    else
+    {
+        if (entries_.size() >= capacity_)
+        {
+            index_.erase(entries_.back().first);
+            entries_.pop_back();
+        }
+        entries_.emplace_front(key, std::move(value));
+        index_.emplace(key, entries_.begin());
+    }
+}
+
+template<typename Key, typename Value>
+inline void LRUCache<Key, Value>::clear()
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    index_.clear();
+    entries_.clear();
+}
+
+template<typename Key, typename Value>
+inline size_t LRUCache<Key, Value>::get_size()
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    return entries_.size();
+}
+
+} // namespace utils
+} // namespace uxr
+} // namespace eprosima
+
+#endif // UXR_AGENT_UTILS_LRUCACHE_HPP_
@@ -0,0 +1,124 @@
+// Copyright 2017 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef UXR_AGENT_UTILS_PACER_HPP_
+#define UXR_AGENT_UTILS_PACER_HPP_
+
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+
+namespace eprosima {
+namespace uxr {
+namespace utils {
+
+/**
+ * Non-blocking byte rate meter. It tracks the time at which the bytes accounted so far are drained
+ * at the given rate, and the next sender is eligible once less than burst bytes are left to drain.
+ * Callers are told when to come back instead of being put to sleep. A zero rate does not limit.
+ */
+class Pacer
+{
+public:
+    typedef std::chrono::steady_clock::time_point TimePoint;
+
+    explicit Pacer(
+            size_t rate = 0,
+            size_t burst = 0);
+
+    Pacer(Pacer&&) = delete;
+    Pacer(const Pacer&) = delete;
+    Pacer& operator=(Pacer&&) = delete;
+    Pacer& operator=(const Pacer&) = delete;
+
+    /* Changes the rate (bytes per second) and forgets the bytes accounted so far. */
+    void reset(
+            size_t rate,
+            size_t burst = 0);
+
+    /* When the next sender may go, now if it already may. */
+    TimePoint get_eligible_time(
+            TimePoint now = std::chrono::steady_clock::now());
+
+    /* Accounts bytes sent, even if not eligible, so that mandatory traffic delays the next senders. */
+    void consume(
+            size_t bytes,
+            TimePoint now = std::chrono::steady_clock::now());
+
+    size_t get_rate() const { return rate_; }
+
+private:
+    std::chrono::nanoseconds get_drain_time(
+            size_t bytes) const;
+
+private:
+    std::mutex mtx_;
+    size_t rate_;
+    std::chrono::nanoseconds tolerance_;
+    TimePoint drain_time_;
+};
+
+inline Pacer::Pacer(
+        size_t rate,
+        size_t burst)
+    : mtx_{}
+    , rate_(0)
+    , tolerance_(0)
+    , drain_time_{}
+{
+    reset(rate, burst);
+}
+
+inline void Pacer::reset(
+        size_t rate,
+        size_t burst)
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    rate_ = rate;
+    tolerance_ = get_drain_time(burst);
+    drain_time_ = TimePoint{};
+}
+
+inline std::chrono::nanoseconds Pacer::get_drain_time(
+        size_t bytes) const
+{
+    using namespace std::chrono;
+    return (0 == rate_)
+        ? nanoseconds(0)
+        : nanoseconds(uint64_t((double(bytes) * std::nano::den) / rate_));
+}
+
+inline Pacer::TimePoint Pacer::get_eligible_time(
+        TimePoint now)
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    return (0 == rate_) ? now : std::max(now, drain_time_ - tolerance_);
+}
+
+inline void Pacer::consume(
+        size_t bytes,
+        TimePoint now)
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    if (0 != rate_)
+    {
+        drain_time_ = std::max(drain_time_, now) + get_drain_time(bytes);
+    }
+}
+
+} // namespace utils
+} // namespace uxr
+} // namespace eprosima
+
+#endif // UXR_AGENT_UTILS_PACER_HPP_
@@ -0,0 +1,121 @@
+// Copyright 2017 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef UXR_AGENT_UTILS_RATELIMITER_HPP_
+#define UXR_AGENT_UTILS_RATELIMITER_HPP_
+
+#include <algorithm>
+#include <chrono>
+#include <unordered_map>
+
+namespace eprosima {
+namespace uxr {
+namespace utils {
+
+/**
+ * Non-blocking rate limit per source: up to burst events at once, then one every 1/rate seconds.
+ * Each source is tracked by the time its bucket would be full again (generic cell rate algorithm),
+ * and sources whose bucket is full are forgotten to make room for new ones. Not thread-safe.
+ */
+template<typename Key>
+class RateLimiter
+{
+public:
+    RateLimiter(
+            size_t rate,
+            size_t burst,
+            size_t max_sources);
+
+    RateLimiter(RateLimiter&&) = delete;
+    RateLimiter(const RateLimiter&) = delete;
+    RateLimiter& operator=(RateLimiter&&) = delete;
+    RateLimiter& operator=(const RateLimiter&) = delete;
+
+    /* Accounts an event of the source, false if it goes over the limit. */
+    bool consume(
+            const Key& key,
+            std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now());
+
+    size_t get_size() const { return sources_.size(); }
+
+private:
+    void prune(
+            std::chrono::steady_clock::time_point now);
+
+private:
+    const std::chrono::nanoseconds interval_;
+    const std::chrono::nanoseconds tolerance_;
+    const size_t max_sources_;
+    std::unordered_map<Key, std::chrono::steady_clock::time_point> sources_;
+};
+
+template<typename Key>
+inline RateLimiter<Key>::RateLimiter(
+        size_t rate,
+        size_t burst,
+        size_t max_sources)
+    : interval_(std::chrono::nanoseconds(std::chrono::seconds(1)) / std::max(rate, size_t(1)))
+    , tolerance_(interval_ * (std::max(burst, size_t(1)) - 1))
+    , max_sources_(max_sources)
+    , sources_{}
+{
+}
+
+template<typename Key>
+inline bool RateLimiter<Key>::consume(
+        const Key& key,
+        std::chrono::steady_clock::time_point now)
+{
+    bool rv = true;
+    auto it = sources_.find(key);
+    if (sources_.end() == it)
+    {
+        if (sources_.size() >= max_sources_)
+        {
+            prune(now);
+        }
+
+        /* Too many active sources to track, the new one is not limited. */
+        if (sources_.size() < max_sources_)
+        {
+            sources_.emplace(key, now + interval_);
+        }
+    }
+    else
+    {
+        const std::chrono::steady_clock::time_point full_time = std::max(it->second, now);
+        rv = (full_time - now <= tolerance_);
+        if (rv)
+        {
+            it->second = full_time + interval_;
+        }
+    }
+    return rv;
+}
+
+template<typename Key>
+inline void RateLimiter<Key>::prune(
+        std::chrono::steady_clock::time_point now)
+{
+    for (auto it = sources_.begin(); it != sources_.end();)
+    {
+        it = (it->second <= now) ? sources_.erase(it) : std::next(it);
+    }
+}
+
+} // namespace utils
+} // namespace uxr
+} // namespace eprosima
+
+#endif // UXR_AGENT_UTILS_RATELIMITER_HPP_
@@ -0,0 +1,332 @@
+// Copyright 2017 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef UXR_AGENT_UTILS_RCUMAP_HPP_
+#define UXR_AGENT_UTILS_RCUMAP_HPP_
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <thread>
+#include <utility>
+
+namespace eprosima {
+namespace uxr {
+namespace utils {
+
+/**
+ * Hash map for read-mostly lookups. Readers take no lock and touch no reference count: they announce
+ * themselves in a per-thread stripe of the current epoch and walk immutable nodes. Writers link new
+ * nodes in place and, before freeing the ones they unlinked, flip the epoch and wait for the readers
+ * of the previous one. Writers must be serialized by the caller, and must not run from within fn.
+ */
+template<typename Key, typename Value, typename Hash = std::hash<Key>, size_t Buckets = 256>
+class RcuMap
+{
+public:
+    RcuMap();
+    ~RcuMap();
+
+    RcuMap(RcuMap&&) = delete;
+    RcuMap(const RcuMap&) = delete;
+    RcuMap& operator=(RcuMap&&) = delete;
+    RcuMap& operator=(const RcuMap&) = delete;
+
+    /* Runs fn on the value of the key, if any, which stays alive meanwhile. */
+    template<typename Fn>
+    bool find(
+            const Key& key,
+            Fn&& fn) const;
+
+    bool get(
+            const Key& key,
+            Value& value) const;
+
+    /* Runs fn on every value, those inserted or erased meanwhile may be skipped. */
+    template<typename Fn>
+    void for_each(
+            Fn&& fn) const;
+
+    /* Inserts the value or replaces the current one. */
+    void assign(
+            const Key& key,
+            const Value& value);
+
+    bool erase(
+            const Key& key);
+
+    void clear();
+
+private:
+    struct Node
+    {
+        Node(
+                const Key& key_,
+                const Value& value_,
+                Node* next_)
+            : key(key_)
+            , value(value_)
+            , next(next_)
+        {}
+
+        const Key key;
+        const Value value;
+        std::atomic<Node*> next;
+    };
+
+    /* One cache line per stripe, so that readers of different threads do not share counters. */
+    struct ReaderStripe
+    {
+        std::array<std::atomic<uint32_t>, 2> count;
+        char padding[64 - 2 * sizeof(std::atomic<uint32_t>)];
+    };
+
+    static constexpr size_t reader_stripes = 8;
+
+    class ReadGuard
+    {
+    public:
+        explicit ReadGuard(
+                const RcuMap& map);
+        ~ReadGuard();
+
+        ReadGuard(ReadGuard&&) = delete;
+        ReadGuard(const ReadGuard&) = delete;
+        ReadGuard& operator=(ReadGuard&&) = delete;
+        ReadGuard& operator=(const ReadGuard&) = delete;
+
+    private:
+        std::atomic<uint32_t>* count_;
+    };
+
+    std::atomic<Node*>& get_bucket(
+            const Key& key);
+
+    const std::atomic<Node*>& get_bucket(
+            const Key& key) const;
+
+    /* Waits until no reader may still hold the nodes unlinked so far. */
+    void synchronize();
+
+private:
+    std::array<std::atomic<Node*>, Buckets> buckets_;
+    mutable std::array<ReaderStripe, reader_stripes> readers_;
+    std::atomic<uint32_t> epoch_;
+};
+
+template<typename Key, typename Value, typename Hash, size_t Buckets>
+constexpr size_t RcuMap<Key, Value, Hash, Buckets>::reader_stripes;
+
+template<typename Key, typename Value, typename Hash, size_t Buckets>
+inline RcuMap<Key, Value, Hash, Buckets>::ReadGuard::ReadGuard(
+        const RcuMap& map)
+    : count_(nullptr)
+{
+    static thread_local const size_t stripe = std::hash<std::thread::id>()(std::this_thread::get_id()) % reader_stripes;
+
+    /* Counted in the epoch it still is once counted, so that a writer flipping it meanwhile waits for us. */
+    for (;;)
+    {
+        const uint32_t epoch = map.epoch_.load();
+        count_ = &map.readers_[stripe].count[epoch & 1];
+        count_->fetch_add(1);
+        if (epoch == map.epoch_.load())
+        {
+            break;
+        }
+        count_->fetch_sub(1);
+    }
+}
+
+template<typename Key, typename Value, typename Hash, size_t Buckets>
+inline RcuMap<Key, Value, Hash, Buckets>::ReadGuard::~ReadGuard()
+{
+    count_->fetch_sub(1);
+}
+
+template<typename Key, typename Value, typename Hash, size_t Buckets>
+inline RcuMap<Key, Value, Hash, Buckets>::RcuMap()
+    : buckets_{}
+    , readers_{}
+    , epoch_{0}
+{
+    for (auto& bucket : buckets_)
+    {
+        bucket.store(nullptr);
+    }
+    for (auto& stripe : readers_)
+    {
+        stripe.count[0].store(0);
+        stripe.count[1].store(0);
+    }
+}
+
+template<typename Key, typename Value, typename Hash, size_t Buckets>
+inline RcuMap<Key, Value, Hash, Buckets>::~RcuMap()
+{
+    clear();
+}
+
+template<typename Key, typename Value, typename Hash, size_t Buckets>
+inline std::atomic<typename RcuMap<Key, Value, Hash, Buckets>::Node*>& RcuMap<Key, Value, Hash, Buckets>::get_bucket(
+        const Key& key)
+{
+    return buckets_[Hash()(key) % Buckets];
+}
+
+template<typename Key, typename Value, typename Hash, size_t Buckets>
+inline const std::atomic<typename RcuMap<Key, Value, Hash, Buckets>::Node*>& RcuMap<Key, Value, Hash, Buckets>::get_bucket(
+        const Key& key) const
+{
+    return buckets_[Hash()(key) % Buckets];
+}
+
+template<typename Key, typename Value, typename Hash, size_t Buckets>
+template<typename Fn>
+inline bool RcuMap<Key, Value, Hash, Buckets>::find(
+        const Key& key,
+        Fn&& fn) const
+{
+    bool rv = false;
+    ReadGuard guard(*this);
+    for (const Node* node = get_bucket(key).load(std::memory_order_acquire);
+         !rv && (nullptr != node);
+         node = node->next.load(std::memory_order_acquire))
+    {
+        if (node->key == key)
+        {
+            fn(node->value);
+            rv = true;
+        }
+    }
+    return rv;
+}
+
+template<typename Key, typename Value, typename Hash, size_t Buckets>
+inline bool RcuMap<Key, Value, Hash, Buckets>::get(
+        const Key& key,
+        Value& value) const
+{
+    return find(key, [&](const Value& found){ value = found; });
+}
+
+template<typename Key, typename Value, typename Hash, size_t Buckets>
+template<typename Fn>
+inline void RcuMap<Key, Value, Hash, Buckets>::for_each(
+        Fn&& fn) const
+{
+    ReadGuard guard(*this);
+    for (const auto& bucket : buckets_)
+    {
+        for (const Node* node = bucket.load(std::memory_order_acquire);
+             nullptr != node;
+             node = node->next.load(std::memory_order_acquire))
+        {
+            fn(node->value);
+        }
+    }
+}
+
+template<typename Key, typename Value, typename Hash, size_t Buckets>
+inline void RcuMap<Key, Value, Hash, Buckets>::assign(
+        const Key& key,
+        const Value& value)
+{
+    std::atomic<Node*>* link = &get_bucket(key);
+    Node* node = link->load();
+    while ((nullptr != node) && !(node->key == key))
+    {
+        link = &node->next;
+        node = link->load();
+    }
+
+    if (nullptr == node)
+    {
+        /* Readers see the whole node or none. */
+        std::atomic<Node*>& bucket = get_bucket(key);
+        bucket.store(new Node(key, value, bucket.load()), std::memory_order_release);
+    }
+    else
+    {
+        /* Readers already on the old node keep walking from it. */
+        link->store(new Node(key, value, node->next.load()), std::memory_order_release);
+        synchronize();
+        delete node;
+    }
+}
+
+template<typename Key, typename Value, typename Hash, size_t Buckets>
+inline bool RcuMap<Key, Value, Hash, Buckets>::erase(
+        const Key& key)
+{
+    bool rv = false;
+    std::atomic<Node*>* link = &get_bucket(key);
+    Node* node = link->load();
+    while ((nullptr != node) && !(node->key == key))
+    {
+        link = &node->next;
+        node = link->load();
+    }
+
+    if (nullptr != node)
+    {
+        link->store(node->next.load(), std::memory_order_release);
+        synchronize();
+        delete node;
+        rv = true;
+    }
+    return rv;
+}
+
+template<typename Key, typename Value, typename Hash, size_t Buckets>
+inline void RcuMap<Key, Value, Hash, Buckets>::clear()
+{
+    std::array<Node*, Buckets> unlinked;
+    for (size_t i = 0; i < Buckets; ++i)
+    {
+        unlinked[i] = buckets_[i].exchange(nullptr);
+    }
+    synchronize();
+
+    for (Node* node : unlinked)
+    {
+        while (nullptr != node)
+        {
+            Node* next = node->next.load();
+            delete node;
+            node = next;
+        }
+    }
+}
+
+template<typename Key, typename Value, typename Hash, size_t Buckets>
+inline void RcuMap<Key, Value, Hash, Buckets>::synchronize()
+{
+    /* New readers go to the other counters, so that those of the previous epoch only decrease. */
+    const uint32_t epoch = epoch_.fetch_add(1);
+    for (auto& stripe : readers_)
+    {
+        while (0 != stripe.count[epoch & 1].load())
+        {
+            std::this_thread::yield();
+        }
+    }
+}
+
+} // namespace utils
+} // namespace uxr
+} // namespace eprosima
+
+#endif // UXR_AGENT_UTILS_RCUMAP_HPP_
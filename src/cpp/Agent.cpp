@@ -530,6 +530,51 @@ bool Agent::load_config_file(const std::string& file_path)
     return root_->load_config_file(file_path);
 }
 
+bool Agent::enable_async_publishing(
+        int32_t max_bytes_per_period,
+        uint64_t period_ms,
+        const std::string& scheduler)
+{
+    return root_->enable_async_publishing(max_bytes_per_period, period_ms, scheduler);
+}
+
+bool Agent::enable_shared_memory(
+        uint32_t segment_size)
+{
+    return root_->enable_shared_memory(segment_size);
+}
+
+bool Agent::enable_data_sharing(
+        uint32_t max_sample_size)
+{
+    return root_->enable_data_sharing(max_sample_size);
+}
+
+bool Agent::set_key_layout(
+        const std::string& key_layout)
+{
+    return root_->set_key_layout(key_layout);
+}
+
+bool Agent::set_ced_history_depth(
+        const std::string& topic_name,
+        uint16_t depth)
+{
+    return root_->set_ced_history_depth(topic_name, depth);
+}
+
+bool Agent::enable_ced_shared_memory(
+        uint32_t max_sample_size)
+{
+    return root_->enable_ced_shared_memory(max_sample_size);
+}
+
+void Agent::set_link_rate(
+        uint32_t link_rate)
+{
+    root_->set_link_rate(link_rate);
+}
+
 void Agent::set_verbose_level(uint8_t verbose_level)
 {
     root_->set_verbose_level(verbose_level);
@@ -550,8 +595,7 @@ bool Agent::write(
     if (std::shared_ptr<ProxyClient> client = root_->get_client(conversion::raw_to_clientkey(client_key)))
     {
         dds::xrce::ObjectId object_id = conversion::raw_to_objectid(datawriter_id, dds::xrce::OBJK_DATAWRITER);
-        std::shared_ptr<DataWriter> datawriter = std::dynamic_pointer_cast<DataWriter>(client->get_object(object_id));
-        if (datawriter)
+        if (ProxyClient::Handle<DataWriter> datawriter = client->get_handle<DataWriter>(object_id))
         {
             std::vector<uint8_t> data(buf, buf + len);
             rv = datawriter->write(data);
@@ -20,6 +20,12 @@
 #ifdef UAGENT_FAST_PROFILE
 // TODO (#5047): replace Fast RTPS dependency by XML parser library.
 #include <fastrtps/xmlparser/XMLProfileManager.h>
+#include <uxr/agent/middleware/fastdds/FastDDSEntities.hpp>
+#include <uxr/agent/types/TopicPubSubType.hpp>
+#endif
+
+#ifdef UAGENT_CED_PROFILE
+#include <uxr/agent/middleware/ced/CedEntities.hpp>
 #endif
 
 #include <memory>
@@ -31,11 +37,12 @@ namespace eprosima {
 namespace uxr {
 
 Root::Root()
-    : mtx_(),
-      clients_(),
-      current_client_()
+    : clients_(),
+      mtx_(),
+      iteration_mtx_(),
+      current_clients_(),
+      current_client_(0)
 {
-    current_client_ = clients_.begin();
 #ifdef UAGENT_LOGGER_PROFILE
     spdlog::set_level(spdlog::level::info);
     spdlog::set_pattern(UXR_LOG_PATTERN);
@@ -45,11 +52,14 @@ Root::Root()
 /* It must be here instead of the hpp because the forward declaration of Middleware in the hpp. */
 Root::~Root()
 {
-    for (auto it = clients_.begin(); it != clients_.end(); )
-    {
-        it->second->release();
-        it = clients_.erase(it);
-    }
+    release_clients();
+}
+
+void Root::release_clients()
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    clients_.for_each([](const std::shared_ptr<ProxyClient>& client){ client->release(); });
+    clients_.clear();
 }
 
 dds::xrce::ResultStatus Root::create_client(
@@ -77,11 +87,12 @@ dds::xrce::ResultStatus Root::create_client(
     {
         if (client_representation.xrce_version()[0] == dds::xrce::XRCE_VERSION_MAJOR)
         {
-            std::lock_guard<std::mutex> lock(mtx_);
             dds::xrce::ClientKey client_key = client_representation.client_key();
             dds::xrce::SessionId session_id = client_representation.session_id();
-            auto it = clients_.find(client_key);
-            if (it == clients_.end())
+            const uint32_t raw_client_key = conversion::clientkey_to_raw(client_key);
+            std::lock_guard<std::mutex> lock(mtx_);
+            std::shared_ptr<ProxyClient> client;
+            if (!clients_.get(raw_client_key, client))
             {
                 std::unordered_map<std::string, std::string> client_properties;
 
@@ -94,36 +105,23 @@ dds::xrce::ResultStatus Root::create_client(
                     }
                 }
 
-                std::shared_ptr<ProxyClient> new_client = std::make_shared<ProxyClient>(
+                clients_.assign(raw_client_key, std::make_shared<ProxyClient>(
                     client_representation,
                     middleware_kind,
-                    std::move(client_properties));
-                if (clients_.emplace(client_key, std::move(new_client)).second)
-                {
-                    UXR_AGENT_LOG_INFO(
-                        UXR_DECORATE_GREEN("create"),
-                        UXR_CREATE_SESSION_PATTERN,
-                        conversion::clientkey_to_raw(client_key),
-                        session_id);
-                }
-                else
-                {
-                    result_status.status(dds::xrce::STATUS_ERR_RESOURCES);
-
-                    UXR_AGENT_LOG_INFO(
-                        UXR_DECORATE_RED("resources error"),
-                        UXR_CLIENT_KEY_PATTERN,
-                        conversion::clientkey_to_raw(client_representation.client_key()));
-                }
+                    std::move(client_properties)));
+                UXR_AGENT_LOG_INFO(
+                    UXR_DECORATE_GREEN("create"),
+                    UXR_CREATE_SESSION_PATTERN,
+                    raw_client_key,
+                    session_id);
             }
             else
             {
-                std::shared_ptr<ProxyClient> client = clients_.at(client_key);
                 if (session_id != client->get_session_id())
                 {
-                    it->second = std::make_shared<ProxyClient>(
+                    clients_.assign(raw_client_key, std::make_shared<ProxyClient>(
                         client_representation,
-                        middleware_kind);
+                        middleware_kind));
                 }
                 else
                 {
@@ -179,20 +177,18 @@ dds::xrce::ResultStatus Root::get_info(dds::xrce::ObjectInfo& agent_info)
 dds::xrce::ResultStatus Root::delete_client(const dds::xrce::ClientKey& client_key)
 {
     dds::xrce::ResultStatus result_status;
-    if (std::shared_ptr<ProxyClient> client = get_client(client_key))
+    const uint32_t raw_client_key = conversion::clientkey_to_raw(client_key);
+    std::lock_guard<std::mutex> lock(mtx_);
+    std::shared_ptr<ProxyClient> client;
+    if (clients_.get(raw_client_key, client))
     {
-        std::lock_guard<std::mutex> lock(mtx_);
-        if (current_client_ != clients_.end() && client_key == current_client_->first)
-        {
-            ++current_client_;
-        }
         client->release();
-        clients_.erase(client_key);
+        clients_.erase(raw_client_key);
         result_status.status(dds::xrce::STATUS_OK);
         UXR_AGENT_LOG_INFO(
             UXR_DECORATE_GREEN("delete"),
             UXR_CLIENT_KEY_PATTERN,
-            conversion::clientkey_to_raw(client_key));
+            raw_client_key);
     }
     else
     {
@@ -201,7 +197,7 @@ dds::xrce::ResultStatus Root::delete_client(const dds::xrce::ClientKey& client_k
         UXR_AGENT_LOG_INFO(
             UXR_DECORATE_RED("unknown client"),
             UXR_CLIENT_KEY_PATTERN,
-            conversion::clientkey_to_raw(client_key));
+            raw_client_key);
     }
     return result_status;
 }
@@ -209,28 +205,30 @@ dds::xrce::ResultStatus Root::delete_client(const dds::xrce::ClientKey& client_k
 std::shared_ptr<ProxyClient> Root::get_client(const dds::xrce::ClientKey& client_key)
 {
     std::shared_ptr<ProxyClient> client;
-    std::lock_guard<std::mutex> lock(mtx_);
-    auto it = clients_.find(client_key);
-    if (it != clients_.end())
-    {
-        client = clients_.at(client_key);
-    }
+    clients_.get(conversion::clientkey_to_raw(client_key), client);
     return client;
 }
 
 bool Root::get_next_client(std::shared_ptr<ProxyClient>& next_client)
 {
     bool rv = false;
-    std::lock_guard<std::mutex> lock(mtx_);
-    if (current_client_ != clients_.end())
+    std::lock_guard<std::mutex> lock(iteration_mtx_);
+    if (0 == current_client_)
     {
-        next_client = current_client_->second;
-        ++current_client_;
-        rv = true;
+        clients_.for_each([&](const std::shared_ptr<ProxyClient>& client){ current_clients_.push_back(client); });
     }
-    else
+
+    /* Clients deleted since the iteration started are skipped. */
+    while (!rv && (current_client_ < current_clients_.size()))
+    {
+        next_client = current_clients_[current_client_++];
+        rv = !next_client->is_released();
+    }
+
+    if (!rv)
     {
-        current_client_ = clients_.begin();
+        current_clients_.clear();
+        current_client_ = 0;
     }
     return rv;
 }
@@ -245,6 +243,155 @@ bool Root::load_config_file(const std::string& file_path)
 #endif
 }
 
+bool Root::enable_async_publishing(
+        int32_t max_bytes_per_period,
+        uint64_t period_ms,
+        const std::string& scheduler)
+{
+    bool rv = false;
+#ifdef UAGENT_FAST_PROFILE
+    using fastdds::rtps::FlowControllerSchedulerPolicy;
+    static const std::unordered_map<std::string, FlowControllerSchedulerPolicy> schedulers{
+        {"fifo", FlowControllerSchedulerPolicy::FIFO},
+        {"round-robin", FlowControllerSchedulerPolicy::ROUND_ROBIN},
+        {"high-priority", FlowControllerSchedulerPolicy::HIGH_PRIORITY},
+        {"priority-reservation", FlowControllerSchedulerPolicy::PRIORITY_WITH_RESERVATION}};
+
+    auto it = schedulers.find(scheduler);
+    if ((schedulers.end() != it) && (0 <= max_bytes_per_period) && (0 < period_ms))
+    {
+        FastDDSPublishMode& publish_mode = FastDDSPublishMode::get_default();
+        publish_mode.asynchronous = true;
+        publish_mode.max_bytes_per_period = max_bytes_per_period;
+        publish_mode.period_ms = period_ms;
+        publish_mode.scheduler = it->second;
+        UXR_AGENT_LOG_INFO(
+            UXR_DECORATE_GREEN("asynchronous publishing enabled"),
+            "max_bytes_per_period: {}, period_ms: {}, scheduler: {}",
+            max_bytes_per_period, period_ms, scheduler);
+        rv = true;
+    }
+#else
+    (void) max_bytes_per_period;
+    (void) period_ms;
+    (void) scheduler;
+#endif
+    return rv;
+}
+
+bool Root::enable_shared_memory(
+        uint32_t segment_size)
+{
+    bool rv = false;
+#ifdef UAGENT_FAST_PROFILE
+    if (0 < segment_size)
+    {
+        FastDDSTransports::get_default().shm_segment_size = segment_size;
+        UXR_AGENT_LOG_INFO(
+            UXR_DECORATE_GREEN("shared memory transport enabled"),
+            "segment_size: {}",
+            segment_size);
+        rv = true;
+    }
+#else
+    (void) segment_size;
+#endif
+    return rv;
+}
+
+bool Root::enable_data_sharing(
+        uint32_t max_sample_size)
+{
+    bool rv = false;
+#ifdef UAGENT_FAST_PROFILE
+    if (0 < max_sample_size)
+    {
+        FastDDSTransports::get_default().max_sample_size = max_sample_size;
+        UXR_AGENT_LOG_INFO(
+            UXR_DECORATE_GREEN("data-sharing enabled"),
+            "max_sample_size: {}",
+            max_sample_size);
+        rv = true;
+    }
+#else
+    (void) max_sample_size;
+#endif
+    return rv;
+}
+
+bool Root::set_key_layout(
+        const std::string& key_layout)
+{
+    bool rv = false;
+#ifdef UAGENT_FAST_PROFILE
+    std::string type_name;
+    KeyLayout layout;
+    if (parse_key_layout(key_layout, type_name, layout))
+    {
+        TopicPubSubType::set_key_layout(type_name, layout);
+        UXR_AGENT_LOG_INFO(
+            UXR_DECORATE_GREEN("key layout set"),
+            "type_name: {}, key_members: {}",
+            type_name, layout.size());
+        rv = true;
+    }
+#else
+    (void) key_layout;
+#endif
+    return rv;
+}
+
+bool Root::set_ced_history_depth(
+        const std::string& topic_name,
+        uint16_t depth)
+{
+    bool rv = false;
+#ifdef UAGENT_CED_PROFILE
+    if (0 < depth)
+    {
+        CedTopicManager::set_history_depth(topic_name, depth);
+        UXR_AGENT_LOG_INFO(
+            UXR_DECORATE_GREEN("CED history depth set"),
+            "topic_name: {}, depth: {}",
+            topic_name.empty() ? "(default)" : topic_name, depth);
+        rv = true;
+    }
+#else
+    (void) topic_name;
+    (void) depth;
+#endif
+    return rv;
+}
+
+bool Root::enable_ced_shared_memory(
+        uint32_t max_sample_size)
+{
+    bool rv = false;
+#ifdef UAGENT_CED_PROFILE
+    rv = CedTopicManager::set_shared_memory(max_sample_size);
+    if (rv)
+    {
+        UXR_AGENT_LOG_INFO(
+            UXR_DECORATE_GREEN("CED shared memory topics enabled"),
+            "max_sample_size: {}",
+            max_sample_size);
+    }
+#else
+    (void) max_sample_size;
+#endif
+    return rv;
+}
+
+void Root::set_link_rate(
+        uint32_t link_rate)
+{
+    ProxyClient::set_default_link_rate(link_rate);
+    UXR_AGENT_LOG_INFO(
+        UXR_DECORATE_GREEN("link rate set"),
+        "bytes_per_second: {}",
+        link_rate);
+}
+
 void Root::set_verbose_level(uint8_t verbose_level)
 {
 #ifdef UAGENT_LOGGER_PROFILE
@@ -305,14 +452,10 @@ void Root::set_verbose_level(uint8_t verbose_level)
 
 void Root::reset()
 {
-    std::lock_guard<std::mutex> lock(mtx_);
-    for (auto it = clients_.begin(); it != clients_.end(); )
-    {
-        it->second->release();
-        it = clients_.erase(it);
-    }
-    clients_.clear();
-    current_client_ = clients_.begin();
+    release_clients();
+    std::lock_guard<std::mutex> lock(iteration_mtx_);
+    current_clients_.clear();
+    current_client_ = 0;
 }
 
 } // namespace uxr
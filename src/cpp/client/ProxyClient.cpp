@@ -31,21 +31,98 @@
 #include <uxr/agent/middleware/ced/CedMiddleware.hpp>
 #endif
 
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <thread>
+
 namespace eprosima {
 namespace uxr {
 
+namespace {
+
+/* Client supplied numeric property, value is left untouched unless it is a number within [min, max]. */
+bool get_numeric_property(
+        const std::unordered_map<std::string, std::string>& properties,
+        const std::string& name,
+        int64_t min,
+        int64_t max,
+        int64_t& value)
+{
+    bool rv = false;
+    auto it = properties.find(name);
+    if (it != properties.end())
+    {
+        const char* str = it->second.c_str();
+        char* end = nullptr;
+        errno = 0;
+        const long long parsed = std::strtoll(str, &end, 10);
+        if ((end != str) && ('\0' == *end) && (0 == errno) && (min <= parsed) && (parsed <= max))
+        {
+            value = parsed;
+            rv = true;
+        }
+        else
+        {
+            UXR_AGENT_LOG_WARN(
+                UXR_DECORATE_YELLOW("invalid client property ignored"),
+                "name: {}, value: {}",
+                name, it->second);
+        }
+    }
+    return rv;
+}
+
+/* ACKNACK policy overrides: "uxr_an" (messages per ACKNACK) and "uxr_at" (maximum delay in ms). */
+AckPolicy get_ack_policy(
+        const std::unordered_map<std::string, std::string>& properties)
+{
+    AckPolicy ack_policy;
+    int64_t value = 0;
+    if (get_numeric_property(properties, "uxr_an", 1, UINT16_MAX, value))
+    {
+        ack_policy.max_pending = uint16_t(value);
+    }
+    if (get_numeric_property(properties, "uxr_at", 0, UINT16_MAX, value))
+    {
+        ack_policy.max_delay = std::chrono::milliseconds(value);
+    }
+    return ack_policy;
+}
+
+std::atomic<uint32_t> default_link_rate{0};
+
+/* Link rate override: "uxr_lr" (bytes per second, 0 for no limit). */
+uint32_t get_link_rate(
+        const std::unordered_map<std::string, std::string>& properties)
+{
+    uint32_t link_rate = default_link_rate.load();
+    int64_t value = 0;
+    if (get_numeric_property(properties, "uxr_lr", 0, UINT32_MAX, value))
+    {
+        link_rate = uint32_t(value);
+    }
+    return link_rate;
+}
+
+} // unnamed namespace
+
 ProxyClient::ProxyClient(
         const dds::xrce::CLIENT_Representation& representation,
         Middleware::Kind middleware_kind,
         std::unordered_map<std::string, std::string>&& properties)
     : representation_(representation)
     , objects_()
-    , session_(SessionInfo{representation.client_key(), representation.session_id(), representation.mtu()})
+    , handles_{}
+    , session_(SessionInfo{representation.client_key(), representation.session_id(), representation.mtu()},
+               get_ack_policy(properties))
     , state_{State::alive}
     , timestamp_{std::chrono::steady_clock::now()}
     , properties_(std::move(properties))
     , client_dead_time_(CLIENT_DEAD_TIME)
     , hard_liveliness_check_(false)
+    , link_pacer_(get_link_rate(properties_), representation.mtu())
+    , released_(false)
 {
     switch (middleware_kind)
     {
@@ -67,7 +144,13 @@ ProxyClient::ProxyClient(
             bool intraprocess_enabled =
                 properties_.find("uxr_sm") != properties_.end() &&
                 properties_["uxr_sm"] == "1";
-            middleware_.reset(new FastDDSMiddleware(intraprocess_enabled));
+            bool shared_participants =
+                properties_.find("uxr_sp") != properties_.end() &&
+                properties_["uxr_sp"] == "1";
+            bool shared_readers =
+                properties_.find("uxr_sr") != properties_.end() &&
+                properties_["uxr_sr"] == "1";
+            middleware_.reset(new FastDDSMiddleware(intraprocess_enabled, shared_participants, shared_readers));
             break;
         }
 #endif
@@ -90,6 +173,19 @@ ProxyClient::ProxyClient(
     }
 }
 
+ProxyClient::~ProxyClient()
+{
+    for (auto& slots : handles_)
+    {
+        delete slots.load();
+    }
+}
+
+void ProxyClient::set_default_link_rate(uint32_t link_rate)
+{
+    default_link_rate = link_rate;
+}
+
 dds::xrce::ResultStatus ProxyClient::create_object(
         const dds::xrce::CreationMode& creation_mode,
         const dds::xrce::ObjectPrefix& objectid_prefix,
@@ -221,6 +317,11 @@ std::shared_ptr<XRCEObject> ProxyClient::get_object(const dds::xrce::ObjectId& o
 
 void ProxyClient::release()
 {
+    released_.store(true);
+    for (auto& object : objects_)
+    {
+        unregister_handle(object.first);
+    }
     objects_.clear();
 }
 
@@ -273,6 +374,11 @@ bool ProxyClient::create_object(
         default:
             break;
     }
+
+    if (rv)
+    {
+        register_handle(object_id, objects_.at(object_id).get());
+    }
     return rv;
 }
 
@@ -730,6 +836,7 @@ bool ProxyClient::delete_object_unlock(
     auto it = objects_.find(object_id);
     if (it != objects_.end())
     {
+        unregister_handle(object_id);
         objects_.erase(object_id);
         UXR_AGENT_LOG_DEBUG(
             UXR_DECORATE_GREEN("object deleted"),
@@ -749,6 +856,58 @@ bool ProxyClient::delete_object_unlock(
     return rv;
 }
 
+void ProxyClient::register_handle(
+        const dds::xrce::ObjectId& object_id,
+        XRCEObject* object)
+{
+    /* The concrete type follows from the object kind, so no dynamic_cast is needed. */
+    void* handle = nullptr;
+    const dds::xrce::ObjectKind object_kind = object_id[1] & 0x0F;
+    switch (object_kind)
+    {
+        case dds::xrce::OBJK_DATAWRITER:
+            handle = static_cast<DataWriter*>(object);
+            break;
+        case dds::xrce::OBJK_DATAREADER:
+            handle = static_cast<DataReader*>(object);
+            break;
+        case dds::xrce::OBJK_REQUESTER:
+            handle = static_cast<Requester*>(object);
+            break;
+        case dds::xrce::OBJK_REPLIER:
+            handle = static_cast<Replier*>(object);
+            break;
+        default:
+            return;
+    }
+
+    HandleSlots* slots = handles_[object_kind].load();
+    if (nullptr == slots)
+    {
+        slots = new HandleSlots();
+        handles_[object_kind].store(slots);
+    }
+    (*slots)[handle_index(object_id)].object.store(handle);
+}
+
+void ProxyClient::unregister_handle(
+        const dds::xrce::ObjectId& object_id)
+{
+    HandleSlots* slots = handles_[object_id[1] & 0x0F].load();
+    if (nullptr != slots)
+    {
+        HandleSlot& slot = (*slots)[handle_index(object_id)];
+        if (nullptr != slot.object.exchange(nullptr))
+        {
+            /* Wait for the in-flight handles to this object before it can be destroyed. */
+            while (0 != slot.readers.load())
+            {
+                std::this_thread::yield();
+            }
+        }
+    }
+}
+
 ProxyClient::State ProxyClient::get_state()
 {
     std::lock_guard<std::mutex> lock(state_mtx_);
@@ -18,11 +18,19 @@
 #include <uxr/agent/client/ProxyClient.hpp>
 #include <uxr/agent/utils/TokenBucket.hpp>
 #include <uxr/agent/logger/Logger.hpp>
+#include <algorithm>
 #include <iostream>
 
 namespace eprosima {
 namespace uxr {
 
+namespace {
+
+/* Samples per DATA submessage, PACKED_SAMPLES deltas are limited to 8 bits. */
+constexpr uint16_t batch_max_samples = 64;
+
+} // unnamed namespace
+
 #if defined(UAGENT_RESTRICT) || defined(UAGENT_PROTECT)
 std::vector<std::string> DataReader::topic_frequency_array;
 std::vector<DataReader::TopicInfo> DataReader::topic_info_;
@@ -76,6 +84,10 @@ std::unique_ptr<DataReader> DataReader::create(
     }
 
     DataReader* dr = new DataReader(object_id, proxy_client);
+    if (middleware.set_data_available_callback(raw_object_id, std::bind(&Reader<bool>::notify, &dr->reader_)))
+    {
+        dr->reader_.set_notified(true);
+    }
 #if defined(UAGENT_RESTRICT) || defined(UAGENT_PROTECT)
     std::cout << "[DR] listing topic..." << std::endl;
     for (const auto &topic : topic_info_)
@@ -110,10 +122,19 @@ DataReader::DataReader(
     : XRCEObject{object_id}
     , proxy_client_{proxy_client}
     , reader_{}
-{}
+    , data_format_{dds::xrce::FORMAT_DATA}
+    , request_id_{}
+    , sequence_number_{0}
+    , read_time_{}
+    , source_timestamp_{}
+    , filter_{}
+{
+    reader_.set_link_pacer(&proxy_client_->get_link_pacer());
+}
 
 DataReader::~DataReader() noexcept
 {
+    proxy_client_->get_middleware().set_data_available_callback(get_raw_id(), nullptr);
     reader_.stop_reading();
     proxy_client_->get_middleware().delete_datareader(get_raw_id());
 }
@@ -178,29 +199,190 @@ bool DataReader::read(
         delivery_control.max_samples(1);
     }
 
-    /* TODO (julianbermudez): implement different data formats.
-    switch (read_data.read_specification().data_format())
+    reader_.stop_reading();
+
+    /* Content filter on the serialized samples, those not matching are never sent to the client. */
+    filter_.clear();
+    if (read_data.read_specification().has_content_filter_expression())
     {
-        case dds::xrce::FORMAT_DATA:
+        const std::string& expression = read_data.read_specification().content_filter_expression();
+        if (!parse_sample_filter(expression, filter_))
+        {
+            UXR_AGENT_LOG_WARN(
+                UXR_DECORATE_YELLOW("invalid content filter expression"),
+                "object_id: 0x{:04X}, expression: {}",
+                get_raw_id(),
+                expression);
+            return false;
+        }
+    }
+
+    /* Several samples per DATA submessage. Its payload length is 16 bits on reliable streams,
+       which fragment it, and the whole message has to fit in the MTU on the others. */
+    using namespace std::placeholders;
+    data_format_ = read_data.read_specification().data_format() & dds::xrce::FORMAT_MASK;
+    request_id_ = read_data.request_id();
+    switch (data_format_)
+    {
+        case dds::xrce::FORMAT_SAMPLE:
+            reader_.set_batching(
+                std::bind(&DataReader::batch_fn, this, _1, _2, _3),
+                std::bind(&DataReader::batch_size_fn, this, _1, _2),
+                1,
+                SIZE_MAX);
             break;
+        case dds::xrce::FORMAT_DATA_SEQ:
+        case dds::xrce::FORMAT_SAMPLE_SEQ:
+        case dds::xrce::FORMAT_PACKED_SAMPLES:
+        {
+            size_t max_bytes = UINT16_MAX;
+            if (!is_reliable_stream(read_data.read_specification().preferred_stream_id()))
+            {
+                const SessionInfo& session_info = proxy_client_->session().get_session_info();
+                dds::xrce::MessageHeader header;
+                header.session_id(session_info.session_id);
+                const size_t headers_size =
+                    header.getCdrSerializedSize() + dds::xrce::SubmessageHeader{}.getCdrSerializedSize();
+                max_bytes = (headers_size < session_info.mtu) ? session_info.mtu - headers_size : 0;
+            }
+            reader_.set_batching(
+                std::bind(&DataReader::batch_fn, this, _1, _2, _3),
+                std::bind(&DataReader::batch_size_fn, this, _1, _2),
+                batch_max_samples,
+                max_bytes,
+                [this](){ return source_timestamp_; });
+            break;
+        }
+        default:
+            data_format_ = dds::xrce::FORMAT_DATA;
+            reader_.set_batching(nullptr, nullptr, 1, SIZE_MAX);
+            break;
+    }
+    sequence_number_ = 0;
+    read_time_ = std::chrono::steady_clock::now();
+
+    write_args.data_format = data_format_;
+    write_args.client = proxy_client_;
+    write_args.resume = reader_.get_resume_fn();
+
+    return reader_.start_reading(delivery_control, std::bind(&DataReader::read_fn, this, _1, _2, _3), false, write_fn, write_args);
+}
+
+size_t DataReader::batch_size_fn(
+        size_t batch_size,
+        size_t sample_size) const
+{
+    /* Encoded DATA payload sizes, the sample data adding its bytes to an empty sample. */
+    size_t size = batch_size;
+    switch (data_format_)
+    {
         case dds::xrce::FORMAT_SAMPLE:
+            size = dds::xrce::DATA_Payload_Sample{}.getCdrSerializedSize();
             break;
         case dds::xrce::FORMAT_DATA_SEQ:
+            size = (0 == size) ? dds::xrce::DATA_Payload_DataSeq{}.getCdrSerializedSize() : size;
+            size += 4 + fastcdr::Cdr::alignment(size, 4);
             break;
         case dds::xrce::FORMAT_SAMPLE_SEQ:
+            size = (0 == size) ? dds::xrce::DATA_Payload_SampleSeq{}.getCdrSerializedSize() : size;
+            size += dds::xrce::Sample{}.getCdrSerializedSize(size);
             break;
         case dds::xrce::FORMAT_PACKED_SAMPLES:
+            size = (0 == size) ? dds::xrce::DATA_Payload_PackedSamples{}.getCdrSerializedSize() : size;
+            size += dds::xrce::SampleDelta{}.getCdrSerializedSize(size);
             break;
         default:
             break;
     }
-    */
+    return size + sample_size;
+}
 
-    write_args.client = proxy_client_;
+void DataReader::batch_fn(
+        std::vector<std::vector<uint8_t>>& samples,
+        const std::vector<std::chrono::system_clock::time_point>& sample_times,
+        std::vector<uint8_t>& data)
+{
+    dds::xrce::SampleInfo info;
+    info.state(dds::xrce::SampleInfoFlags(0));
+    info.sequence_number(sequence_number_);
+    info.session_time_offset(uint32_t(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - read_time_).count()));
 
-    using namespace std::placeholders;
-    return (reader_.stop_reading() &&
-            reader_.start_reading(delivery_control, std::bind(&DataReader::read_fn, this, _1, _2, _3), false, write_fn, write_args));
+    switch (data_format_)
+    {
+        case dds::xrce::FORMAT_SAMPLE:
+        {
+            dds::xrce::DATA_Payload_Sample payload;
+            payload.sample().info(info);
+            payload.sample().data().serialized_data(std::move(samples.front()));
+            serialize_batch(payload, data);
+            break;
+        }
+        case dds::xrce::FORMAT_DATA_SEQ:
+        {
+            dds::xrce::DATA_Payload_DataSeq payload;
+            payload.data_seq().resize(samples.size());
+            for (size_t i = 0; i < samples.size(); ++i)
+            {
+                payload.data_seq()[i].serialized_data(std::move(samples[i]));
+            }
+            serialize_batch(payload, data);
+            break;
+        }
+        case dds::xrce::FORMAT_SAMPLE_SEQ:
+        {
+            dds::xrce::DATA_Payload_SampleSeq payload;
+            payload.sample_seq().resize(samples.size());
+            for (size_t i = 0; i < samples.size(); ++i)
+            {
+                info.sequence_number(uint32_t(sequence_number_ + i));
+                payload.sample_seq()[i].info(info);
+                payload.sample_seq()[i].data().serialized_data(std::move(samples[i]));
+            }
+            serialize_batch(payload, data);
+            break;
+        }
+        case dds::xrce::FORMAT_PACKED_SAMPLES:
+        {
+            dds::xrce::DATA_Payload_PackedSamples payload;
+            payload.packed_samples().info_base(info);
+            payload.packed_samples().sample_delta_seq().resize(samples.size());
+            for (size_t i = 0; i < samples.size(); ++i)
+            {
+                /* Deciseconds from the source timestamp of the first sample, earlier ones count as 0. */
+                using deciseconds = std::chrono::duration<int64_t, std::deci>;
+                const int64_t timestamp_delta =
+                    std::chrono::duration_cast<deciseconds>(sample_times[i] - sample_times.front()).count();
+
+                dds::xrce::SampleDelta& delta = payload.packed_samples().sample_delta_seq()[i];
+                delta.info_delta().state(dds::xrce::SampleInfoFlags(0));
+                delta.info_delta().seq_number_delta(uint8_t(i));
+                delta.info_delta().timestamp_delta(dds::xrce::DeciSecond(
+                    std::min<int64_t>(std::max<int64_t>(timestamp_delta, 0), UINT16_MAX)));
+                delta.data().serialized_data(std::move(samples[i]));
+            }
+            serialize_batch(payload, data);
+            break;
+        }
+        default:
+            break;
+    }
+
+    sequence_number_ += uint32_t(samples.size());
+}
+
+template<class T>
+void DataReader::serialize_batch(
+        T& payload,
+        std::vector<uint8_t>& data) const
+{
+    payload.request_id(request_id_);
+    payload.object_id(get_id());
+
+    data.resize(payload.getCdrSerializedSize());
+    fastcdr::FastBuffer fastbuffer{reinterpret_cast<char*>(data.data()), data.size()};
+    fastcdr::Cdr serializer(fastbuffer, fastcdr::Cdr::DEFAULT_ENDIAN, fastcdr::CdrVersion::XCDRv1);
+    payload.serialize(serializer);
 }
 
 bool DataReader::read_fn(
@@ -208,9 +390,16 @@ bool DataReader::read_fn(
         std::vector<uint8_t>& data,
         std::chrono::milliseconds timeout)
 {
-    bool rv = false;
-    if (proxy_client_->get_middleware().read_data(get_raw_id(), data, timeout))
+    Middleware& middleware = proxy_client_->get_middleware();
+    bool rv = middleware.read_timestamped_data(get_raw_id(), data, source_timestamp_, timeout);
+    while (rv && !match_sample_filter(data.data(), data.size(), filter_))
+    {
+        rv = middleware.read_timestamped_data(get_raw_id(), data, source_timestamp_, std::chrono::milliseconds(0));
+    }
+
+    if (rv)
     {
+        rv = false;
 #if defined(UAGENT_RESTRICT)
         if (frequency == 0)
         {
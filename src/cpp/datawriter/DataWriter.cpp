@@ -70,8 +70,9 @@ std::unique_ptr<DataWriter> DataWriter::create(
     if(!created_entity){
         return nullptr;
     }
-#if defined(UAGENT_RESTRICT) || defined(UAGENT_PROTECT)
     DataWriter* dw = new DataWriter(object_id, proxy_client);
+    dw->handle_ = middleware.get_datawriter_handle(raw_object_id);
+#if defined(UAGENT_RESTRICT) || defined(UAGENT_PROTECT)
     std::cout << "[DW] listing topic..." << std::endl;
     for (const auto &topic : topic_info_)
     {
@@ -106,6 +107,7 @@ DataWriter::DataWriter(const dds::xrce::ObjectId& object_id,
         const std::shared_ptr<ProxyClient>& proxy_client)
     : XRCEObject{object_id}
     , proxy_client_{proxy_client}
+    , handle_{nullptr}
 {}
 
 DataWriter::~DataWriter()
@@ -155,10 +157,17 @@ bool DataWriter::matched(const dds::xrce::ObjectVariant& new_object_rep) const
     return rv;
 }
 
+bool DataWriter::write_middleware(const std::vector<uint8_t>& data)
+{
+    return (nullptr != handle_)
+        ? handle_->write(data)
+        : proxy_client_->get_middleware().write_data(get_raw_id(), data);
+}
+
 bool DataWriter::write(dds::xrce::WRITE_DATA_Payload_Data& write_data)
 {
     bool rv = false;
-    if (proxy_client_->get_middleware().write_data(get_raw_id(), write_data.data().serialized_data()))
+    if (write_middleware(write_data.data().serialized_data()))
     {
 #if defined(UAGENT_RESTRICT)
         if (frequency == 0){
@@ -221,7 +230,7 @@ bool DataWriter::write(dds::xrce::WRITE_DATA_Payload_Data& write_data)
 bool DataWriter::write(const std::vector<uint8_t>& data)
 {
     bool rv = false;
-    if (proxy_client_->get_middleware().write_data(get_raw_id(), data))
+    if (write_middleware(data))
     {
         UXR_AGENT_LOG_MESSAGE(
             UXR_DECORATE_YELLOW("[** <<DDS>> **]"),
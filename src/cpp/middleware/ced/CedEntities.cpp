@@ -13,7 +13,10 @@
 // limitations under the License.
 
 #include <uxr/agent/middleware/ced/CedEntities.hpp>
+#include <uxr/agent/middleware/ced/CedSharedRing.hpp>
+#include <uxr/agent/logger/Logger.hpp>
 
+#include <algorithm>
 #include <chrono>
 #include <memory>
 
@@ -23,48 +26,106 @@ namespace uxr {
 /**********************************************************************************************************************
  * CedTopicManager
  **********************************************************************************************************************/
-std::unordered_map<uint32_t, OnNewDomain> CedTopicManager::on_new_domain_map_;
-std::unordered_map<uint32_t, OnNewTopic> CedTopicManager::on_new_topic_map_;
-std::unordered_map<int16_t, std::unordered_map<std::string, std::weak_ptr<CedGlobalTopic>>> CedTopicManager::topics_;
+std::array<CedTopicManager::Shard, CedTopicManager::shard_count> CedTopicManager::shards_;
+std::unordered_map<int16_t, size_t> CedTopicManager::domains_;
+std::mutex CedTopicManager::domains_mtx_;
+std::unordered_map<uint32_t, std::shared_ptr<CedTopicManager::Callback<OnNewDomain>>> CedTopicManager::on_new_domain_map_;
+std::unordered_map<uint32_t, std::shared_ptr<CedTopicManager::Callback<OnNewTopic>>> CedTopicManager::on_new_topic_map_;
+std::condition_variable CedTopicManager::callbacks_cv_;
+std::unordered_map<std::string, uint16_t> CedTopicManager::history_depths_;
+uint32_t CedTopicManager::shared_sample_size_ = 0;
 std::mutex CedTopicManager::mtx_;
+constexpr uint16_t CedTopicManager::default_history_depth;
+constexpr size_t CedTopicManager::shard_count;
 
 void CedTopicManager::register_on_new_domain_cb(
         uint32_t key,
         const OnNewDomain& on_new_domain_cb)
 {
-    std::lock_guard<std::mutex> lock(mtx_);
-    for (auto& topic : topics_)
+    /* Domains registered meanwhile are either in the snapshot or notified to the new callback. */
+    std::vector<int16_t> domains;
+    std::shared_ptr<Callback<OnNewDomain>> callback = std::make_shared<Callback<OnNewDomain>>(on_new_domain_cb);
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        on_new_domain_map_.emplace(key, callback);
+        ++callback->running;
+        std::lock_guard<std::mutex> domains_lock(domains_mtx_);
+        for (auto& domain : domains_)
+        {
+            domains.push_back(domain.first);
+        }
+    }
+
+    for (auto& domain : domains)
     {
-        on_new_domain_cb(topic.first);
+        callback->fn(domain);
     }
-    on_new_domain_map_.emplace(key, on_new_domain_cb);
+    release_callback(callback->running);
 }
 
 void CedTopicManager::unregister_on_new_domain_cb(uint32_t key)
 {
-    std::lock_guard<std::mutex> lock(mtx_);
-    on_new_domain_map_.erase(key);
+    unregister_callback(on_new_domain_map_, key);
 }
 
 void CedTopicManager::register_on_new_topic_cb(
         uint32_t key,
         const OnNewTopic& on_new_topic_cb)
 {
-    std::lock_guard<std::mutex> lock(mtx_);
-    for (auto& topic : topics_)
+    std::vector<std::pair<int16_t, std::string>> topics;
+    std::shared_ptr<Callback<OnNewTopic>> callback = std::make_shared<Callback<OnNewTopic>>(on_new_topic_cb);
     {
-        for (auto& t : topic.second)
+        std::lock_guard<std::mutex> lock(mtx_);
+        on_new_topic_map_.emplace(key, callback);
+        ++callback->running;
+        for (auto& shard : shards_)
         {
-            on_new_topic_cb(topic.first, t.first);
+            std::shared_ptr<const TopicMap> shard_topics = std::atomic_load(&shard.topics);
+            for (auto& topic : *shard_topics)
+            {
+                for (auto& t : topic.second)
+                {
+                    topics.emplace_back(topic.first, t.first);
+                }
+            }
         }
     }
-    on_new_topic_map_.emplace(key, on_new_topic_cb);
+
+    for (auto& topic : topics)
+    {
+        callback->fn(topic.first, topic.second);
+    }
+    release_callback(callback->running);
 }
 
 void CedTopicManager::unregister_on_new_topic_cb(uint32_t key)
+{
+    unregister_callback(on_new_topic_map_, key);
+}
+
+template<typename Fn>
+void CedTopicManager::unregister_callback(
+        std::unordered_map<uint32_t, std::shared_ptr<Callback<Fn>>>& callbacks,
+        uint32_t key)
+{
+    std::unique_lock<std::mutex> lock(mtx_);
+    auto it = callbacks.find(key);
+    if (callbacks.end() != it)
+    {
+        std::shared_ptr<Callback<Fn>> callback = std::move(it->second);
+        callbacks.erase(it);
+        callbacks_cv_.wait(lock, [&callback](){ return 0 == callback->running; });
+    }
+}
+
+void CedTopicManager::release_callback(
+        size_t& running)
 {
     std::lock_guard<std::mutex> lock(mtx_);
-    on_new_topic_map_.erase(key);
+    if (0 == --running)
+    {
+        callbacks_cv_.notify_all();
+    }
 }
 
 bool CedTopicManager::register_topic(
@@ -72,77 +133,232 @@ bool CedTopicManager::register_topic(
         int16_t domain_id,
         std::shared_ptr<CedGlobalTopic>& topic)
 {
-    std::lock_guard<std::mutex> lock(mtx_);
+    Shard& shard = get_shard(topic_name, domain_id);
 
-    /* Register domain. */
-    auto it_domain = topics_.find(domain_id);
-    if (topics_.end() == it_domain)
-    {
-        topics_[domain_id] = {};
+    /* Existing topics are found without locking. */
+    topic = find_topic(*std::atomic_load(&shard.topics), topic_name, domain_id);
 
-        /* Call to callbacks. */
-        for (auto& cb_domain : on_new_domain_map_)
-        {
-            cb_domain.second(domain_id);
-        }
-    }
-
-    /* Register topic. */
-    auto it_topic = topics_[domain_id].find(topic_name);
-    if (topics_[domain_id].end() == it_topic)
+    bool new_topic = false;
+    if (!topic)
     {
-        /* Call to callbacks. */
-        for (auto& cb_topic : on_new_topic_map_)
+        std::lock_guard<std::mutex> lock(shard.mtx);
+        std::shared_ptr<const TopicMap> topics = std::atomic_load(&shard.topics);
+        topic = find_topic(*topics, topic_name, domain_id);
+        if (!topic)
         {
-            cb_topic.second(domain_id, topic_name);
+            /* An expired entry, whose topic is being destroyed, is just replaced. */
+            auto it_domain = topics->find(domain_id);
+            new_topic = (topics->end() == it_domain) || (it_domain->second.end() == it_domain->second.find(topic_name));
+
+            uint16_t history_depth;
+            uint32_t shared_sample_size;
+            get_topic_config(topic_name, history_depth, shared_sample_size);
+            topic = std::make_shared<CedGlobalTopic>(topic_name, domain_id, history_depth, shared_sample_size);
+            std::shared_ptr<TopicMap> new_topics = std::make_shared<TopicMap>(*topics);
+            (*new_topics)[domain_id][topic_name] = topic;
+            std::atomic_store(&shard.topics, std::shared_ptr<const TopicMap>(std::move(new_topics)));
         }
-        topic = std::make_shared<CedGlobalTopic>(topic_name, domain_id);
-        topics_[domain_id].emplace(topic_name, topic);
     }
-    else
+
+    if (new_topic)
     {
-        topic = it_topic->second.lock();
+        notify_new_topic(topic_name, domain_id);
     }
 
     return true;
 }
 
+void CedTopicManager::set_history_depth(
+        const std::string& topic_name,
+        uint16_t depth)
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    history_depths_[topic_name] = std::max(uint16_t(1), depth);
+}
+
+bool CedTopicManager::set_shared_memory(
+        uint32_t max_sample_size)
+{
+    bool rv = false;
+#if defined(__linux__) && !defined(__ANDROID__)
+    std::lock_guard<std::mutex> lock(mtx_);
+    shared_sample_size_ = max_sample_size;
+    rv = true;
+#else
+    (void) max_sample_size;
+#endif
+    return rv;
+}
+
 bool CedTopicManager::unregister_topic(
         const std::string& topic_name,
         int16_t domain_id)
 {
     bool rv = false;
-    std::lock_guard<std::mutex> lock(mtx_);
-    auto it_domain = topics_.find(domain_id);
-    if (topics_.end() != it_domain)
+    Shard& shard = get_shard(topic_name, domain_id);
     {
-        auto it_topic = topics_[domain_id].find(topic_name);
-        if (topics_[domain_id].end() != it_topic)
+        std::lock_guard<std::mutex> lock(shard.mtx);
+        std::shared_ptr<const TopicMap> topics = std::atomic_load(&shard.topics);
+        auto it_domain = topics->find(domain_id);
+        if (topics->end() != it_domain)
         {
-            if (it_topic->second.expired())
+            auto it_topic = it_domain->second.find(topic_name);
+            if ((it_domain->second.end() != it_topic) && it_topic->second.expired())
             {
-                it_domain->second.erase(it_topic);
-                if (it_domain->second.empty())
+                std::shared_ptr<TopicMap> new_topics = std::make_shared<TopicMap>(*topics);
+                auto new_it_domain = new_topics->find(domain_id);
+                new_it_domain->second.erase(topic_name);
+                if (new_it_domain->second.empty())
                 {
-                    topics_.erase(it_domain);
+                    new_topics->erase(new_it_domain);
                 }
+                std::atomic_store(&shard.topics, std::shared_ptr<const TopicMap>(std::move(new_topics)));
                 rv = true;
             }
         }
     }
+
+    if (rv)
+    {
+        std::lock_guard<std::mutex> lock(domains_mtx_);
+        auto it_domain = domains_.find(domain_id);
+        if ((domains_.end() != it_domain) && (0 == --it_domain->second))
+        {
+            domains_.erase(it_domain);
+        }
+    }
     return rv;
 }
 
+CedTopicManager::Shard& CedTopicManager::get_shard(
+        const std::string& topic_name,
+        int16_t domain_id)
+{
+    const size_t hash = std::hash<std::string>()(topic_name) ^ (size_t(uint16_t(domain_id)) * 0x9E3779B1u);
+    return shards_[hash % shard_count];
+}
+
+std::shared_ptr<CedGlobalTopic> CedTopicManager::find_topic(
+        const TopicMap& topics,
+        const std::string& topic_name,
+        int16_t domain_id)
+{
+    std::shared_ptr<CedGlobalTopic> topic;
+    auto it_domain = topics.find(domain_id);
+    if (topics.end() != it_domain)
+    {
+        auto it_topic = it_domain->second.find(topic_name);
+        if (it_domain->second.end() != it_topic)
+        {
+            topic = it_topic->second.lock();
+        }
+    }
+    return topic;
+}
+
+void CedTopicManager::get_topic_config(
+        const std::string& topic_name,
+        uint16_t& history_depth,
+        uint32_t& shared_sample_size)
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    auto it_depth = history_depths_.find(topic_name);
+    if (history_depths_.end() == it_depth)
+    {
+        it_depth = history_depths_.find(std::string());
+    }
+    history_depth = (history_depths_.end() == it_depth) ? default_history_depth : it_depth->second;
+    shared_sample_size = shared_sample_size_;
+}
+
+void CedTopicManager::notify_new_topic(
+        const std::string& topic_name,
+        int16_t domain_id)
+{
+    bool new_domain = false;
+    {
+        std::lock_guard<std::mutex> lock(domains_mtx_);
+        new_domain = (1 == ++domains_[domain_id]);
+    }
+
+    /* Callbacks registered meanwhile already got this topic, if not notified here. */
+    std::vector<std::shared_ptr<Callback<OnNewDomain>>> domain_cbs;
+    std::vector<std::shared_ptr<Callback<OnNewTopic>>> topic_cbs;
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        if (new_domain)
+        {
+            for (auto& cb_domain : on_new_domain_map_)
+            {
+                ++cb_domain.second->running;
+                domain_cbs.push_back(cb_domain.second);
+            }
+        }
+        for (auto& cb_topic : on_new_topic_map_)
+        {
+            ++cb_topic.second->running;
+            topic_cbs.push_back(cb_topic.second);
+        }
+    }
+
+    /* Call to callbacks, their unregistration waits for them. */
+    for (auto& cb_domain : domain_cbs)
+    {
+        cb_domain->fn(domain_id);
+        release_callback(cb_domain->running);
+    }
+    for (auto& cb_topic : topic_cbs)
+    {
+        cb_topic->fn(domain_id, topic_name);
+        release_callback(cb_topic->running);
+    }
+}
+
 /**********************************************************************************************************************
  * CedTopicCloud
  **********************************************************************************************************************/
 CedGlobalTopic::CedGlobalTopic(
         const std::string& topic_name,
-        int16_t domain_id)
+        int16_t domain_id,
+        uint16_t history_depth,
+        uint32_t shared_sample_size)
     : name_(topic_name)
     , domain_id_(domain_id)
-    , last_write_(UINT16_MAX)
+    , depth_(std::max(uint16_t(1), history_depth))
+    , history_(new Slot[depth_])
+    , write_count_(0)
+    , write_mtx_()
+    , waiters_(0)
+    , wait_mtx_()
+    , cv_()
+    , callbacks_count_(0)
+    , callbacks_mtx_()
+    , callbacks_()
+    , last_callback_(0)
+    , shared_ring_()
 {
+#if defined(__linux__) && !defined(__ANDROID__)
+    if (0 < shared_sample_size)
+    {
+        shared_ring_ = CedSharedRing::open(topic_name, domain_id, history_depth, shared_sample_size);
+        if (shared_ring_)
+        {
+            UXR_AGENT_LOG_DEBUG(
+                UXR_DECORATE_GREEN("shared memory topic opened"),
+                "topic: {}, segment: {}, depth: {}",
+                topic_name, shared_ring_->name(), shared_ring_->depth());
+        }
+        else
+        {
+            UXR_AGENT_LOG_WARN(
+                UXR_DECORATE_YELLOW("shared memory topic not available, using a local one"),
+                "topic: {}, domain_id: {}",
+                topic_name, domain_id);
+        }
+    }
+#else
+    (void) shared_sample_size;
+#endif
 }
 
 CedGlobalTopic::~CedGlobalTopic()
@@ -155,6 +371,11 @@ const std::string& CedGlobalTopic::name() const
     return name_;
 }
 
+size_t CedGlobalTopic::history_depth() const
+{
+    return shared_ring_ ? size_t(shared_ring_->depth()) : depth_;
+}
+
 bool CedGlobalTopic::write(
         const std::vector<uint8_t>& data,
         WriteAccess write_access,
@@ -162,15 +383,51 @@ bool CedGlobalTopic::write(
         uint8_t& errcode)
 {
     bool rv = false;
-    if (check_write_access(write_access, topic_src))
+    if (check_write_access(write_access, topic_src) && shared_ring_)
+    {
+        /* Fails if the sample does not fit in a slot. */
+        rv = shared_ring_->write(data, topic_src);
+        errcode = rv ? 0 : 1;
+    }
+    else if (check_write_access(write_access, topic_src))
     {
-        std::unique_lock<std::mutex> lock(mtx_);
-        size_t index = uint16_t(last_write_ + 1) % history_.size();
-        history_[index] = data;
-        srcs_[index] = topic_src;
-        ++last_write_;
-        lock.unlock();
-        cv_.notify_all();
+        {
+            std::lock_guard<std::mutex> lock(write_mtx_);
+            const uint64_t seq = write_count_.load(std::memory_order_relaxed);
+            Slot& slot = history_[seq % depth_];
+            slot.seq.store((seq << 1) | 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            if (slot.capacity < data.size())
+            {
+                slot.capacity = std::max(data.size(), 2 * slot.capacity);
+                slot.buffers.emplace_back(new uint8_t[slot.capacity]);
+                slot.data.store(slot.buffers.back().get(), std::memory_order_relaxed);
+            }
+            std::copy(data.begin(), data.end(), slot.data.load(std::memory_order_relaxed));
+            slot.src.store(uint8_t(topic_src), std::memory_order_relaxed);
+
+            /* Published after its buffer, which is at least that large from then on. */
+            slot.size.store(data.size(), std::memory_order_release);
+            slot.seq.store(seq << 1, std::memory_order_release);
+            write_count_.store(seq + 1);
+        }
+
+        if (0 < waiters_.load())
+        {
+            {
+                std::lock_guard<std::mutex> lock(wait_mtx_);
+            }
+            cv_.notify_all();
+        }
+
+        if (0 < callbacks_count_.load())
+        {
+            std::lock_guard<std::mutex> lock(callbacks_mtx_);
+            for (auto& callback : callbacks_)
+            {
+                callback.second();
+            }
+        }
         errcode = 0;
         rv = true;
     }
@@ -180,42 +437,38 @@ bool CedGlobalTopic::write(
 bool CedGlobalTopic::read(
         std::vector<uint8_t>& data,
         std::chrono::milliseconds timeout,
-        SeqNum& last_read,
+        uint64_t& next_read,
         ReadAccess read_access,
         uint8_t& errcode)
 {
-    bool rv = false;
-    std::unique_lock<std::mutex> lock(mtx_);
-    if (last_read != last_write_)
+    /* Try to read data without timeout. */
+    bool rv = get_data(data, next_read, read_access);
+
+    if (!rv && (std::chrono::milliseconds(0) < timeout) && shared_ring_)
     {
-        /* Fix last_read. */
-        if ((last_read <= (last_write_ - int(history_.size()))) || (last_read > last_write_))
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        while (!rv && shared_ring_->wait(next_read, deadline))
         {
-            last_read = last_write_ - int(history_.size());
+            rv = get_data(data, next_read, read_access);
         }
-
-        /* Try to read data without timeout. */
-        do
-        {
-            rv = get_data(data, last_read, read_access);
-        } while(!rv && (last_read != last_write_));
     }
-
-    if (!rv && (last_read == last_write_))
+    else if (!rv && (std::chrono::milliseconds(0) < timeout))
     {
         /* Try to read data with timeout in case. */
-        auto now = std::chrono::steady_clock::now();
-        if (cv_.wait_until(lock, now + std::chrono::milliseconds(timeout), [&](){
-                           return last_read != last_write_ && get_data(data, last_read, read_access); }))
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        std::unique_lock<std::mutex> lock(wait_mtx_);
+        ++waiters_;
+        while (!rv && cv_.wait_until(lock, deadline, [&](){ return next_read < write_count_.load(); }))
         {
-            rv = true;
-        }
-        else
-        {
-            errcode = 1;
+            rv = get_data(data, next_read, read_access);
         }
+        --waiters_;
     }
 
+    if (!rv)
+    {
+        errcode = 1;
+    }
     return rv;
 }
 
@@ -230,29 +483,81 @@ bool CedGlobalTopic::check_write_access(
 
 bool CedGlobalTopic::check_read_access(
         ReadAccess read_access,
-        size_t index)
+        TopicSource topic_src)
 {
     return (ReadAccess::COMPLETE == read_access) ||
-           ((ReadAccess::INTERNAL == read_access) && (TopicSource::INTERNAL == srcs_[index])) ||
-           ((ReadAccess::EXTERNAL == read_access) && (TopicSource::EXTERNAL == srcs_[index]));
+           ((ReadAccess::INTERNAL == read_access) && (TopicSource::INTERNAL == topic_src)) ||
+           ((ReadAccess::EXTERNAL == read_access) && (TopicSource::EXTERNAL == topic_src));
 }
 
 bool CedGlobalTopic::get_data(
         std::vector<uint8_t>& data,
-        SeqNum& last_read,
+        uint64_t& next_read,
         ReadAccess read_access)
 {
     bool rv = false;
-    size_t index = uint16_t(++last_read) % history_.size();
-    if (check_read_access(read_access, index))
+    if (shared_ring_)
     {
-        data.assign(history_[index].begin(), history_[index].end());
-        rv = true;
+        TopicSource topic_src;
+        while (!rv && shared_ring_->read(data, topic_src, next_read))
+        {
+            rv = check_read_access(read_access, topic_src);
+        }
+    }
+    else
+    {
+        uint64_t write_count = write_count_.load();
+        while (!rv && (next_read < write_count))
+        {
+            /* Samples overwritten before being read are lost. */
+            if (write_count - next_read > depth_)
+            {
+                next_read = write_count - depth_;
+            }
+
+            Slot& slot = history_[next_read % depth_];
+            const uint64_t seq = slot.seq.load(std::memory_order_acquire);
+            bool valid = ((next_read << 1) == seq);
+            if (valid)
+            {
+                const size_t size = slot.size.load(std::memory_order_acquire);
+                const uint8_t* buffer = slot.data.load(std::memory_order_relaxed);
+                const TopicSource topic_src = TopicSource(slot.src.load(std::memory_order_relaxed));
+                data.assign(buffer, buffer + size);
+                std::atomic_thread_fence(std::memory_order_acquire);
+                valid = (slot.seq.load(std::memory_order_relaxed) == seq);
+                rv = valid && check_read_access(read_access, topic_src);
+            }
+            ++next_read;
+
+            if (!valid)
+            {
+                /* Overwritten before or while being copied, catch up with the writers. */
+                write_count = write_count_.load();
+            }
+        }
     }
     return rv;
 }
 
 
+uint32_t CedGlobalTopic::add_data_available_callback(
+        std::function<void ()> callback)
+{
+    std::lock_guard<std::mutex> lock(callbacks_mtx_);
+    callbacks_.emplace(++last_callback_, std::move(callback));
+    callbacks_count_.store(callbacks_.size());
+    return last_callback_;
+}
+
+void CedGlobalTopic::remove_data_available_callback(
+        uint32_t id)
+{
+    std::lock_guard<std::mutex> lock(callbacks_mtx_);
+    callbacks_.erase(id);
+    callbacks_count_.store(callbacks_.size());
+}
+
 /**********************************************************************************************************************
  * CedParticipant
  **********************************************************************************************************************/
@@ -296,6 +601,13 @@ CedGlobalTopic* CedTopic::get_global_topic() const
 /**********************************************************************************************************************
  * CedDataWriter
  **********************************************************************************************************************/
+bool CedDataWriter::write(
+        const std::vector<uint8_t>& data)
+{
+    uint8_t errcode;
+    return write(data, errcode);
+}
+
 bool CedDataWriter::write(
         const std::vector<uint8_t>& data,
         uint8_t& errcode) const
@@ -306,12 +618,35 @@ bool CedDataWriter::write(
 /**********************************************************************************************************************
  * CedDataReader
  **********************************************************************************************************************/
+CedDataReader::~CedDataReader()
+{
+    set_data_available_callback(nullptr);
+}
+
 bool CedDataReader::read(
         std::vector<uint8_t>& data,
         std::chrono::milliseconds timeout,
         uint8_t &errcode)
 {
-    return topic_->get_global_topic()->read(data, timeout, last_read_, read_access_, errcode);
+    return topic_->get_global_topic()->read(data, timeout, next_read_, read_access_, errcode);
+}
+
+bool CedDataReader::set_data_available_callback(
+        std::function<void ()> callback)
+{
+    CedGlobalTopic* global_topic = topic_->get_global_topic();
+    if (0 != callback_id_)
+    {
+        global_topic->remove_data_available_callback(callback_id_);
+        callback_id_ = 0;
+    }
+
+    const bool rv = !global_topic->is_shared();
+    if (rv && callback)
+    {
+        callback_id_ = global_topic->add_data_available_callback(std::move(callback));
+    }
+    return rv;
 }
 
 } // namespace uxr
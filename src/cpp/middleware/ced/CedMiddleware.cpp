@@ -365,6 +365,13 @@ bool CedMiddleware::write_data(
     return rv;
 }
 
+Middleware::DataWriterHandle* CedMiddleware::get_datawriter_handle(
+        uint16_t datawriter_id)
+{
+    auto it = datawriters_.find(datawriter_id);
+    return (datawriters_.end() != it) ? it->second.get() : nullptr;
+}
+
 bool CedMiddleware::read_data(
         uint16_t datareader_id,
         std::vector<uint8_t>& data,
@@ -380,6 +387,22 @@ bool CedMiddleware::read_data(
     return rv;
 }
 
+/**********************************************************************************************************************
+ * Notification functions.
+ **********************************************************************************************************************/
+bool CedMiddleware::set_data_available_callback(
+        uint16_t datareader_id,
+        std::function<void ()> callback)
+{
+    bool rv = false;
+    auto it = datareaders_.find(datareader_id);
+    if (datareaders_.end() != it)
+    {
+        rv = it->second->set_data_available_callback(std::move(callback));
+    }
+    return rv;
+}
+
 /**********************************************************************************************************************
  * Matched functions.
  **********************************************************************************************************************/
@@ -0,0 +1,406 @@
+// Copyright 2019 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <uxr/agent/middleware/ced/CedSharedRing.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace eprosima {
+namespace uxr {
+
+namespace {
+
+constexpr uint32_t ring_magic = 0x55584345; // UXCE
+constexpr size_t max_topic_name = 256;
+constexpr size_t slot_alignment = 64;
+
+enum RingState : uint32_t
+{
+    RING_UNINITIALIZED = 0,
+    RING_READY = 1
+};
+
+/* Stable across processes and builds, unlike std::hash. */
+uint64_t fnv1a(
+        const std::string& str)
+{
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (char c : str)
+    {
+        hash = (hash ^ uint8_t(c)) * 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+std::string get_segment_name(
+        const std::string& topic_name,
+        int16_t domain_id)
+{
+    char name[64];
+    std::snprintf(name, sizeof(name), "/uxr_ced_%d_%016llx",
+        int(domain_id), static_cast<unsigned long long>(fnv1a(topic_name)));
+    return name;
+}
+
+size_t get_segment_size(
+        int fd)
+{
+    struct stat st;
+    return (0 == fstat(fd, &st)) ? size_t(st.st_size) : 0;
+}
+
+int futex(
+        std::atomic<uint32_t>* word,
+        int op,
+        uint32_t value,
+        const struct timespec* timeout)
+{
+    static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "futex word must be 32 bits");
+    return int(syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), op, value, timeout, nullptr, 0));
+}
+
+/* A writer that died holding the mutex left at most an unfinished slot, which is written again. */
+void lock_robust(
+        pthread_mutex_t* mtx)
+{
+    if (EOWNERDEAD == pthread_mutex_lock(mtx))
+    {
+        pthread_mutex_consistent(mtx);
+    }
+}
+
+} // unnamed namespace
+
+struct CedSharedRing::Header
+{
+    std::atomic<uint32_t> state;
+    uint32_t magic;
+    uint32_t depth;
+    uint32_t slot_size;
+    uint32_t slot_stride;
+    char topic_name[max_topic_name];
+
+    /* Guards the writers and the users count. */
+    pthread_mutex_t mtx;
+    uint32_t users;
+    uint32_t unlinked;
+
+    std::atomic<uint64_t> write_count;
+    std::atomic<uint32_t> futex_word;
+    std::atomic<uint32_t> waiters;
+};
+
+/* Holds sample seq when (seq << 1) is stored, ((seq << 1) | 1) while it is being written. */
+struct CedSharedRing::Slot
+{
+    std::atomic<uint64_t> seq;
+    uint32_t size;
+    uint8_t src;
+    uint8_t data[1];
+};
+
+std::unique_ptr<CedSharedRing> CedSharedRing::open(
+        const std::string& topic_name,
+        int16_t domain_id,
+        uint16_t depth,
+        uint32_t slot_size)
+{
+    std::unique_ptr<CedSharedRing> ring;
+    const std::string name = get_segment_name(topic_name, domain_id);
+    const uint32_t slot_stride =
+        uint32_t((offsetof(Slot, data) + slot_size + slot_alignment - 1) / slot_alignment * slot_alignment);
+    const size_t header_size = (sizeof(Header) + slot_alignment - 1) / slot_alignment * slot_alignment;
+
+    /* A segment being removed by its last user is opened again. */
+    for (int attempt = 0; !ring && (attempt < 3) && (topic_name.size() < max_topic_name) && (0 < depth); ++attempt)
+    {
+        /* Only the creator sizes the segment, and does it before anybody may map it. */
+        bool creator = true;
+        int fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0660);
+        if (-1 == fd)
+        {
+            creator = false;
+            fd = (EEXIST == errno) ? shm_open(name.c_str(), O_RDWR, 0660) : -1;
+        }
+        else if (0 != ftruncate(fd, off_t(header_size + size_t(depth) * slot_stride)))
+        {
+            shm_unlink(name.c_str());
+            close(fd);
+            fd = -1;
+        }
+
+        if (-1 == fd)
+        {
+            /* Removed between both calls. */
+            if (!creator && (ENOENT == errno))
+            {
+                continue;
+            }
+            break;
+        }
+
+        /* The creator may still be sizing it, map only what it already holds. */
+        size_t size = get_segment_size(fd);
+        for (int i = 0; (size < header_size) && (i < 1000); ++i)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            size = get_segment_size(fd);
+        }
+
+        void* address = (header_size <= size)
+            ? mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0)
+            : MAP_FAILED;
+        if (MAP_FAILED == address)
+        {
+            close(fd);
+            break;
+        }
+
+        Header* header = reinterpret_cast<Header*>(address);
+        if (creator)
+        {
+            header->magic = ring_magic;
+            header->depth = depth;
+            header->slot_size = slot_size;
+            header->slot_stride = slot_stride;
+            std::strncpy(header->topic_name, topic_name.c_str(), max_topic_name - 1);
+
+            pthread_mutexattr_t attr;
+            pthread_mutexattr_init(&attr);
+            pthread_mutexattr_setpshared(&attr, PTHREAD_PROCESS_SHARED);
+            pthread_mutexattr_setrobust(&attr, PTHREAD_MUTEX_ROBUST);
+            pthread_mutex_init(&header->mtx, &attr);
+            pthread_mutexattr_destroy(&attr);
+
+            header->users = 0;
+            header->unlinked = 0;
+            header->write_count = 0;
+            header->futex_word = 0;
+            header->waiters = 0;
+            header->state.store(RING_READY, std::memory_order_release);
+        }
+        else
+        {
+            for (int i = 0; (RING_READY != header->state.load(std::memory_order_acquire)) && (i < 1000); ++i)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+
+            /* The ring keeps the parameters of its creator, map all of its slots. */
+            const size_t ring_size = header_size + size_t(header->depth) * header->slot_stride;
+            if ((RING_READY == header->state.load(std::memory_order_acquire)) && (ring_magic == header->magic) &&
+                (size < ring_size) && (ring_size <= get_segment_size(fd)))
+            {
+                munmap(address, size);
+                size = ring_size;
+                address = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+                if (MAP_FAILED == address)
+                {
+                    close(fd);
+                    break;
+                }
+                header = reinterpret_cast<Header*>(address);
+            }
+        }
+
+        bool attached = false;
+        if ((RING_READY == header->state.load(std::memory_order_acquire)) && (ring_magic == header->magic) &&
+            (size >= header_size + size_t(header->depth) * header->slot_stride) &&
+            (0 == std::strncmp(header->topic_name, topic_name.c_str(), max_topic_name)))
+        {
+            lock_robust(&header->mtx);
+            if (0 == header->unlinked)
+            {
+                ++header->users;
+                attached = true;
+            }
+            pthread_mutex_unlock(&header->mtx);
+        }
+
+        if (attached)
+        {
+            ring.reset(new CedSharedRing(name, fd, address, size));
+        }
+        else
+        {
+            const bool retry = (RING_READY == header->state.load()) && (0 != header->unlinked);
+            munmap(address, size);
+            close(fd);
+            if (!retry)
+            {
+                break;
+            }
+        }
+    }
+    return ring;
+}
+
+CedSharedRing::CedSharedRing(
+        const std::string& name,
+        int fd,
+        void* address,
+        size_t size)
+    : name_(name)
+    , fd_(fd)
+    , address_(address)
+    , size_(size)
+    , header_(reinterpret_cast<Header*>(address))
+{
+}
+
+CedSharedRing::~CedSharedRing()
+{
+    lock_robust(&header_->mtx);
+    if (0 == --header_->users)
+    {
+        header_->unlinked = 1;
+        shm_unlink(name_.c_str());
+    }
+    pthread_mutex_unlock(&header_->mtx);
+
+    munmap(address_, size_);
+    close(fd_);
+}
+
+uint16_t CedSharedRing::depth() const
+{
+    return uint16_t(header_->depth);
+}
+
+uint32_t CedSharedRing::slot_size() const
+{
+    return header_->slot_size;
+}
+
+CedSharedRing::Slot& CedSharedRing::get_slot(
+        uint64_t seq)
+{
+    const size_t header_size = (sizeof(Header) + slot_alignment - 1) / slot_alignment * slot_alignment;
+    uint8_t* slots = reinterpret_cast<uint8_t*>(address_) + header_size;
+    return *reinterpret_cast<Slot*>(slots + (seq % header_->depth) * header_->slot_stride);
+}
+
+bool CedSharedRing::write(
+        const std::vector<uint8_t>& data,
+        TopicSource topic_src)
+{
+    bool rv = false;
+    if (data.size() <= header_->slot_size)
+    {
+        lock_robust(&header_->mtx);
+        const uint64_t seq = header_->write_count.load();
+        Slot& slot = get_slot(seq);
+        slot.seq.store((seq << 1) | 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        slot.size = uint32_t(data.size());
+        slot.src = uint8_t(topic_src);
+        std::memcpy(slot.data, data.data(), data.size());
+        slot.seq.store(seq << 1, std::memory_order_release);
+        header_->write_count.store(seq + 1);
+        pthread_mutex_unlock(&header_->mtx);
+
+        header_->futex_word.fetch_add(1);
+        if (0 < header_->waiters.load())
+        {
+            futex(&header_->futex_word, FUTEX_WAKE, INT_MAX, nullptr);
+        }
+        rv = true;
+    }
+    return rv;
+}
+
+bool CedSharedRing::read(
+        std::vector<uint8_t>& data,
+        TopicSource& topic_src,
+        uint64_t& next_read)
+{
+    bool rv = false;
+    uint64_t write_count = header_->write_count.load();
+    while (!rv && (next_read < write_count))
+    {
+        /* Samples overwritten before being read are lost. */
+        if (write_count - next_read > header_->depth)
+        {
+            next_read = write_count - header_->depth;
+        }
+
+        Slot& slot = get_slot(next_read);
+        const uint64_t seq = slot.seq.load(std::memory_order_acquire);
+        if ((next_read << 1) == seq)
+        {
+            const uint32_t size = std::min(slot.size, header_->slot_size);
+            data.resize(size);
+            std::memcpy(data.data(), slot.data, size);
+            topic_src = TopicSource(slot.src);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            rv = (slot.seq.load(std::memory_order_relaxed) == seq);
+        }
+
+        /* Overwritten before or while being copied, or being overwritten by a writer that may have died:
+         * the sample is lost, go on with the next one. */
+        ++next_read;
+        if (!rv)
+        {
+            write_count = header_->write_count.load();
+        }
+    }
+    return rv;
+}
+
+bool CedSharedRing::wait(
+        uint64_t next_read,
+        std::chrono::steady_clock::time_point deadline)
+{
+    using namespace std::chrono;
+
+    bool rv = (next_read < header_->write_count.load());
+    steady_clock::time_point now = steady_clock::now();
+    while (!rv && (now < deadline))
+    {
+        const uint32_t futex_word = header_->futex_word.load();
+        header_->waiters.fetch_add(1);
+        rv = (next_read < header_->write_count.load());
+        if (!rv)
+        {
+            /* Bounded wait, a writer may die before waking anybody up. */
+            const nanoseconds remaining = duration_cast<nanoseconds>(deadline - now);
+            struct timespec timeout;
+            timeout.tv_sec = time_t(remaining.count() / 1000000000);
+            timeout.tv_nsec = long(remaining.count() % 1000000000);
+            futex(&header_->futex_word, FUTEX_WAIT, futex_word, &timeout);
+            rv = (next_read < header_->write_count.load());
+        }
+        header_->waiters.fetch_sub(1);
+        now = steady_clock::now();
+    }
+    return rv;
+}
+
+} // namespace uxr
+} // namespace eprosima
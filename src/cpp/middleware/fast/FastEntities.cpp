@@ -97,6 +97,32 @@ void FastListener::onSubscriptionMatched(
     }
 }
 
+void FastListener::onNewDataMessage(
+        fastrtps::Subscriber* subscriber)
+{
+    std::lock_guard<std::mutex> lock(callbacks_mtx_);
+    auto it = callbacks_.find(subscriber);
+    if (callbacks_.end() != it)
+    {
+        it->second();
+    }
+}
+
+void FastListener::set_data_available_callback(
+        const fastrtps::Subscriber* subscriber,
+        std::function<void ()> callback)
+{
+    std::lock_guard<std::mutex> lock(callbacks_mtx_);
+    if (callback)
+    {
+        callbacks_[subscriber] = std::move(callback);
+    }
+    else
+    {
+        callbacks_.erase(subscriber);
+    }
+}
+
 /**********************************************************************************************************************
  * FastParticipant
  **********************************************************************************************************************/
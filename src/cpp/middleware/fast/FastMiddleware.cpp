@@ -625,6 +625,7 @@ bool FastMiddleware::delete_datareader(
             datareader->get_participant(),
             datareader->get_ptr());
 
+        listener_.set_data_available_callback(datareader->get_ptr(), nullptr);
         datareaders_.erase(datareader_id);
         return true;
     }
@@ -647,6 +648,7 @@ bool FastMiddleware::delete_requester(
             requester->get_request_datawriter(),
             requester->get_reply_datareader());
 
+        listener_.set_data_available_callback(requester->get_reply_datareader(), nullptr);
         requesters_.erase(requester_id);
         return true;
     }
@@ -669,6 +671,7 @@ bool FastMiddleware::delete_replier(
             replier->get_reply_datawriter(),
             replier->get_request_datareader());
 
+        listener_.set_data_available_callback(replier->get_request_datareader(), nullptr);
         repliers_.erase(replier_id);
         return true;
     }
@@ -690,6 +693,13 @@ bool FastMiddleware::write_data(
     return rv;
 }
 
+Middleware::DataWriterHandle* FastMiddleware::get_datawriter_handle(
+        uint16_t datawriter_id)
+{
+    auto it = datawriters_.find(datawriter_id);
+    return (datawriters_.end() != it) ? it->second.get() : nullptr;
+}
+
 bool FastMiddleware::write_request(
         uint16_t requester_id,
         uint32_t sequence_number,
@@ -731,6 +741,29 @@ bool FastMiddleware::read_data(
     return rv;
 }
 
+bool FastMiddleware::read_timestamped_data(
+        uint16_t datareader_id,
+        std::vector<uint8_t>& data,
+        std::chrono::system_clock::time_point& source_timestamp,
+        std::chrono::milliseconds timeout)
+{
+    bool rv = false;
+    auto it = datareaders_.find(datareader_id);
+    if (datareaders_.end() != it)
+    {
+        fastrtps::SampleInfo_t info;
+        rv = it->second->read(data, info, timeout);
+        if (rv)
+        {
+            source_timestamp = std::chrono::system_clock::time_point(
+                std::chrono::duration_cast<std::chrono::system_clock::duration>(
+                    std::chrono::seconds(info.sourceTimestamp.seconds())
+                    + std::chrono::nanoseconds(info.sourceTimestamp.nanosec())));
+        }
+    }
+    return rv;
+}
+
 bool FastMiddleware::read_request(
         uint16_t replier_id,
         std::vector<uint8_t>& data,
@@ -760,6 +793,51 @@ bool FastMiddleware::read_reply(
     return rv;
 }
 
+/**********************************************************************************************************************
+ * Notification functions.
+ **********************************************************************************************************************/
+bool FastMiddleware::set_data_available_callback(
+        uint16_t datareader_id,
+        std::function<void ()> callback)
+{
+    bool rv = false;
+    auto it = datareaders_.find(datareader_id);
+    if (datareaders_.end() != it)
+    {
+        listener_.set_data_available_callback(it->second->get_ptr(), std::move(callback));
+        rv = true;
+    }
+    return rv;
+}
+
+bool FastMiddleware::set_reply_available_callback(
+        uint16_t requester_id,
+        std::function<void ()> callback)
+{
+    bool rv = false;
+    auto it = requesters_.find(requester_id);
+    if (requesters_.end() != it)
+    {
+        listener_.set_data_available_callback(it->second->get_reply_datareader(), std::move(callback));
+        rv = true;
+    }
+    return rv;
+}
+
+bool FastMiddleware::set_request_available_callback(
+        uint16_t replier_id,
+        std::function<void ()> callback)
+{
+    bool rv = false;
+    auto it = repliers_.find(replier_id);
+    if (repliers_.end() != it)
+    {
+        listener_.set_data_available_callback(it->second->get_request_datareader(), std::move(callback));
+        rv = true;
+    }
+    return rv;
+}
+
 /**********************************************************************************************************************
  * Matched functions.
  **********************************************************************************************************************/
@@ -18,16 +18,25 @@
 #include <fastdds/dds/subscriber/qos/DataReaderQos.hpp>
 #include <fastdds/dds/subscriber/SampleInfo.hpp>
 #include <fastdds/dds/topic/TypeSupport.hpp>
+#include <fastdds/rtps/flowcontrol/FlowControllerDescriptor.hpp>
+#include <fastdds/rtps/transport/shared_mem/SharedMemTransportDescriptor.h>
+#include <fastdds/rtps/transport/UDPv4TransportDescriptor.h>
 #include <fastcdr/FastBuffer.h>
 #include <fastcdr/Cdr.h>
 #include "../../xmlobjects/xmlobjects.h"
 
+#include <algorithm>
+#include <cstring>
+
 namespace eprosima {
 namespace uxr {
 
 using namespace fastrtps::xmlparser;
 using eprosima::fastrtps::types::ReturnCode_t;
 
+/* Serialized dds::SampleIdentity: GUID and sequence number. */
+static constexpr size_t sample_identity_size = 24;
+
 static void set_qos_from_attributes(
         fastdds::dds::DomainParticipantQos& qos,
         const fastrtps::rtps::RTPSParticipantAttributes& attr)
@@ -103,6 +112,7 @@ static void set_qos_from_attributes(
     qos.destination_order() = attr.qos.m_destinationOrder;
     qos.representation() = attr.qos.representation;
     qos.publish_mode() = attr.qos.m_publishMode;
+    qos.data_sharing() = attr.qos.data_sharing;
     qos.history() = attr.topic.historyQos;
     qos.resource_limits() = attr.topic.resourceLimitsQos;
 }
@@ -135,6 +145,7 @@ static void set_qos_from_attributes(
     qos.type_consistency().type_consistency = attr.qos.type_consistency;
     qos.type_consistency().representation = attr.qos.representation;
     qos.time_based_filter() = attr.qos.m_timeBasedFilter;
+    qos.data_sharing() = attr.qos.data_sharing;
     qos.history() = attr.topic.historyQos;
     qos.resource_limits() = attr.topic.resourceLimitsQos;
 }
@@ -355,6 +366,88 @@ static void set_qos_from_xrce_object(
     return;
 }
 
+/**********************************************************************************************************************
+ * FastDDSPublishMode
+ **********************************************************************************************************************/
+constexpr const char* FastDDSPublishMode::flow_controller_name;
+
+FastDDSPublishMode& FastDDSPublishMode::get_default()
+{
+    static FastDDSPublishMode publish_mode;
+    return publish_mode;
+}
+
+static void add_flow_controller(
+        fastdds::dds::DomainParticipantQos& qos)
+{
+    const FastDDSPublishMode& publish_mode = FastDDSPublishMode::get_default();
+    if (publish_mode.asynchronous && (0 < publish_mode.max_bytes_per_period))
+    {
+        auto descriptor = std::make_shared<fastdds::rtps::FlowControllerDescriptor>();
+        descriptor->name = FastDDSPublishMode::flow_controller_name;
+        descriptor->scheduler = publish_mode.scheduler;
+        descriptor->max_bytes_per_period = publish_mode.max_bytes_per_period;
+        descriptor->period_ms = publish_mode.period_ms;
+        qos.flow_controllers().push_back(descriptor);
+    }
+}
+
+static void set_publish_mode(
+        fastdds::dds::DataWriterQos& qos,
+        const fastdds::dds::DomainParticipantQos& participant_qos,
+        const std::string& topic_name)
+{
+    /* A publisher profile named after the topic selects its mode, otherwise the agent default applies. */
+    const FastDDSPublishMode& publish_mode = FastDDSPublishMode::get_default();
+    fastrtps::PublisherAttributes attrs;
+    if (fastdds::dds::SYNCHRONOUS_PUBLISH_MODE != qos.publish_mode().kind)
+    {
+        /* Explicitly asynchronous profiles are kept. */
+    }
+    else if (XMLP_ret::XML_OK == XMLProfileManager::fillPublisherAttributes(topic_name, attrs, false))
+    {
+        qos.publish_mode() = attrs.qos.m_publishMode;
+    }
+    else if (publish_mode.asynchronous)
+    {
+        /* Participants created from a reference may lack the agent flow controller. */
+        const auto& controllers = participant_qos.flow_controllers();
+        bool registered = std::any_of(controllers.begin(), controllers.end(),
+                [](const std::shared_ptr<fastdds::rtps::FlowControllerDescriptor>& descriptor)
+                {
+                    return 0 == std::strcmp(descriptor->name, FastDDSPublishMode::flow_controller_name);
+                });
+
+        qos.publish_mode().kind = fastdds::dds::ASYNCHRONOUS_PUBLISH_MODE;
+        qos.publish_mode().flow_controller_name =
+            registered ? FastDDSPublishMode::flow_controller_name : FASTDDS_FLOW_CONTROLLER_DEFAULT;
+    }
+}
+
+/**********************************************************************************************************************
+ * FastDDSTransports
+ **********************************************************************************************************************/
+FastDDSTransports& FastDDSTransports::get_default()
+{
+    static FastDDSTransports transports;
+    return transports;
+}
+
+static void set_transports(
+        fastdds::dds::DomainParticipantQos& qos)
+{
+    /* Participants with user transports keep them. */
+    const FastDDSTransports& transports = FastDDSTransports::get_default();
+    if ((0 < transports.shm_segment_size) && qos.transport().use_builtin_transports)
+    {
+        auto shm_transport = std::make_shared<fastdds::rtps::SharedMemTransportDescriptor>();
+        shm_transport->segment_size(transports.shm_segment_size);
+        qos.transport().user_transports.push_back(shm_transport);
+        qos.transport().user_transports.push_back(std::make_shared<fastdds::rtps::UDPv4TransportDescriptor>());
+        qos.transport().use_builtin_transports = false;
+    }
+}
+
 /**********************************************************************************************************************
  * FastDDSParticipant
  **********************************************************************************************************************/
@@ -378,7 +471,20 @@ bool FastDDSParticipant::create_by_ref(
     bool rv = false;
     if (nullptr == ptr_)
     {
-        ptr_ = factory_->create_participant_with_profile(domain_id_, ref);
+        fastrtps::ParticipantAttributes attrs;
+        if (0 == FastDDSTransports::get_default().shm_segment_size)
+        {
+            ptr_ = factory_->create_participant_with_profile(domain_id_, ref);
+        }
+        else if (XMLP_ret::XML_OK == XMLProfileManager::fillParticipantAttributes(ref, attrs))
+        {
+            /* The agent transports are set on the QoS of the profile, as for XML participants. */
+            fastdds::dds::DomainParticipantQos qos = factory_->get_default_participant_qos();
+            set_qos_from_attributes(qos, attrs.rtps);
+            qos.flow_controllers() = attrs.rtps.flow_controllers;
+            set_transports(qos);
+            ptr_ = factory_->create_participant(domain_id_, qos);
+        }
         rv = (nullptr != ptr_);
     }
     return rv;
@@ -395,6 +501,9 @@ bool FastDDSParticipant::create_by_xml(
         {
             fastdds::dds::DomainParticipantQos qos = factory_->get_default_participant_qos();
             set_qos_from_attributes(qos, attrs.rtps);
+            qos.flow_controllers() = attrs.rtps.flow_controllers;
+            add_flow_controller(qos);
+            set_transports(qos);
             ptr_ = factory_->create_participant(domain_id_, qos);
         }
         rv = (nullptr != ptr_);
@@ -410,6 +519,8 @@ bool FastDDSParticipant::create_by_bin(
     {
         fastdds::dds::DomainParticipantQos qos = factory_->get_default_participant_qos();
         set_qos_from_xrce_object(qos, participant_xrce);
+        add_flow_controller(qos);
+        set_transports(qos);
         ptr_ = factory_->create_participant(domain_id_, qos);
         rv = (nullptr != ptr_);
     }
@@ -579,6 +690,7 @@ bool FastDDSParticipant::register_local_type(
         const std::shared_ptr<FastDDSType>& type)
 {
     fastdds::dds::TypeSupport& type_support = type->get_type_support();
+    std::lock_guard<std::mutex> lock(register_mtx_);
     return ReturnCode_t::RETCODE_OK == ptr_->register_type(type_support, type_support->getName())
         && type_register_.emplace(type_support->getName(), type).second;
 }
@@ -586,6 +698,7 @@ bool FastDDSParticipant::register_local_type(
 bool FastDDSParticipant::unregister_local_type(
         const std::string& type_name)
 {
+    std::lock_guard<std::mutex> lock(register_mtx_);
     return (1 == type_register_.erase(type_name));
 }
 
@@ -593,6 +706,7 @@ std::shared_ptr<FastDDSType> FastDDSParticipant::find_local_type(
         const std::string& type_name) const
 {
     std::shared_ptr<FastDDSType> type;
+    std::lock_guard<std::mutex> lock(register_mtx_);
     auto it = type_register_.find(type_name);
     if (it != type_register_.end())
     {
@@ -604,6 +718,7 @@ std::shared_ptr<FastDDSType> FastDDSParticipant::find_local_type(
 bool FastDDSParticipant::register_local_topic(
             const std::shared_ptr<FastDDSTopic>& topic)
 {
+    std::lock_guard<std::mutex> lock(register_mtx_);
     return topic_register_.emplace(topic->get_name(), topic).second;
 }
 
@@ -611,6 +726,7 @@ bool FastDDSParticipant::unregister_local_topic(
         const std::string& topic_name)
 {
     ptr_->unregister_type(topic_name);
+    std::lock_guard<std::mutex> lock(register_mtx_);
     return (1 == topic_register_.erase(topic_name));
 }
 
@@ -618,6 +734,7 @@ std::shared_ptr<FastDDSTopic> FastDDSParticipant::find_local_topic(
         const std::string& topic_name) const
 {
     std::shared_ptr<FastDDSTopic> topic;
+    std::lock_guard<std::mutex> lock(register_mtx_);
     auto it = topic_register_.find(topic_name);
     if (it != topic_register_.end())
     {
@@ -911,6 +1028,7 @@ bool FastDDSDataWriter::create_by_ref(const std::string& ref)
             if(topic_){
                 fastdds::dds::DataWriterQos qos;
                 set_qos_from_attributes(qos, attrs);
+                set_publish_mode(qos, publisher_->get_participant()->get_ptr()->get_qos(), attrs.topic.topicName.to_string());
 
                 ptr_ = publisher_->create_datawriter(topic_->get_ptr(), qos);
                 rv = (nullptr != ptr_) && bool(topic_);
@@ -931,6 +1049,7 @@ bool FastDDSDataWriter::create_by_xml(const std::string& xml)
             if(topic_){
                 fastdds::dds::DataWriterQos qos;
                 set_qos_from_attributes(qos, attrs);
+                set_publish_mode(qos, publisher_->get_participant()->get_ptr()->get_qos(), attrs.topic.topicName.to_string());
 
                 ptr_ = publisher_->create_datawriter(topic_->get_ptr(), qos);
                 rv = (nullptr != ptr_) && bool(topic_);
@@ -950,6 +1069,7 @@ bool FastDDSDataWriter::create_by_bin(
         if(topic_){
             fastdds::dds::DataWriterQos qos = fastdds::dds::DATAWRITER_QOS_DEFAULT;
             set_qos_from_xrce_object(qos, datawriter_xrce);
+            set_publish_mode(qos, publisher_->get_participant()->get_ptr()->get_qos(), topic_->get_name());
             ptr_ = publisher_->create_datawriter(topic_->get_ptr(), qos);
             rv = (nullptr != ptr_) && bool(topic_);
         }
@@ -961,6 +1081,7 @@ bool FastDDSDataWriter::match(const fastrtps::PublisherAttributes& attrs) const
 {
     fastdds::dds::DataWriterQos qos;
     set_qos_from_attributes(qos, attrs);
+    set_publish_mode(qos, publisher_->get_participant()->get_ptr()->get_qos(), attrs.topic.topicName.to_string());
     return (ptr_->get_qos() == qos);
 }
 
@@ -969,6 +1090,7 @@ bool FastDDSDataWriter::match_from_bin(const dds::xrce::OBJK_DataWriter_Binary&
 {
     fastdds::dds::DataWriterQos qos;
     set_qos_from_xrce_object(qos, datawriter_xrce);
+    set_publish_mode(qos, publisher_->get_participant()->get_ptr()->get_qos(), topic_->get_name());
     return (ptr_->get_qos() == qos);
 }
 
@@ -994,6 +1116,7 @@ FastDDSDataReader::~FastDDSDataReader()
 {
     if (ptr_)
     {
+        ptr_->set_listener(nullptr);
         subscriber_->delete_datareader(ptr_);
     }
 }
@@ -1110,10 +1233,14 @@ bool FastDDSDataReader::read(
 
     bool rv = false;
 
+    /* One sample per call: batches take no more than they carry, the rest stays in the DDS history. */
     fastrtps::Duration_t d((long double) timeout.count()/1000.0);
-
-    if(ptr_->wait_for_unread_message(d)){
-        rv = ReturnCode_t::RETCODE_OK == ptr_->take_next_sample(&data, &sample_info);
+    if (ptr_->wait_for_unread_message(d))
+    {
+        while (!rv && (ReturnCode_t::RETCODE_OK == ptr_->take_next_sample(&data, &sample_info)))
+        {
+            rv = sample_info.valid_data;
+        }
     }
 
     return rv;
@@ -1129,6 +1256,171 @@ const fastdds::dds::DomainParticipant* FastDDSDataReader::participant() const
     return subscriber_->get_participant()->get_ptr();
 }
 
+uint32_t FastDDSDataReader::add_data_available_callback(
+        std::function<void ()> callback)
+{
+    std::lock_guard<std::mutex> lock(callbacks_mtx_);
+    if (callbacks_.empty())
+    {
+        ptr_->set_listener(&listener_, fastdds::dds::StatusMask::data_available());
+    }
+    callbacks_.emplace(++last_callback_, std::move(callback));
+    return last_callback_;
+}
+
+void FastDDSDataReader::remove_data_available_callback(
+        uint32_t id)
+{
+    std::lock_guard<std::mutex> lock(callbacks_mtx_);
+    callbacks_.erase(id);
+}
+
+void FastDDSDataReader::Listener::on_data_available(
+        fastdds::dds::DataReader* /*reader*/)
+{
+    std::lock_guard<std::mutex> lock(owner_.callbacks_mtx_);
+    for (auto& callback : owner_.callbacks_)
+    {
+        callback.second();
+    }
+}
+
+/**********************************************************************************************************************
+ * FastDDSReaderFanOut
+ **********************************************************************************************************************/
+FastDDSReaderFanOut::FastDDSReaderFanOut(
+        const std::shared_ptr<FastDDSDataReader>& reader,
+        const fastdds::dds::SubscriberQos& subscriber_qos)
+    : reader_{reader}
+    , subscriber_qos_{subscriber_qos}
+    , max_queued_{1}
+    , mtx_{}
+    , cv_{}
+    , taking_{false}
+    , last_subscription_{0}
+    , queues_{}
+{
+    /* Queues are bounded like the reader's own history so a stalled client cannot grow memory. */
+    const fastdds::dds::HistoryQosPolicy& history = reader_->ptr()->get_qos().history();
+    if (0 < history.depth)
+    {
+        max_queued_ = static_cast<size_t>(history.depth);
+    }
+}
+
+uint32_t FastDDSReaderFanOut::subscribe()
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    queues_.emplace(++last_subscription_, std::deque<Sample>{});
+    return last_subscription_;
+}
+
+void FastDDSReaderFanOut::unsubscribe(
+        uint32_t subscription)
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    queues_.erase(subscription);
+}
+
+bool FastDDSReaderFanOut::read(
+        uint32_t subscription,
+        std::vector<uint8_t>& data,
+        std::chrono::milliseconds timeout,
+        fastrtps::rtps::GUID_t& writer_guid,
+        std::chrono::system_clock::time_point& source_timestamp)
+{
+    bool rv = false;
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+
+    std::unique_lock<std::mutex> lock(mtx_);
+    auto it = queues_.find(subscription);
+    while (queues_.end() != it && it->second.empty())
+    {
+        auto now = std::chrono::steady_clock::now();
+        if (taking_)
+        {
+            if (now >= deadline)
+            {
+                break;
+            }
+            cv_.wait_until(lock, deadline);
+        }
+        else
+        {
+            /* Take at least once, a zero timeout is a non-blocking poll. */
+            taking_ = true;
+            lock.unlock();
+
+            std::vector<uint8_t> sample_data;
+            fastdds::dds::SampleInfo sample_info;
+            bool taken = reader_->read(
+                sample_data,
+                (now < deadline)
+                    ? std::chrono::duration_cast<std::chrono::milliseconds>(deadline - now)
+                    : std::chrono::milliseconds(0),
+                sample_info);
+
+            lock.lock();
+            taking_ = false;
+            if (taken)
+            {
+                Sample sample{
+                    std::make_shared<const std::vector<uint8_t>>(std::move(sample_data)),
+                    sample_info.sample_identity.writer_guid(),
+                    to_time_point(sample_info.source_timestamp)};
+                for (auto& queue : queues_)
+                {
+                    if (max_queued_ <= queue.second.size())
+                    {
+                        queue.second.pop_front();
+                    }
+                    queue.second.push_back(sample);
+                }
+            }
+            cv_.notify_all();
+
+            if (!taken && (std::chrono::steady_clock::now() >= deadline))
+            {
+                it = queues_.find(subscription);
+                break;
+            }
+        }
+        it = queues_.find(subscription);
+    }
+
+    if (queues_.end() != it && !it->second.empty())
+    {
+        Sample& sample = it->second.front();
+        data = *sample.data;
+        writer_guid = sample.writer_guid;
+        source_timestamp = sample.source_timestamp;
+        it->second.pop_front();
+        rv = true;
+    }
+
+    return rv;
+}
+
+/**********************************************************************************************************************
+ * FastDDSNotifier
+ **********************************************************************************************************************/
+void FastDDSNotifier::set_callback(
+        std::function<void ()> callback)
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    callback_ = std::move(callback);
+}
+
+void FastDDSNotifier::on_data_available(
+        fastdds::dds::DataReader* /*reader*/)
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    if (callback_)
+    {
+        callback_();
+    }
+}
+
 /**********************************************************************************************************************
  * FastDDSRequester
  **********************************************************************************************************************/
@@ -1163,7 +1455,8 @@ bool FastDDSRequester::create_by_attributes(
 
     fastdds::dds::DataReaderQos qos_datareader;
     set_qos_from_attributes(qos_datareader, attrs.subscriber);
-    datareader_ptr_ = subscriber_ptr_->create_datareader(reply_topic_->get_ptr(), qos_datareader);
+    datareader_ptr_ = subscriber_ptr_->create_datareader(
+        reply_topic_->get_ptr(), qos_datareader, &notifier_, fastdds::dds::StatusMask::data_available());
 
     rv = (nullptr != publisher_ptr_) && (nullptr != datawriter_ptr_) &&
          (nullptr != subscriber_ptr_) && (nullptr != datareader_ptr_);
@@ -1318,6 +1611,12 @@ const fastdds::dds::DataReader* FastDDSRequester::get_reply_datareader() const
     return datareader_ptr_;
 }
 
+void FastDDSRequester::set_data_available_callback(
+        std::function<void ()> callback)
+{
+    notifier_.set_callback(std::move(callback));
+}
+
 /**********************************************************************************************************************
  * FastDDSReplier
  **********************************************************************************************************************/
@@ -1352,7 +1651,8 @@ bool FastDDSReplier::create_by_attributes(
 
     fastdds::dds::DataReaderQos qos_datareader;
     set_qos_from_attributes(qos_datareader, attrs.subscriber);
-    datareader_ptr_ = subscriber_ptr_->create_datareader(request_topic_->get_ptr(), qos_datareader);
+    datareader_ptr_ = subscriber_ptr_->create_datareader(
+        request_topic_->get_ptr(), qos_datareader, &notifier_, fastdds::dds::StatusMask::data_available());
 
     rv = (nullptr != publisher_ptr_) && (nullptr != datawriter_ptr_) &&
          (nullptr != subscriber_ptr_) && (nullptr != datareader_ptr_);
@@ -1429,19 +1729,29 @@ void FastDDSReplier::transport_sample_identity(
 bool FastDDSReplier::write(
         const std::vector<uint8_t>& data)
 {
-    fastcdr::FastBuffer fastbuffer{reinterpret_cast<char*>(const_cast<uint8_t*>(data.data())), data.size()};
-    fastcdr::Cdr deserializer(fastbuffer, eprosima::fastcdr::Cdr::DEFAULT_ENDIAN, eprosima::fastcdr::CdrVersion::XCDRv1);
+    bool rv = false;
+    try
+    {
+        fastcdr::FastBuffer fastbuffer{reinterpret_cast<char*>(const_cast<uint8_t*>(data.data())), data.size()};
+        fastcdr::Cdr deserializer(fastbuffer, eprosima::fastcdr::Cdr::DEFAULT_ENDIAN, eprosima::fastcdr::CdrVersion::XCDRv1);
 
-    dds::SampleIdentity sample_identity;
-    sample_identity.deserialize(deserializer);
+        dds::SampleIdentity sample_identity;
+        sample_identity.deserialize(deserializer);
 
-    fastrtps::rtps::WriteParams wparams;
-    transport_sample_identity(sample_identity, wparams.related_sample_identity());
+        fastrtps::rtps::WriteParams wparams;
+        transport_sample_identity(sample_identity, wparams.related_sample_identity());
 
-    std::vector<uint8_t> output_data(data.size() - deserializer.get_serialized_data_length());
-    deserializer.deserialize_array(output_data.data(), output_data.size());
+        /* The payload follows the identity, the buffer is reused across replies of the thread. */
+        static thread_local std::vector<uint8_t> output_data;
+        output_data.assign(data.begin() + deserializer.get_serialized_data_length(), data.end());
 
-    return datawriter_ptr_->write(&const_cast<std::vector<uint8_t>&>(output_data), wparams);
+        rv = datawriter_ptr_->write(&output_data, wparams);
+    }
+    catch(const std::exception&)
+    {
+        rv = false;
+    }
+    return rv;
 }
 
 void FastDDSReplier::transform_sample_identity(
@@ -1467,14 +1777,14 @@ bool FastDDSReplier::read(
         std::chrono::milliseconds timeout,
         fastdds::dds::SampleInfo& info)
 {
-    std::vector<uint8_t> temp_data;
-
     bool rv = false;
 
     fastrtps::Duration_t d((long double) timeout.count()/1000.0);
 
+    /* The request is taken behind room for its identity, which is then serialized in place. */
     if(datareader_ptr_->wait_for_unread_message(d)){
-        rv = ReturnCode_t::RETCODE_OK == datareader_ptr_->take_next_sample(&temp_data, &info);
+        TopicPubSubType::Headroom headroom(sample_identity_size);
+        rv = ReturnCode_t::RETCODE_OK == datareader_ptr_->take_next_sample(&data, &info);
     }
 
     if (rv)
@@ -1482,16 +1792,13 @@ bool FastDDSReplier::read(
         dds::SampleIdentity sample_identity;
         transform_sample_identity(info.sample_identity, sample_identity);
 
-        data.clear();
-        data.resize(sample_identity.getCdrSerializedSize() + temp_data.size());
-
-        fastcdr::FastBuffer fastbuffer{reinterpret_cast<char*>(data.data()), data.size()};
+        fastcdr::FastBuffer fastbuffer{reinterpret_cast<char*>(data.data()), sample_identity_size};
         fastcdr::Cdr serializer(fastbuffer, eprosima::fastcdr::Cdr::DEFAULT_ENDIAN, eprosima::fastcdr::CdrVersion::XCDRv1);
 
         try
         {
             sample_identity.serialize(serializer);
-            serializer.serialize_array(temp_data.data(), temp_data.size());
+            rv = (sample_identity_size == serializer.get_serialized_data_length());
         }
         catch(const std::exception&)
         {
@@ -1512,6 +1819,12 @@ const fastdds::dds::DataReader* FastDDSReplier::get_request_datareader() const
     return datareader_ptr_;
 }
 
+void FastDDSReplier::set_data_available_callback(
+        std::function<void ()> callback)
+{
+    notifier_.set_callback(std::move(callback));
+}
+
 const fastdds::dds::DataWriter* FastDDSReplier::get_reply_datawriter() const
 {
     return datawriter_ptr_;
@@ -18,10 +18,15 @@
 
 #include <fastrtps/xmlparser/XMLProfileManager.h>
 #include <fastdds/dds/subscriber/SampleInfo.hpp>
+#include <fastcdr/FastBuffer.h>
+#include <fastcdr/Cdr.h>
 #include "../../xmlobjects/xmlobjects.h"
 
 #include <uxr/agent/middleware/utils/Callbacks.hpp>
 
+#include <mutex>
+#include <sstream>
+
 #if defined(UAGENT_RESTRICT) || defined(UAGENT_PROTECT)
 #include <uxr/agent/datareader/DataReader.hpp>
 #endif // defined(UAGENT_RESTRICT) || defined(UAGENT_PROTECT)
@@ -31,6 +36,150 @@ namespace uxr {
 
 using namespace fastrtps::xmlparser;
 
+namespace {
+
+/* Agent-wide pool of participants, keyed by domain and profile and counted per client. */
+class ParticipantPool
+{
+public:
+    static ParticipantPool& instance()
+    {
+        static ParticipantPool pool;
+        return pool;
+    }
+
+    std::shared_ptr<FastDDSParticipant> acquire(
+            const std::string& key,
+            int16_t domain_id,
+            const std::function<bool(FastDDSParticipant&)>& create,
+            bool& created)
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        Entry& entry = participants_[key];
+        std::shared_ptr<FastDDSParticipant> participant = entry.participant.lock();
+        created = false;
+        if (!participant)
+        {
+            participant.reset(new FastDDSParticipant(domain_id));
+            if (create(*participant))
+            {
+                entry.participant = participant;
+                entry.references = 0;
+                created = true;
+                UXR_AGENT_LOG_DEBUG(
+                    UXR_DECORATE_GREEN("shared participant created"),
+                    "domain_id: {}", domain_id);
+            }
+            else
+            {
+                participant.reset();
+                participants_.erase(key);
+            }
+        }
+        if (participant)
+        {
+            ++entry.references;
+        }
+        return participant;
+    }
+
+    /* Returns whether it was the last client of the participant. */
+    bool release(
+            const std::shared_ptr<FastDDSParticipant>& participant)
+    {
+        bool rv = true;
+        std::lock_guard<std::mutex> lock(mtx_);
+        for (auto it = participants_.begin(); it != participants_.end();)
+        {
+            std::shared_ptr<FastDDSParticipant> candidate = it->second.participant.lock();
+            if (candidate == participant)
+            {
+                rv = (0 == --it->second.references);
+            }
+            if (!candidate || (rv && (candidate == participant)))
+            {
+                it = participants_.erase(it);
+                continue;
+            }
+            ++it;
+        }
+        return rv;
+    }
+
+    /* Held by the clients finding or creating the entities registered in a shared participant. */
+    std::unique_lock<std::mutex> lock()
+    {
+        return std::unique_lock<std::mutex>(mtx_);
+    }
+
+private:
+    struct Entry
+    {
+        std::weak_ptr<FastDDSParticipant> participant;
+        size_t references = 0;
+    };
+
+    std::mutex mtx_;
+    std::unordered_map<std::string, Entry> participants_;
+};
+
+/* Agent-wide pool of DataReaders fanned out to several clients. */
+class SharedReaderPool
+{
+public:
+    static SharedReaderPool& instance()
+    {
+        static SharedReaderPool pool;
+        return pool;
+    }
+
+    std::shared_ptr<FastDDSReaderFanOut> acquire(
+            const std::string& key,
+            const std::shared_ptr<FastDDSSubscriber>& subscriber,
+            const std::function<bool(FastDDSDataReader&)>& create)
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        std::vector<std::weak_ptr<FastDDSReaderFanOut>>& entries = readers_[key];
+        std::shared_ptr<FastDDSReaderFanOut> fan_out;
+        for (auto it = entries.begin(); it != entries.end();)
+        {
+            std::shared_ptr<FastDDSReaderFanOut> candidate = it->lock();
+            if (!candidate)
+            {
+                it = entries.erase(it);
+                continue;
+            }
+            if (!fan_out && candidate->get_subscriber_qos() == subscriber->get_qos())
+            {
+                fan_out = std::move(candidate);
+            }
+            ++it;
+        }
+
+        if (!fan_out)
+        {
+            std::shared_ptr<FastDDSDataReader> datareader(new FastDDSDataReader(subscriber));
+            if (create(*datareader))
+            {
+                fan_out = std::make_shared<FastDDSReaderFanOut>(datareader, subscriber->get_qos());
+                entries.emplace_back(fan_out);
+            }
+        }
+
+        if (entries.empty())
+        {
+            readers_.erase(key);
+        }
+        return fan_out;
+    }
+
+private:
+    std::mutex mtx_;
+    std::unordered_map<std::string, std::vector<std::weak_ptr<FastDDSReaderFanOut>>> readers_;
+};
+
+} // unnamed namespace
+
 FastDDSMiddleware::FastDDSMiddleware()
     : participants_()
     , topics_()
@@ -38,22 +187,37 @@ FastDDSMiddleware::FastDDSMiddleware()
     , subscribers_()
     , datawriters_()
     , datareaders_()
+    , reader_subscriptions_()
+    , reader_callbacks_()
     , requesters_()
     , repliers_()
+    , datawriter_guids_()
+    , requester_guids_()
+    , replier_guids_()
     , callback_factory_(callback_factory_.getInstance())
 {
 }
 
-FastDDSMiddleware::FastDDSMiddleware(bool intraprocess_enabled)
+FastDDSMiddleware::FastDDSMiddleware(
+        bool intraprocess_enabled,
+        bool shared_participants,
+        bool shared_readers)
     : Middleware(intraprocess_enabled)
+    , shared_participants_(shared_participants)
+    , shared_readers_(shared_readers)
     , participants_()
     , topics_()
     , publishers_()
     , subscribers_()
     , datawriters_()
     , datareaders_()
+    , reader_subscriptions_()
+    , reader_callbacks_()
     , requesters_()
     , repliers_()
+    , datawriter_guids_()
+    , requester_guids_()
+    , replier_guids_()
     , callback_factory_(callback_factory_.getInstance())
 {
     agent_domain_id_ = get_domain_id_from_env();
@@ -66,6 +230,15 @@ FastDDSMiddleware::FastDDSMiddleware(bool intraprocess_enabled)
 
 }
 
+FastDDSMiddleware::~FastDDSMiddleware()
+{
+    /* Leave the pool counts right for the clients still sharing them. */
+    for (const auto& participant : participants_)
+    {
+        release_participant(participant.second);
+    }
+}
+
 /**********************************************************************************************************************
  * Create functions.
  **********************************************************************************************************************/
@@ -89,16 +262,24 @@ bool FastDDSMiddleware::create_participant_by_ref(
     {
         participant_domain_id = static_cast<int16_t>(attrs.domainId);
     }
-    std::shared_ptr<FastDDSParticipant> participant(new FastDDSParticipant(participant_domain_id));
-    if (participant->create_by_ref(ref))
+    bool created = false;
+    std::shared_ptr<FastDDSParticipant> participant = acquire_participant(
+        "ref:" + std::to_string(participant_domain_id) + ":" + ref,
+        participant_domain_id,
+        [&](FastDDSParticipant& p){ return p.create_by_ref(ref); },
+        created);
+    if (participant)
     {
-        auto emplace_res = participants_.emplace(participant_id, std::move(participant));
-        rv = emplace_res.second;
-        if (rv)
+        rv = participants_.emplace(participant_id, participant).second;
+        if (!rv)
+        {
+            release_participant(participant);
+        }
+        else if (created)
         {
             callback_factory_.execute_callbacks(Middleware::Kind::FASTDDS,
                 middleware::CallbackKind::CREATE_PARTICIPANT,
-                **(emplace_res.first->second));
+                **participant);
         }
     }
     return rv;
@@ -118,16 +299,24 @@ bool FastDDSMiddleware::create_participant_by_xml(
     }
 
     bool rv = false;
-    std::shared_ptr<FastDDSParticipant> participant(new FastDDSParticipant(domain_id));
-    if (participant->create_by_xml(xml))
+    bool created = false;
+    std::shared_ptr<FastDDSParticipant> participant = acquire_participant(
+        "xml:" + std::to_string(domain_id) + ":" + xml,
+        domain_id,
+        [&](FastDDSParticipant& p){ return p.create_by_xml(xml); },
+        created);
+    if (participant)
     {
-        auto emplace_res = participants_.emplace(participant_id, std::move(participant));
-        rv = emplace_res.second;
-        if (rv)
+        rv = participants_.emplace(participant_id, participant).second;
+        if (!rv)
+        {
+            release_participant(participant);
+        }
+        else if (created)
         {
             callback_factory_.execute_callbacks(Middleware::Kind::FASTDDS,
                 middleware::CallbackKind::CREATE_PARTICIPANT,
-                **(emplace_res.first->second));
+                **participant);
         }
     }
     return rv;
@@ -147,26 +336,91 @@ bool FastDDSMiddleware::create_participant_by_bin(
     }
 
     bool rv = false;
-    std::shared_ptr<FastDDSParticipant> participant(new FastDDSParticipant(participant_domain_id));
-    if (participant->create_by_bin(participant_xrce))
+    std::string key = "bin:" + std::to_string(participant_domain_id) + ":" + participant_xrce.domain_referente();
+    if (participant_xrce.has_qos_profile())
     {
-        auto emplace_res = participants_.emplace(participant_id, std::move(participant));
-        rv = emplace_res.second;
-        if (rv)
+        key += ":" + participant_xrce.qos_profile();
+    }
+    bool created = false;
+    std::shared_ptr<FastDDSParticipant> participant = acquire_participant(
+        key,
+        participant_domain_id,
+        [&](FastDDSParticipant& p){ return p.create_by_bin(participant_xrce); },
+        created);
+    if (participant)
+    {
+        rv = participants_.emplace(participant_id, participant).second;
+        if (!rv)
+        {
+            release_participant(participant);
+        }
+        else if (created)
         {
             callback_factory_.execute_callbacks(Middleware::Kind::FASTDDS,
                 middleware::CallbackKind::CREATE_PARTICIPANT,
-                **(emplace_res.first->second));
+                **participant);
         }
     }
     return rv;
 }
 
+std::shared_ptr<FastDDSParticipant> FastDDSMiddleware::acquire_participant(
+        const std::string& key,
+        int16_t domain_id,
+        const std::function<bool(FastDDSParticipant&)>& create,
+        bool& created)
+{
+    std::shared_ptr<FastDDSParticipant> participant;
+    if (shared_participants_)
+    {
+        participant = ParticipantPool::instance().acquire(key, domain_id, create, created);
+    }
+    else
+    {
+        participant.reset(new FastDDSParticipant(domain_id));
+        created = create(*participant);
+        if (!created)
+        {
+            participant.reset();
+        }
+    }
+    return participant;
+}
+
+bool FastDDSMiddleware::release_participant(
+        const std::shared_ptr<FastDDSParticipant>& participant)
+{
+    return !shared_participants_ || ParticipantPool::instance().release(participant);
+}
+
+static
+std::string datareader_qos_key(
+        const dds::xrce::OBJK_DataReader_Binary& datareader_xrce)
+{
+    /* The topic object id is client-relative, the topic name is keyed separately. */
+    dds::xrce::OBJK_DataReader_Binary qos_xrce(datareader_xrce);
+    qos_xrce.topic_id(dds::xrce::ObjectId{});
+
+    std::vector<char> buffer(qos_xrce.getCdrSerializedSize());
+    fastcdr::FastBuffer fastbuffer{buffer.data(), buffer.size()};
+    fastcdr::Cdr serializer(fastbuffer);
+    qos_xrce.serialize(serializer);
+    return std::string(buffer.data(), serializer.get_serialized_data_length());
+}
+
 static
 std::shared_ptr<FastDDSTopic> create_topic(
         std::shared_ptr<FastDDSParticipant>& participant,
-        const fastrtps::TopicAttributes& attrs)
+        const fastrtps::TopicAttributes& attrs,
+        bool shared_participant)
 {
+    /* Other clients of a shared participant may be finding or creating the same topic. */
+    std::unique_lock<std::mutex> lock;
+    if (shared_participant)
+    {
+        lock = ParticipantPool::instance().lock();
+    }
+
     std::shared_ptr<FastDDSTopic> topic = participant->find_local_topic(attrs.getTopicName().c_str());
     if (topic)
     {
@@ -181,9 +435,12 @@ std::shared_ptr<FastDDSTopic> create_topic(
         std::shared_ptr<FastDDSType> type = participant->find_local_type(type_name);
         if (!type)
         {
-            fastdds::dds::TypeSupport type_support(new TopicPubSubType{false});
+            fastdds::dds::TypeSupport type_support(
+                new TopicPubSubType{false, FastDDSTransports::get_default().max_sample_size});
             type_support->setName(type_name);
-            type_support->m_isGetKeyDefined = (attrs.getTopicKind() == fastrtps::rtps::TopicKind_t::WITH_KEY);
+            /* Types with a key layout are keyed, even for topics created from binary. */
+            type_support->m_isGetKeyDefined = (attrs.getTopicKind() == fastrtps::rtps::TopicKind_t::WITH_KEY)
+                || (nullptr != TopicPubSubType::find_key_layout(type_name));
             type = std::make_shared<FastDDSType>(type_support, participant);
             if (!participant->register_local_type(type))
             {
@@ -223,7 +480,7 @@ bool FastDDSMiddleware::create_topic_by_ref(
         auto it_participant = participants_.find(participant_id);
         if (participants_.end() != it_participant)
         {
-            std::shared_ptr<FastDDSTopic> topic = create_topic(it_participant->second, attrs);
+            std::shared_ptr<FastDDSTopic> topic = create_topic(it_participant->second, attrs, shared_participants_);
             rv = topic && topics_.emplace(topic_id, std::move(topic)).second;
         }
     }
@@ -249,7 +506,7 @@ bool FastDDSMiddleware::create_topic_by_xml(
         auto it_participant = participants_.find(participant_id);
         if (participants_.end() != it_participant)
         {
-            std::shared_ptr<FastDDSTopic> topic = create_topic(it_participant->second, attrs);
+            std::shared_ptr<FastDDSTopic> topic = create_topic(it_participant->second, attrs, shared_participants_);
             rv = topic && topics_.emplace(topic_id, std::move(topic)).second;
         }
     }
@@ -276,7 +533,7 @@ bool FastDDSMiddleware::create_topic_by_bin(
             topic_xrce.topic_name().c_str(),
             topic_xrce.type_name().c_str()
         );
-        std::shared_ptr<FastDDSTopic> topic = create_topic(it_participant->second, attrs);
+        std::shared_ptr<FastDDSTopic> topic = create_topic(it_participant->second, attrs, shared_participants_);
         rv = topic && topics_.emplace(topic_id, std::move(topic)).second;
     }
     return rv;
@@ -374,6 +631,7 @@ bool FastDDSMiddleware::create_datawriter_by_ref(
             rv = emplace_res.second;
             if (rv)
             {
+                datawriter_guids_.insert(emplace_res.first->second->guid());
                 callback_factory_.execute_callbacks(Middleware::Kind::FASTDDS,
                     middleware::CallbackKind::CREATE_DATAWRITER,
                     **it_publisher->second->get_participant(),
@@ -400,6 +658,7 @@ bool FastDDSMiddleware::create_datawriter_by_xml(
             rv = emplace_res.second;
             if (rv)
             {
+                datawriter_guids_.insert(emplace_res.first->second->guid());
                 callback_factory_.execute_callbacks(Middleware::Kind::FASTDDS,
                     middleware::CallbackKind::CREATE_DATAWRITER,
                     **it_publisher->second->get_participant(),
@@ -433,6 +692,7 @@ bool FastDDSMiddleware::create_datawriter_by_bin(
                 rv = emplace_res.second;
                 if (rv)
                 {
+                    datawriter_guids_.insert(emplace_res.first->second->guid());
                     callback_factory_.execute_callbacks(Middleware::Kind::FASTDDS,
                         middleware::CallbackKind::CREATE_DATAWRITER,
                         **it_publisher->second->get_participant(),
@@ -453,8 +713,12 @@ bool FastDDSMiddleware::create_datareader_by_ref(
     auto it_subscriber = subscribers_.find(subscriber_id);
     if (subscribers_.end() != it_subscriber)
     {
-        std::shared_ptr<FastDDSDataReader> datareader(new FastDDSDataReader(it_subscriber->second));
-        if (datareader->create_by_ref(ref))
+        std::shared_ptr<FastDDSDataReader> datareader = acquire_datareader(
+            datareader_id,
+            it_subscriber->second,
+            "ref:" + ref,
+            [&](FastDDSDataReader& dr){ return dr.create_by_ref(ref); });
+        if (datareader)
         {
             auto emplace_res = datareaders_.emplace(datareader_id, std::move(datareader));
             rv = emplace_res.second;
@@ -479,8 +743,12 @@ bool FastDDSMiddleware::create_datareader_by_xml(
     auto it_subscriber = subscribers_.find(subscriber_id);
     if (subscribers_.end() != it_subscriber)
     {
-        std::shared_ptr<FastDDSDataReader> datareader(new FastDDSDataReader(it_subscriber->second));
-        if (datareader->create_by_xml(xml))
+        std::shared_ptr<FastDDSDataReader> datareader = acquire_datareader(
+            datareader_id,
+            it_subscriber->second,
+            "xml:" + xml,
+            [&](FastDDSDataReader& dr){ return dr.create_by_xml(xml); });
+        if (datareader)
         {
             auto emplace_res = datareaders_.emplace(datareader_id, std::move(datareader));
             rv = emplace_res.second;
@@ -506,11 +774,16 @@ bool FastDDSMiddleware::create_datareader_by_bin(
     auto it_subscriber = subscribers_.find(subscriber_id);
     if (subscribers_.end() != it_subscriber)
     {
-        std::shared_ptr<FastDDSDataReader> datareader(new FastDDSDataReader(it_subscriber->second));
         auto it_topics = topics_.find(conversion::objectid_to_raw(datareader_xrce.topic_id()));
         if (topics_.end() != it_topics)
         {
-            if (datareader->create_by_bin(datareader_xrce, it_topics->second))
+            std::shared_ptr<FastDDSTopic> topic = it_topics->second;
+            std::shared_ptr<FastDDSDataReader> datareader = acquire_datareader(
+                datareader_id,
+                it_subscriber->second,
+                "bin:" + topic->get_name() + ":" + datareader_qos_key(datareader_xrce),
+                [&](FastDDSDataReader& dr){ return dr.create_by_bin(datareader_xrce, topic); });
+            if (datareader)
             {
                 const std::string name = datareader->topic_->get_name();
                 topic_name = name;
@@ -529,13 +802,48 @@ bool FastDDSMiddleware::create_datareader_by_bin(
     return rv;
 }
 
+std::shared_ptr<FastDDSDataReader> FastDDSMiddleware::acquire_datareader(
+        uint16_t datareader_id,
+        const std::shared_ptr<FastDDSSubscriber>& subscriber,
+        const std::string& key,
+        const std::function<bool(FastDDSDataReader&)>& create)
+{
+    std::shared_ptr<FastDDSDataReader> datareader;
+    if (datareaders_.end() != datareaders_.find(datareader_id))
+    {
+        /* Id already in use, leave the existing subscription untouched. */
+    }
+    else if (shared_readers_)
+    {
+        /* Only DataReaders living on the same participant can be shared. */
+        std::ostringstream pool_key;
+        pool_key << subscriber->get_participant().get() << ":" << key;
+        std::shared_ptr<FastDDSReaderFanOut> fan_out =
+            SharedReaderPool::instance().acquire(pool_key.str(), subscriber, create);
+        if (fan_out)
+        {
+            datareader = fan_out->get_reader();
+            reader_subscriptions_[datareader_id].reset(new FastDDSReaderSubscription(fan_out));
+        }
+    }
+    else
+    {
+        datareader.reset(new FastDDSDataReader(subscriber));
+        if (!create(*datareader))
+        {
+            datareader.reset();
+        }
+    }
+    return datareader;
+}
+
 std::shared_ptr<FastDDSRequester> FastDDSMiddleware::create_requester(
         std::shared_ptr<FastDDSParticipant>& participant,
         const fastrtps::RequesterAttributes& attrs)
 {
     std::shared_ptr<FastDDSRequester> requester{};
-    std::shared_ptr<FastDDSTopic> request_topic = create_topic(participant, attrs.publisher.topic);
-    std::shared_ptr<FastDDSTopic> reply_topic = create_topic(participant, attrs.subscriber.topic);
+    std::shared_ptr<FastDDSTopic> request_topic = create_topic(participant, attrs.publisher.topic, shared_participants_);
+    std::shared_ptr<FastDDSTopic> reply_topic = create_topic(participant, attrs.subscriber.topic, shared_participants_);
     if (request_topic && reply_topic)
     {
         requester =
@@ -570,6 +878,7 @@ bool FastDDSMiddleware::create_requester_by_ref(
             rv = emplace_res.second;
             if (rv)
             {
+                requester_guids_.insert(emplace_res.first->second->guid_datawriter());
                 callback_factory_.execute_callbacks(Middleware::Kind::FASTDDS,
                     middleware::CallbackKind::CREATE_REQUESTER,
                     participant->get_ptr(),
@@ -603,6 +912,7 @@ bool FastDDSMiddleware::create_requester_by_xml(
             rv = emplace_res.second;
             if (rv)
             {
+                requester_guids_.insert(emplace_res.first->second->guid_datawriter());
                 callback_factory_.execute_callbacks(Middleware::Kind::FASTDDS,
                     middleware::CallbackKind::CREATE_REQUESTER,
                     participant->get_ptr(),
@@ -651,6 +961,7 @@ bool FastDDSMiddleware::create_requester_by_bin(
         rv = emplace_res.second;
         if (rv)
         {
+            requester_guids_.insert(emplace_res.first->second->guid_datawriter());
             callback_factory_.execute_callbacks(Middleware::Kind::FASTDDS,
                 middleware::CallbackKind::CREATE_REQUESTER,
                 participant->get_ptr(),
@@ -666,8 +977,8 @@ std::shared_ptr<FastDDSReplier> FastDDSMiddleware::create_replier(
         const fastrtps::ReplierAttributes& attrs)
 {
     std::shared_ptr<FastDDSReplier> replier{};
-    std::shared_ptr<FastDDSTopic> request_topic = create_topic(participant, attrs.subscriber.topic);
-    std::shared_ptr<FastDDSTopic> reply_topic = create_topic(participant, attrs.publisher.topic);
+    std::shared_ptr<FastDDSTopic> request_topic = create_topic(participant, attrs.subscriber.topic, shared_participants_);
+    std::shared_ptr<FastDDSTopic> reply_topic = create_topic(participant, attrs.publisher.topic, shared_participants_);
     if (request_topic && reply_topic)
     {
         replier =
@@ -702,6 +1013,7 @@ bool FastDDSMiddleware::create_replier_by_ref(
             rv = emplace_res.second;
             if (rv)
             {
+                replier_guids_.insert(emplace_res.first->second->guid_datawriter());
                 callback_factory_.execute_callbacks(Middleware::Kind::FASTDDS,
                     middleware::CallbackKind::CREATE_REPLIER,
                     participant->get_ptr(),
@@ -735,6 +1047,7 @@ bool FastDDSMiddleware::create_replier_by_xml(
             rv = emplace_res.second;
             if (rv)
             {
+                replier_guids_.insert(emplace_res.first->second->guid_datawriter());
                 callback_factory_.execute_callbacks(Middleware::Kind::FASTDDS,
                     middleware::CallbackKind::CREATE_REPLIER,
                     participant->get_ptr(),
@@ -783,6 +1096,7 @@ bool FastDDSMiddleware::create_replier_by_bin(
         rv = emplace_res.second;
         if (rv)
         {
+            replier_guids_.insert(emplace_res.first->second->guid_datawriter());
             callback_factory_.execute_callbacks(Middleware::Kind::FASTDDS,
                 middleware::CallbackKind::CREATE_REPLIER,
                 participant->get_ptr(),
@@ -807,11 +1121,15 @@ bool FastDDSMiddleware::delete_participant(
     else
     {
         auto participant = it->second;
-        callback_factory_.execute_callbacks(Middleware::Kind::FASTDDS,
-            middleware::CallbackKind::DELETE_PARTICIPANT,
-            participant->get_ptr());
+        participants_.erase(it);
 
-        participants_.erase(participant_id);
+        /* Pooled participants go away along with their last client. */
+        if (release_participant(participant))
+        {
+            callback_factory_.execute_callbacks(Middleware::Kind::FASTDDS,
+                middleware::CallbackKind::DELETE_PARTICIPANT,
+                participant->get_ptr());
+        }
         return true;
     }
 }
@@ -850,6 +1168,7 @@ bool FastDDSMiddleware::delete_datawriter(
             datawriter->participant(),
             datawriter->ptr());
 
+        datawriter_guids_.erase(datawriter->guid());
         datawriters_.erase(datawriter_id);
         return true;
     }
@@ -871,6 +1190,13 @@ bool FastDDSMiddleware::delete_datareader(
             datareader->participant(),
             datareader->ptr());
 
+        auto it_callback = reader_callbacks_.find(datareader_id);
+        if (reader_callbacks_.end() != it_callback)
+        {
+            datareader->remove_data_available_callback(it_callback->second);
+            reader_callbacks_.erase(it_callback);
+        }
+        reader_subscriptions_.erase(datareader_id);
         datareaders_.erase(datareader_id);
         return true;
     }
@@ -893,6 +1219,7 @@ bool FastDDSMiddleware::delete_requester(
             requester->get_request_datawriter(),
             requester->get_reply_datareader());
 
+        requester_guids_.erase(requester->guid_datawriter());
         requesters_.erase(requester_id);
         return true;
     }
@@ -915,11 +1242,28 @@ bool FastDDSMiddleware::delete_replier(
             replier->get_reply_datawriter(),
             replier->get_request_datareader());
 
+        replier_guids_.erase(replier->guid_datawriter());
         repliers_.erase(replier_id);
         return true;
     }
 }
 
+size_t FastDDSMiddleware::GUIDHash::operator()(
+        const fastrtps::rtps::GUID_t& guid) const
+{
+    /* FNV-1a over the prefix and the entity id. */
+    size_t hash = 2166136261u;
+    for (const fastrtps::rtps::octet byte : guid.guidPrefix.value)
+    {
+        hash = (hash ^ byte) * 16777619u;
+    }
+    for (const fastrtps::rtps::octet byte : guid.entityId.value)
+    {
+        hash = (hash ^ byte) * 16777619u;
+    }
+    return hash;
+}
+
 /**********************************************************************************************************************
  * Write/Read functions.
  **********************************************************************************************************************/
@@ -936,6 +1280,13 @@ bool FastDDSMiddleware::write_data(
    return rv;
 }
 
+Middleware::DataWriterHandle* FastDDSMiddleware::get_datawriter_handle(
+        uint16_t datawriter_id)
+{
+   auto it = datawriters_.find(datawriter_id);
+   return (datawriters_.end() != it) ? it->second.get() : nullptr;
+}
+
 bool FastDDSMiddleware::write_request(
         uint16_t requester_id,
         uint32_t sequence_number,
@@ -967,29 +1318,95 @@ bool FastDDSMiddleware::read_data(
         uint16_t datareader_id,
         std::vector<uint8_t>& data,
         std::chrono::milliseconds timeout)
+{
+    std::chrono::system_clock::time_point source_timestamp;
+    return read_timestamped_data(datareader_id, data, source_timestamp, timeout);
+}
+
+bool FastDDSMiddleware::read_timestamped_data(
+        uint16_t datareader_id,
+        std::vector<uint8_t>& data,
+        std::chrono::system_clock::time_point& source_timestamp,
+        std::chrono::milliseconds timeout)
 {
    bool rv = false;
    auto it = datareaders_.find(datareader_id);
    if (datareaders_.end() != it)
    {
-       fastdds::dds::SampleInfo sample_info;
-       rv = it->second->read(data, timeout, sample_info);
-
-       if (intraprocess_enabled_)
+       /* Self-echoes are dropped and the next sample is read without waiting. */
+       auto it_subscription = reader_subscriptions_.find(datareader_id);
+       fastrtps::rtps::GUID_t writer_guid;
+       do
        {
-            for (auto dw = datawriters_.begin(); dw != datawriters_.end(); dw++)
-            {
-                if (dw->second->guid() == sample_info.sample_identity.writer_guid())
-                {
-                    rv = false;
-                    break;
-                }
-            }
+           if (reader_subscriptions_.end() != it_subscription)
+           {
+               rv = it_subscription->second->read(data, timeout, writer_guid, source_timestamp);
+           }
+           else
+           {
+               fastdds::dds::SampleInfo sample_info;
+               rv = it->second->read(data, timeout, sample_info);
+               writer_guid = sample_info.sample_identity.writer_guid();
+               source_timestamp = to_time_point(sample_info.source_timestamp);
+           }
+           timeout = std::chrono::milliseconds(0);
        }
+       while (rv && intraprocess_enabled_ && (0 != datawriter_guids_.count(writer_guid)));
    }
    return rv;
 }
 
+bool FastDDSMiddleware::set_data_available_callback(
+        uint16_t datareader_id,
+        std::function<void ()> callback)
+{
+    bool rv = false;
+    auto it = datareaders_.find(datareader_id);
+    if (datareaders_.end() != it)
+    {
+        auto it_callback = reader_callbacks_.find(datareader_id);
+        if (reader_callbacks_.end() != it_callback)
+        {
+            it->second->remove_data_available_callback(it_callback->second);
+            reader_callbacks_.erase(it_callback);
+        }
+        if (callback)
+        {
+            reader_callbacks_.emplace(datareader_id, it->second->add_data_available_callback(std::move(callback)));
+        }
+        rv = true;
+    }
+    return rv;
+}
+
+bool FastDDSMiddleware::set_reply_available_callback(
+        uint16_t requester_id,
+        std::function<void ()> callback)
+{
+    bool rv = false;
+    auto it = requesters_.find(requester_id);
+    if (requesters_.end() != it)
+    {
+        it->second->set_data_available_callback(std::move(callback));
+        rv = true;
+    }
+    return rv;
+}
+
+bool FastDDSMiddleware::set_request_available_callback(
+        uint16_t replier_id,
+        std::function<void ()> callback)
+{
+    bool rv = false;
+    auto it = repliers_.find(replier_id);
+    if (repliers_.end() != it)
+    {
+        it->second->set_data_available_callback(std::move(callback));
+        rv = true;
+    }
+    return rv;
+}
+
 bool FastDDSMiddleware::read_request(
         uint16_t replier_id,
         std::vector<uint8_t>& data,
@@ -1000,20 +1417,13 @@ bool FastDDSMiddleware::read_request(
    if (repliers_.end() != it)
    {
         fastdds::dds::SampleInfo sample_info;
-        rv = it->second->read(data, timeout, sample_info);
-
-        if (intraprocess_enabled_)
+        do
         {
-            for (auto rq = requesters_.begin(); rq != requesters_.end(); rq++)
-            {
-                if (rq->second->guid_datawriter() == sample_info.sample_identity.writer_guid())
-                {
-                    rv = false;
-                    break;
-                }
-            }
+            rv = it->second->read(data, timeout, sample_info);
+            timeout = std::chrono::milliseconds(0);
         }
-
+        while (rv && intraprocess_enabled_
+                && (0 != requester_guids_.count(sample_info.sample_identity.writer_guid())));
    }
    return rv;
 }
@@ -1029,19 +1439,13 @@ bool FastDDSMiddleware::read_reply(
    if (requesters_.end() != it)
    {
        fastdds::dds::SampleInfo sample_info;
-       rv = it->second->read(sequence_number, data, timeout, sample_info);
-
-       if (intraprocess_enabled_)
-        {
-            for (auto rp = repliers_.begin(); rp != repliers_.end(); rp++)
-            {
-                if (rp->second->guid_datawriter() == sample_info.sample_identity.writer_guid())
-                {
-                    rv = false;
-                    break;
-                }
-            }
-        }
+       do
+       {
+           rv = it->second->read(sequence_number, data, timeout, sample_info);
+           timeout = std::chrono::milliseconds(0);
+       }
+       while (rv && intraprocess_enabled_
+               && (0 != replier_guids_.count(sample_info.sample_identity.writer_guid())));
    }
    return rv;
 }
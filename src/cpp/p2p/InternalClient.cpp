@@ -13,13 +13,14 @@
 // limitations under the License.
 
 #include <uxr/agent/p2p/InternalClient.hpp>
+#include <uxr/agent/p2p/InternalClientManager.hpp>
 #include <uxr/agent/middleware/ced/CedEntities.hpp>
 #include <uxr/agent/Agent.hpp>
 #include <uxr/agent/logger/Logger.hpp>
 #include <ucdr/microcdr.h>
 
+#include <iterator>
 #include <string>
-#include <iostream>
 
 namespace eprosima {
 namespace uxr {
@@ -44,8 +45,8 @@ InternalClient::InternalClient(
     , in_buffer_{0}
     , out_stream_id_{}
     , in_stream_id_{}
-    , running_cond_{false}
-    , thread_{}
+    , deadline_{std::chrono::steady_clock::time_point::max()}
+    , mtx_{}
 {}
 
 static void on_topic(
@@ -69,13 +70,26 @@ static void on_topic(
         result);
 }
 
-bool InternalClient::run()
+static void on_status(
+        uxrSession* session,
+        uxrObjectId object_id,
+        uint16_t request_id,
+        uint8_t status,
+        void* args)
 {
-    if (running_cond_)
+    (void) session; (void) object_id; (void) request_id; (void) args;
+
+    if ((UXR_STATUS_OK != status) && (UXR_STATUS_OK_MATCHED != status))
     {
-        return false;
+        UXR_AGENT_LOG_WARN(
+            UXR_DECORATE_YELLOW("failed to create entity in Agent"),
+            "object_id: 0x{:04X}, request_id: {}, status: {}",
+            (object_id.id << 4) | object_id.type, request_id, int(status));
     }
+}
 
+bool InternalClient::run()
+{
     bool rv = false;
 
     /* Set callbacks. */
@@ -115,8 +129,8 @@ bool InternalClient::run()
                     "address: {}:{}",
                     ip, port);
 
-                running_cond_ = true;
-                thread_ = std::thread(&InternalClient::loop, this);
+                /* Run by the InternalClientManager loop from now on. */
+                deadline_ = std::chrono::steady_clock::now();
                 rv = true;
             }
             else
@@ -141,18 +155,29 @@ bool InternalClient::run()
 
 bool InternalClient::stop()
 {
-    /* Stop thread. */
-    running_cond_ = false;
-    if (thread_.joinable())
+    CedTopicManager::unregister_on_new_domain_cb(remote_client_key_);
+    CedTopicManager::unregister_on_new_topic_cb(remote_client_key_);
+    return true;
+}
+
+void InternalClient::run_session()
+{
+    if (create_domain_entities())
     {
-        thread_.join();
+        create_topic_entities();
     }
-    return true;
+
+    /* Timeout 0 flushes the output, sends the due heartbeats and reads what is already there. */
+    const bool confirmed = uxr_run_session_time(&session_, 0);
+    deadline_ = confirmed
+        ? std::chrono::steady_clock::time_point::max()
+        : std::chrono::steady_clock::now() + internal_client_heartbeat_period;
 }
 
 void InternalClient::set_callback()
 {
     uxr_set_topic_callback(&session_, on_topic, this);
+    uxr_set_status_callback(&session_, on_status, this);
 }
 
 void InternalClient::create_streams()
@@ -170,221 +195,194 @@ void InternalClient::create_streams()
                 internal_client_history);
 }
 
-void InternalClient::create_domain_entities()
+bool InternalClient::create_domain_entities()
 {
     /* Get domains. */
-    std::unique_lock<std::mutex> lock(mtx_);
-    if (!domains_.empty())
+    std::set<int16_t> new_domains;
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        new_domains.swap(domains_);
+    }
+
+    for (auto it = new_domains.begin(); it != new_domains.end();)
     {
-        std::set<int16_t> created_domains = domains_;
-        lock.unlock();
-        for (auto it = created_domains.begin(); it != created_domains.end();)
+        bool entities_pending = false;
+
+        /* Create local entities. */
+        const uint16_t internal_participant_id = uint16_t(*it);
+        const uint16_t internal_publisher_id = uint16_t(*it);
+        const char* ref = "";
+        Agent::OpResult result;
+        if (agent_.create_participant_by_ref(
+                    INTERNAL_CLIENT_KEY,
+                    internal_participant_id,
+                    *it,
+                    ref,
+                    Agent::REUSE_MODE,
+                    result)
+                &&
+            agent_.create_publisher_by_xml(
+                    INTERNAL_CLIENT_KEY,
+                    internal_publisher_id,
+                    internal_participant_id,
+                    ref,
+                    Agent::REUSE_MODE,
+                    result))
         {
-            bool entities_created = false;
-
-            /* Create local entities. */
-            const uint16_t internal_participant_id = uint16_t(*it);
-            const uint16_t internal_publisher_id = uint16_t(*it);
-            const char* ref = "";
-            Agent::OpResult result;
-            if (agent_.create_participant_by_ref(
-                        INTERNAL_CLIENT_KEY,
-                        internal_participant_id,
-                        *it,
+            /* Create remote entities, their status is reported to on_status. */
+            uxrObjectId external_participant_id = uxr_object_id(uint16_t(*it), UXR_PARTICIPANT_ID);
+            uxrObjectId external_subscriber_id = uxr_object_id(uint16_t(*it), UXR_SUBSCRIBER_ID);
+
+            uint16_t participant_request = uxr_buffer_create_participant_ref(
+                        &session_,
+                        out_stream_id_,
+                        external_participant_id,
+                        0,
                         ref,
-                        Agent::REUSE_MODE,
-                        result)
-                    &&
-                agent_.create_publisher_by_xml(
-                        INTERNAL_CLIENT_KEY,
-                        internal_publisher_id,
-                        internal_participant_id,
+                        UXR_REUSE);
+            uint16_t subscriber_request = uxr_buffer_create_subscriber_xml(
+                        &session_,
+                        out_stream_id_,
+                        external_subscriber_id,
+                        external_participant_id,
                         ref,
-                        Agent::REUSE_MODE,
-                        result))
-            {
-                /* Create remote entities. */
-                uxrObjectId external_participant_id = uxr_object_id(uint16_t(*it), UXR_PARTICIPANT_ID);
-                uxrObjectId external_subscriber_id = uxr_object_id(uint16_t(*it), UXR_SUBSCRIBER_ID);
-
-                uint16_t participant_request = uxr_buffer_create_participant_ref(
-                            &session_,
-                            out_stream_id_,
-                            external_participant_id,
-                            0,
-                            ref,
-                            UXR_REUSE);
-                uint16_t subscriber_request = uxr_buffer_create_subscriber_xml(
-                            &session_,
-                            out_stream_id_,
-                            external_subscriber_id,
-                            external_participant_id,
-                            ref,
-                            UXR_REUSE);
-
-                uint8_t status[2];
-                uint16_t request[2] = {participant_request, subscriber_request};
-
-                if (uxr_run_session_until_all_status(&session_, 1000, request, status, sizeof(status)))
-                {
-                    if (UXR_STATUS_OK == status[0] && UXR_STATUS_OK == status[1])
-                    {
-                        entities_created = true;
-                    }
-                }
-                else
-                {
-                    std::cerr << "--> ERROR: failed to create Domain Entities in InternalClient" << std::endl;
-                }
-            }
-            if (entities_created)
-            {
-                ++it;
-            }
-            else
-            {
-                it = created_domains.erase(it);
-            }
-        }
+                        UXR_REUSE);
 
-        lock.lock();
-        for (auto& d : domains_)
+            /* The output stream is full, retried once it gets acknowledged. */
+            entities_pending = (UXR_INVALID_REQUEST_ID == participant_request)
+                || (UXR_INVALID_REQUEST_ID == subscriber_request);
+        }
+        else
         {
-            domains_.erase(d);
+            UXR_AGENT_LOG_WARN(
+                UXR_DECORATE_YELLOW("failed to create Domain Entities in InternalClient"),
+                "domain_id: {}",
+                *it);
         }
-        lock.unlock();
+
+        it = entities_pending ? std::next(it) : new_domains.erase(it);
+    }
+
+    if (!new_domains.empty())
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        domains_.insert(new_domains.begin(), new_domains.end());
     }
+    return new_domains.empty();
 }
 
 void InternalClient::create_topic_entities()
 {
-    /* Get domains. */
-    std::unique_lock<std::mutex> lock(mtx_);
-    if (!topics_.empty())
+    /* Get topics. */
+    std::set<std::pair<int16_t, std::string>> new_topics;
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        new_topics.swap(topics_);
+    }
+
+    for (auto it = new_topics.begin(); it != new_topics.end(); )
     {
-        std::set<std::pair<int16_t, std::string>> created_topics = topics_;
-        lock.unlock();
-        for (auto it = created_topics.begin(); it != created_topics.end(); )
+        bool entities_pending = false;
+
+        /* Create local entities. */
+        Agent::OpResult result;
+        const uint16_t internal_paraticipant_id = uint16_t(it->first);
+        const uint16_t internal_topic_id = topic_counter_;
+        const uint16_t internal_publisher_id = uint16_t(it->first);
+        const uint16_t internal_datawriter_id = topic_counter_;
+        if (agent_.create_topic_by_ref(
+                    INTERNAL_CLIENT_KEY,
+                    internal_topic_id,
+                    internal_paraticipant_id,
+                    it->second.c_str(),
+                    Agent::REUSE_MODE,
+                    result)
+                &&
+            agent_.create_datawriter_by_ref(
+                    INTERNAL_CLIENT_KEY,
+                    internal_datawriter_id,
+                    internal_publisher_id,
+                    it->second.c_str(),
+                    Agent::REUSE_MODE,
+                    result))
         {
-            bool entities_created = false;
-
-            /* Create local entities. */
-            Agent::OpResult result;
-            const uint16_t internal_paraticipant_id = uint16_t(it->first);
-            const uint16_t internal_topic_id = topic_counter_;
-            const uint16_t internal_publisher_id = uint16_t(it->first);
-            const uint16_t internal_datawriter_id = topic_counter_;
-            if (agent_.create_topic_by_ref(
-                        INTERNAL_CLIENT_KEY,
-                        internal_topic_id,
-                        internal_paraticipant_id,
-                        it->second.c_str(),
-                        Agent::REUSE_MODE,
-                        result)
-                    &&
-                agent_.create_datawriter_by_ref(
-                        INTERNAL_CLIENT_KEY,
-                        internal_datawriter_id,
-                        internal_publisher_id,
-                        it->second.c_str(),
-                        Agent::REUSE_MODE,
-                        result))
-            {
-                uxrObjectId external_participant_id = uxr_object_id(uint16_t(it->first), UXR_PARTICIPANT_ID);
-                uxrObjectId external_topic_id = uxr_object_id(uint16_t(topic_counter_), UXR_TOPIC_ID);
-                uxrObjectId external_subscriber_id = uxr_object_id(uint16_t(it->first), UXR_SUBSCRIBER_ID);
-                uxrObjectId external_datareader_id = uxr_object_id(uint16_t(topic_counter_), UXR_DATAREADER_ID);
-
-                const char* ref = it->second.c_str();
-
-                uint16_t topic_request = uxr_buffer_create_topic_ref(
-                            &session_,
-                            out_stream_id_,
-                            external_topic_id,
-                            external_participant_id,
-                            ref,
-                            UXR_REUSE);
-                uint16_t datareader_request = uxr_buffer_create_datareader_ref(
-                            &session_,
-                            out_stream_id_,
-                            external_datareader_id,
-                            external_subscriber_id,
-                            ref,
-                            UXR_REUSE);
-
-                /* Request data. */
-                uxrDeliveryControl delivery_control = {0, 0, 0, 0};
-                delivery_control.max_samples = UXR_MAX_SAMPLES_UNLIMITED;
-                uxr_buffer_request_data(
-                            &session_,
-                            out_stream_id_,
-                            external_datareader_id,
-                            in_stream_id_,
-                            &delivery_control);
-
-                uint8_t status[2];
-                uint16_t request[2] = {topic_request, datareader_request};
-
-                if (uxr_run_session_until_all_status(&session_, 1000, request, status, sizeof(status)))
-                {
-                    if (UXR_STATUS_OK == status[0] && UXR_STATUS_OK == status[1])
-                    {
-                        entities_created = true;
-                    }
-                }
-                else
-                {
-                    std::cerr << "--> ERROR: failed to create Topic Entities in InternalClient" << std::endl;
-                }
-            }
-            if (entities_created)
+            uxrObjectId external_participant_id = uxr_object_id(uint16_t(it->first), UXR_PARTICIPANT_ID);
+            uxrObjectId external_topic_id = uxr_object_id(uint16_t(topic_counter_), UXR_TOPIC_ID);
+            uxrObjectId external_subscriber_id = uxr_object_id(uint16_t(it->first), UXR_SUBSCRIBER_ID);
+            uxrObjectId external_datareader_id = uxr_object_id(uint16_t(topic_counter_), UXR_DATAREADER_ID);
+
+            const char* ref = it->second.c_str();
+
+            uint16_t topic_request = uxr_buffer_create_topic_ref(
+                        &session_,
+                        out_stream_id_,
+                        external_topic_id,
+                        external_participant_id,
+                        ref,
+                        UXR_REUSE);
+            uint16_t datareader_request = uxr_buffer_create_datareader_ref(
+                        &session_,
+                        out_stream_id_,
+                        external_datareader_id,
+                        external_subscriber_id,
+                        ref,
+                        UXR_REUSE);
+
+            /* Request data. */
+            uxrDeliveryControl delivery_control = {0, 0, 0, 0};
+            delivery_control.max_samples = UXR_MAX_SAMPLES_UNLIMITED;
+            uint16_t data_request = uxr_buffer_request_data(
+                        &session_,
+                        out_stream_id_,
+                        external_datareader_id,
+                        in_stream_id_,
+                        &delivery_control);
+
+            /* The output stream is full, retried with the same ids once it gets acknowledged. */
+            entities_pending = (UXR_INVALID_REQUEST_ID == topic_request)
+                || (UXR_INVALID_REQUEST_ID == datareader_request)
+                || (UXR_INVALID_REQUEST_ID == data_request);
+            if (!entities_pending)
             {
-                ++it;
                 ++topic_counter_;
             }
-            else
-            {
-                it = created_topics.erase(it);
-            }
         }
-
-        lock.lock();
-        for (auto& t : topics_)
+        else
         {
-            topics_.erase(t);
+            UXR_AGENT_LOG_WARN(
+                UXR_DECORATE_YELLOW("failed to create Topic Entities in InternalClient"),
+                "domain_id: {}, topic_name: {}",
+                it->first, it->second);
         }
-        lock.unlock();
-    }
-}
 
-void InternalClient::loop()
-{
+        it = entities_pending ? std::next(it) : new_topics.erase(it);
+    }
 
-    while (running_cond_)
+    if (!new_topics.empty())
     {
-        /* Create domain entities. */
-        create_domain_entities();
-
-        /* Create topic entities. */
-        create_topic_entities();
-
-        /* Run session. */
-        uxr_run_session_time(&session_, 1000);
+        std::lock_guard<std::mutex> lock(mtx_);
+        topics_.insert(new_topics.begin(), new_topics.end());
     }
 }
 
 void InternalClient::on_new_domain(int16_t domain)
 {
-    std::lock_guard<std::mutex> lock(mtx_);
-    domains_.insert(domain);
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        domains_.insert(domain);
+    }
+    InternalClientManager::instance().wake_up();
 }
 
 void InternalClient::on_new_topic(
         int16_t domain_id,
         const std::string& topic_name)
 {
-    std::lock_guard<std::mutex> lock(mtx_);
-    topics_.emplace(std::make_pair(domain_id, topic_name));
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        topics_.emplace(std::make_pair(domain_id, topic_name));
+    }
+    InternalClientManager::instance().wake_up();
 }
 
 } // namespace eprosima
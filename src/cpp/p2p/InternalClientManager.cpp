@@ -15,11 +15,18 @@
 #include <uxr/agent/p2p/InternalClientManager.hpp>
 #include <uxr/agent/p2p/InternalClient.hpp>
 
-#include <iostream>
+#include <algorithm>
+#include <vector>
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
 
 namespace eprosima {
 namespace uxr {
 
+constexpr int max_loop_events = 64;
+
 InternalClientManager& InternalClientManager::instance()
 {
     static InternalClientManager manager;
@@ -38,30 +45,188 @@ void InternalClientManager::create_client(
         uint16_t port)
 {
     uint32_t remote_client_key = port + (uint32_t(ip[3]) << 16) + (uint32_t(0xEA) << 24);
-    std::lock_guard<std::mutex> lock(mtx_);
+    std::unique_lock<std::mutex> lock(mtx_);
     auto it = clients_.find(remote_client_key);
-    if (clients_.end() == it)
+    if ((clients_.end() == it) && start_loop())
     {
+        /* The session handshake blocks, the loop keeps running the other clients meanwhile. */
+        lock.unlock();
         std::unique_ptr<InternalClient>
                 client(new InternalClient(agent, ip, port, remote_client_key, local_client_key_));
         if (client->run())
         {
-            clients_.emplace(remote_client_key, std::move(client));
+            struct epoll_event event{};
+            event.events = EPOLLIN;
+            event.data.ptr = client.get();
+
+            lock.lock();
+            if ((clients_.end() == clients_.find(remote_client_key)) &&
+                (0 == epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, client->get_fd(), &event)))
+            {
+                clients_.emplace(remote_client_key, std::move(client));
+                wake_up();
+            }
+            else
+            {
+                client->stop();
+            }
+        }
+        else
+        {
+            client->stop();
         }
     }
 }
 
 void InternalClientManager::delete_clients()
 {
+    /* Stop loop. */
+    running_cond_ = false;
+    wake_up();
+    if (thread_.joinable())
+    {
+        thread_.join();
+    }
+
     std::lock_guard<std::mutex> lock(mtx_);
     for (auto& c : clients_)
     {
         c.second->stop();
     }
     clients_.clear();
+
+    if (-1 != epoll_fd_)
+    {
+        ::close(epoll_fd_);
+        epoll_fd_ = -1;
+    }
+
+    /* Clients still being created may wake the loop up. */
+    std::lock_guard<std::mutex> event_lock(event_mtx_);
+    if (-1 != event_fd_)
+    {
+        ::close(event_fd_);
+        event_fd_ = -1;
+    }
+}
+
+void InternalClientManager::wake_up()
+{
+    std::lock_guard<std::mutex> lock(event_mtx_);
+    if (-1 != event_fd_)
+    {
+        const uint64_t value = 1;
+        ssize_t bytes_written = ::write(event_fd_, &value, sizeof(value));
+        (void) bytes_written;
+    }
+}
+
+bool InternalClientManager::start_loop()
+{
+    if (!running_cond_ && !thread_.joinable())
+    {
+        std::lock_guard<std::mutex> event_lock(event_mtx_);
+        epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+        event_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+        /* A null pointer tells the wake up event from the sockets. */
+        struct epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.ptr = nullptr;
+        if ((-1 != epoll_fd_) && (-1 != event_fd_) &&
+            (0 == epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, event_fd_, &event)))
+        {
+            running_cond_ = true;
+            thread_ = std::thread(&InternalClientManager::loop, this);
+        }
+        else
+        {
+            if (-1 != epoll_fd_)
+            {
+                ::close(epoll_fd_);
+                epoll_fd_ = -1;
+            }
+            if (-1 != event_fd_)
+            {
+                ::close(event_fd_);
+                event_fd_ = -1;
+            }
+        }
+    }
+    return running_cond_;
 }
 
-InternalClientManager::InternalClientManager() = default;
+void InternalClientManager::loop()
+{
+    using namespace std::chrono;
+
+    std::vector<InternalClient*> clients;
+    struct epoll_event events[max_loop_events];
+    while (running_cond_)
+    {
+        /* Clients are only removed once the loop is stopped. */
+        clients.clear();
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+            for (auto& c : clients_)
+            {
+                clients.push_back(c.second.get());
+            }
+        }
+
+        /* Sleep until a socket is readable, a session has to send heartbeats or more work is queued. */
+        steady_clock::time_point deadline = steady_clock::time_point::max();
+        for (InternalClient* client : clients)
+        {
+            deadline = std::min(deadline, client->get_deadline());
+        }
+        int timeout = -1;
+        if (steady_clock::time_point::max() != deadline)
+        {
+            const milliseconds remaining = duration_cast<milliseconds>(deadline - steady_clock::now());
+            timeout = int(std::max(remaining.count() + 1, milliseconds::rep(0)));
+        }
+
+        bool woken_up = false;
+        int events_count = epoll_wait(epoll_fd_, events, max_loop_events, timeout);
+        for (int i = 0; i < events_count; ++i)
+        {
+            InternalClient* client = static_cast<InternalClient*>(events[i].data.ptr);
+            if (nullptr == client)
+            {
+                uint64_t value;
+                ssize_t bytes_read = ::read(event_fd_, &value, sizeof(value));
+                (void) bytes_read;
+                woken_up = true;
+            }
+            else if (running_cond_)
+            {
+                client->run_session();
+            }
+        }
+
+        const steady_clock::time_point now = steady_clock::now();
+        for (InternalClient* client : clients)
+        {
+            if (running_cond_ && (woken_up || (client->get_deadline() <= now)))
+            {
+                client->run_session();
+            }
+        }
+    }
+}
+
+InternalClientManager::InternalClientManager()
+    : mtx_{}
+    , local_client_key_{0}
+    , clients_{}
+    , epoll_fd_{-1}
+    , event_mtx_{}
+    , event_fd_{-1}
+    , thread_{}
+    , running_cond_{false}
+{}
+
 InternalClientManager::~InternalClientManager() = default;
 
 } // namespace uxr
@@ -31,6 +31,36 @@
 namespace eprosima {
 namespace uxr {
 
+namespace {
+
+/* Message size after appending the given ACKNACK submessages, each one 4-byte aligned. */
+size_t append_acknacks_size(
+        size_t message_size,
+        const std::vector<dds::xrce::ACKNACK_Payload>& acknacks)
+{
+    const size_t subheader_size = dds::xrce::SubmessageHeader{}.getCdrSerializedSize();
+    for (const auto& acknack : acknacks)
+    {
+        message_size = ((message_size + 3) & ~size_t(3)) + subheader_size + acknack.getCdrSerializedSize();
+    }
+    return message_size;
+}
+
+/* Submessage payload encoded beforehand, such as the batched DATA formats. */
+struct SerializedPayload
+{
+    const std::vector<uint8_t>& buffer;
+
+    size_t getCdrSerializedSize() const { return buffer.size(); }
+
+    void serialize(fastcdr::Cdr& serializer) const
+    {
+        serializer.serialize_array(buffer.data(), buffer.size());
+    }
+};
+
+} // unnamed namespace
+
 template<typename EndPoint>
 Processor<EndPoint>::Processor(
         Server<EndPoint>& server,
@@ -64,7 +94,7 @@ void Processor<EndPoint>::process_input_packet(
                 {
                     OutputPacket<EndPoint> output_packet;
                     process_get_info_packet(std::move(input_packet), output_packet);
-                    server_.push_output_packet(std::move(output_packet));
+                    push_output_packet(std::move(output_packet));
                     break;
                 }
                 default:
@@ -99,38 +129,19 @@ void Processor<EndPoint>::process_input_packet(
             dds::xrce::StreamId stream_id = input_packet.message->get_header().stream_id();
             dds::xrce::SequenceNr sequence_nr = input_packet.message->get_header().sequence_nr();
             session.push_input_message(std::move(input_packet.message), stream_id, sequence_nr);
+            session.schedule_acknack(stream_id);
+
+            size_t processed_messages = 0;
             while (session.pop_input_message(stream_id, input_packet.message))
             {
                 process_input_message(*client, input_packet);
+                ++processed_messages;
             }
 
             if (is_reliable_stream(stream_id))
             {
-                dds::xrce::MessageHeader acknack_header;
-                acknack_header.session_id(header.session_id());
-                acknack_header.stream_id(dds::xrce::STREAMID_NONE);
-                acknack_header.sequence_nr(0x00);
-                acknack_header.client_key(header.client_key());
-
-                dds::xrce::ACKNACK_Payload acknack_payload;
-                client->session().fill_acknack(stream_id, acknack_payload);
-                acknack_payload.stream_id(header.stream_id());
-
-                dds::xrce::SubmessageHeader acknack_subheader;
-                acknack_subheader.submessage_id(dds::xrce::ACKNACK);
-                acknack_subheader.flags(dds::xrce::FLAG_LITTLE_ENDIANNESS);
-                acknack_subheader.submessage_length(uint16_t(acknack_payload.getCdrSerializedSize()));
-
-                const size_t message_size = acknack_header.getCdrSerializedSize() +
-                                            acknack_subheader.getCdrSerializedSize() +
-                                            acknack_payload.getCdrSerializedSize();
-
-                OutputPacket<EndPoint> output_packet;
-                output_packet.destination = input_packet.source;
-                output_packet.message.reset(new OutputMessage(acknack_header, message_size));
-                output_packet.message->append_submessage(dds::xrce::ACKNACK, acknack_payload);
-
-                server_.push_output_packet(std::move(output_packet));
+                /* Duplicated or out-of-order messages are acknowledged right away. */
+                flush_acknacks(*client, input_packet.source, 0 == processed_messages);
             }
         }
         else
@@ -160,7 +171,7 @@ void Processor<EndPoint>::process_input_packet(
                             output_packet.message.reset(new OutputMessage(input_packet.message->get_header(), message_size));
                             output_packet.message->append_submessage(dds::xrce::STATUS, status_payload);
 
-                            server_.push_output_packet(std::move(output_packet));
+                            push_output_packet(std::move(output_packet));
                         }
                         break;
                     }
@@ -169,7 +180,7 @@ void Processor<EndPoint>::process_input_packet(
                     {
                         OutputPacket<EndPoint> output_packet;
                         process_get_info_packet(std::move(input_packet), output_packet);
-                        server_.push_output_packet(std::move(output_packet));
+                        push_output_packet(std::move(output_packet));
                         break;
                     }
                     default:
@@ -305,7 +316,7 @@ bool Processor<EndPoint>::process_create_client_submessage(
             output_packet.message = std::shared_ptr<OutputMessage>(new OutputMessage(status_header, message_size));
             output_packet.message->append_submessage(dds::xrce::STATUS_AGENT, status_agent);
 
-            server_.push_output_packet(std::move(output_packet));
+            push_output_packet(std::move(output_packet));
         }
     }
     else
@@ -352,7 +363,7 @@ bool Processor<EndPoint>::process_create_submessage(
         output_packet.destination = input_packet.source;
         while (client.session().get_next_output_message(stream_kind, output_packet.message))
         {
-            server_.push_output_packet(std::move(output_packet));
+            push_output_packet(client, std::move(output_packet));
         }
     }
     return rv;
@@ -391,7 +402,7 @@ bool Processor<EndPoint>::process_delete_submessage(
 
             while (client.session().get_next_output_message(dds::xrce::STREAMID_NONE, output_packet.message))
             {
-                server_.push_output_packet(std::move(output_packet));
+                push_output_packet(client, std::move(output_packet));
             }
         }
         else
@@ -409,7 +420,7 @@ bool Processor<EndPoint>::process_delete_submessage(
 
             while (client.session().get_next_output_message(stream_kind, output_packet.message))
             {
-                server_.push_output_packet(std::move(output_packet));
+                push_output_packet(client, std::move(output_packet));
             }
         }
     }
@@ -456,9 +467,7 @@ bool Processor<EndPoint>::process_write_data_submessage(
                 {
                     case dds::xrce::OBJK_DATAWRITER:
                     {
-                        std::shared_ptr<DataWriter> data_writer =
-                                std::dynamic_pointer_cast<DataWriter>(client.get_object(object_id));
-                        if (nullptr != data_writer)
+                        if (ProxyClient::Handle<DataWriter> data_writer = client.get_handle<DataWriter>(object_id))
                         {
                             written = data_writer->write(data_payload);
                         }
@@ -466,9 +475,7 @@ bool Processor<EndPoint>::process_write_data_submessage(
                     }
                     case dds::xrce::OBJK_REQUESTER:
                     {
-                        std::shared_ptr<Requester> requester =
-                                std::dynamic_pointer_cast<Requester>(client.get_object(object_id));
-                        if (nullptr != requester)
+                        if (ProxyClient::Handle<Requester> requester = client.get_handle<Requester>(object_id))
                         {
                             written = requester->write(data_payload, data_payload.request_id());
                         }
@@ -476,9 +483,7 @@ bool Processor<EndPoint>::process_write_data_submessage(
                     }
                     case dds::xrce::OBJK_REPLIER:
                     {
-                        std::shared_ptr<Replier> replier =
-                                std::dynamic_pointer_cast<Replier>(client.get_object(object_id));
-                        if (nullptr != replier)
+                        if (ProxyClient::Handle<Replier> replier = client.get_handle<Replier>(object_id))
                         {
                             written = replier->write(data_payload);
                         }
@@ -519,58 +524,49 @@ bool Processor<EndPoint>::process_read_data_submessage(
     if (input_packet.message->get_payload(read_payload))
     {
         const dds::xrce::ObjectId& object_id = read_payload.object_id();
-        std::shared_ptr<XRCEObject> reader_object;
+
+        WriteFnArgs write_args;
+        write_args.client_key = client.get_client_key();
+        write_args.stream_id = read_payload.read_specification().preferred_stream_id();
+        write_args.object_id = read_payload.object_id();
+        write_args.request_id = read_payload.request_id();
+        write_args.data_format = dds::xrce::FORMAT_DATA;
+
+        using namespace std::placeholders;
+        Reader<bool>::WriteFn write_fn = std::bind(&Processor::read_data_callback, this, _1, _2, _3);
+        dds::xrce::StatusValue status = dds::xrce::STATUS_ERR_UNKNOWN_REFERENCE;
+        bool reading = false;
 
         switch (object_id[1] & 0x0F)
         {
             case dds::xrce::OBJK_DATAREADER:
-                reader_object = std::dynamic_pointer_cast<DataReader>(client.get_object(read_payload.object_id()));
+                if (ProxyClient::Handle<DataReader> data_reader = client.get_handle<DataReader>(object_id))
+                {
+                    status = dds::xrce::STATUS_OK;
+                    reading = data_reader->read(read_payload, write_fn, write_args);
+                }
                 break;
             case dds::xrce::OBJK_REQUESTER:
-                reader_object = std::dynamic_pointer_cast<Requester>(client.get_object(read_payload.object_id()));
+                if (ProxyClient::Handle<Requester> requester = client.get_handle<Requester>(object_id))
+                {
+                    status = dds::xrce::STATUS_OK;
+                    reading = requester->read(read_payload, write_fn, write_args);
+                }
                 break;
             case dds::xrce::OBJK_REPLIER:
-                reader_object = std::dynamic_pointer_cast<Replier>(client.get_object(read_payload.object_id()));
+                if (ProxyClient::Handle<Replier> replier = client.get_handle<Replier>(object_id))
+                {
+                    status = dds::xrce::STATUS_OK;
+                    reading = replier->read(read_payload, write_fn, write_args);
+                }
                 break;
             default:
                 break;
         }
 
-        dds::xrce::StatusValue status = (nullptr != reader_object)
-                ? dds::xrce::STATUS_OK
-                : dds::xrce::STATUS_ERR_UNKNOWN_REFERENCE;
-
-        if (dds::xrce::STATUS_OK == status)
+        if ((dds::xrce::STATUS_OK == status) && !reading)
         {
-            WriteFnArgs write_args;
-            write_args.client_key = client.get_client_key();
-            write_args.stream_id = read_payload.read_specification().preferred_stream_id();
-            write_args.object_id = read_payload.object_id();
-            write_args.request_id = read_payload.request_id();
-
-            using namespace std::placeholders;
-            Reader<bool>::WriteFn write_fn = std::bind(&Processor::read_data_callback, this, _1, _2, _3);
-            bool reading = false;
-
-            switch (object_id[1] & 0x0F)
-            {
-                case dds::xrce::OBJK_DATAREADER:
-                    reading = std::dynamic_pointer_cast<DataReader>(reader_object)->read(read_payload, write_fn, write_args);
-                    break;
-                case dds::xrce::OBJK_REQUESTER:
-                    reading = std::dynamic_pointer_cast<Requester>(reader_object)->read(read_payload, write_fn, write_args);
-                    break;
-                case dds::xrce::OBJK_REPLIER:
-                    reading = std::dynamic_pointer_cast<Replier>(reader_object)->read(read_payload, write_fn, write_args);
-                    break;
-                default:
-                    break;
-            }
-
-            if (!reading)
-            {
-                status = dds::xrce::STATUS_ERR_RESOURCES;
-            }
+            status = dds::xrce::STATUS_ERR_RESOURCES;
         }
 
         if (dds::xrce::STATUS_OK != status)
@@ -591,7 +587,7 @@ bool Processor<EndPoint>::process_read_data_submessage(
             output_packet.destination = input_packet.source;
             while (client.session().get_next_output_message(dds::xrce::STREAMID_BUILTIN_RELIABLE, output_packet.message))
             {
-                server_.push_output_packet(std::move(output_packet));
+                push_output_packet(client, std::move(output_packet));
             }
         }
     }
@@ -627,14 +623,14 @@ bool Processor<EndPoint>::process_acknack_submessage(
             {
                 if (client.session().get_output_message(stream_id, first_message + i, output_packet.message))
                 {
-                    server_.push_output_packet(std::move(output_packet));
+                    push_output_packet(client, std::move(output_packet), false);
                 }
             }
             if ((nack_bitmap.at(0) & mask) == mask)
             {
                 if (client.session().get_output_message(stream_id, first_message + i + 8, output_packet.message))
                 {
-                    server_.push_output_packet(std::move(output_packet));
+                    push_output_packet(client, std::move(output_packet), false);
                 }
             }
         }
@@ -666,22 +662,8 @@ bool Processor<EndPoint>::process_heartbeat_submessage(
                                                heartbeat_payload.first_unacked_seq_nr(),
                                                heartbeat_payload.last_unacked_seq_nr());
 
-        dds::xrce::ACKNACK_Payload acknack_payload;
-        client.session().fill_acknack(stream_id, acknack_payload);
-        acknack_payload.stream_id(stream_id);
-
-        client.session().push_output_submessage(
-            dds::xrce::STREAMID_NONE,
-            dds::xrce::ACKNACK,
-            acknack_payload,
-            std::chrono::milliseconds(0));
-
-        OutputPacket<EndPoint> output_packet;
-        output_packet.destination = input_packet.source;
-        if (client.session().get_next_output_message(dds::xrce::STREAMID_NONE, output_packet.message))
-        {
-            server_.push_output_packet(std::move(output_packet));
-        }
+        client.session().schedule_acknack(stream_id);
+        flush_acknacks(client, input_packet.source, true);
     }
     else
     {
@@ -745,7 +727,7 @@ bool Processor<EndPoint>::process_timestamp_submessage(
         output_packet.destination = input_packet.source;
         if (client.session().get_next_output_message(dds::xrce::STREAMID_NONE, output_packet.message))
         {
-            server_.push_output_packet(std::move(output_packet));
+            push_output_packet(client, std::move(output_packet));
         }
     }
     else
@@ -808,39 +790,157 @@ bool Processor<EndPoint>::process_get_info_submessage(
         output_packet.message = OutputMessagePtr(new OutputMessage(header, message_size));
         rv = output_packet.message->append_submessage(dds::xrce::INFO, info_payload);
 
-        server_.push_output_packet(std::move(output_packet));
+        push_output_packet(client, std::move(output_packet));
     }
 
     return rv;
 }
 
 template<typename EndPoint>
-bool Processor<EndPoint>::read_data_callback(
+void Processor<EndPoint>::push_output_packet(
+        ProxyClient& client,
+        OutputPacket<EndPoint>&& output_packet,
+        bool fresh)
+{
+    std::vector<dds::xrce::ACKNACK_Payload> acknacks;
+    if (output_packet.message && client.session().pop_acknacks(acknacks, true))
+    {
+        /* Piggyback pending ACKNACKs on fresh non-fragment messages whenever they fit in the MTU, the client
+           drops them along with duplicated messages. They go in front of its submessages, which are shared. */
+        dds::xrce::MessageHeader header;
+        header.session_id(client.get_session_id());
+        const size_t header_len = header.getCdrSerializedSize();
+        if (fresh
+            && OutputMessage::is_prependable(*output_packet.message, header_len)
+            && (OutputMessage::get_prepended_len(*output_packet.message, header_len, acknacks)
+                <= client.session().get_session_info().mtu))
+        {
+            output_packet.message.reset(
+                new OutputMessage(output_packet.message, header_len, dds::xrce::ACKNACK, acknacks));
+        }
+        else
+        {
+            push_acknacks(client, output_packet.destination, acknacks);
+        }
+    }
+
+    /* Every message to the client is metered by its link pacer, the readers wait for it. */
+    if (output_packet.message)
+    {
+        client.get_link_pacer().consume(output_packet.message->get_len());
+    }
+    server_.push_output_packet(std::move(output_packet));
+}
+
+template<typename EndPoint>
+void Processor<EndPoint>::push_output_packet(
+        OutputPacket<EndPoint>&& output_packet)
+{
+    /* Messages sent outside a client context are metered by the client of the endpoint, if any. */
+    uint32_t raw_client_key;
+    std::shared_ptr<ProxyClient> client;
+    if (output_packet.message
+        && server_.get_client_key(output_packet.destination, raw_client_key)
+        && (client = root_.get_client(conversion::raw_to_clientkey(raw_client_key))))
+    {
+        client->get_link_pacer().consume(output_packet.message->get_len());
+    }
+    server_.push_output_packet(std::move(output_packet));
+}
+
+template<typename EndPoint>
+void Processor<EndPoint>::flush_acknacks(
+        ProxyClient& client,
+        const EndPoint& destination,
+        bool force)
+{
+    std::vector<dds::xrce::ACKNACK_Payload> acknacks;
+    if (client.session().pop_acknacks(acknacks, force))
+    {
+        push_acknacks(client, destination, acknacks);
+    }
+
+    /* The ones left are delayed, the server wakes up at the deadline of the earliest one. */
+    std::chrono::steady_clock::time_point deadline;
+    if (client.session().pop_acknack_deadline(deadline))
+    {
+        server_.push_acknack_timer(conversion::clientkey_to_raw(client.get_client_key()), deadline);
+    }
+}
+
+template<typename EndPoint>
+void Processor<EndPoint>::push_acknacks(
+        ProxyClient& client,
+        const EndPoint& destination,
+        const std::vector<dds::xrce::ACKNACK_Payload>& acknacks)
+{
+    dds::xrce::MessageHeader acknack_header;
+    acknack_header.session_id(client.get_session_id());
+    acknack_header.stream_id(dds::xrce::STREAMID_NONE);
+    acknack_header.sequence_nr(0x00);
+    acknack_header.client_key(client.get_client_key());
+
+    const size_t message_size = append_acknacks_size(acknack_header.getCdrSerializedSize(), acknacks);
+
+    OutputPacket<EndPoint> output_packet;
+    output_packet.destination = destination;
+    output_packet.message.reset(new OutputMessage(acknack_header, message_size));
+    for (const auto& acknack : acknacks)
+    {
+        output_packet.message->append_submessage(dds::xrce::ACKNACK, acknack);
+    }
+
+    client.get_link_pacer().consume(output_packet.message->get_len());
+    server_.push_output_packet(std::move(output_packet));
+}
+
+template<typename EndPoint>
+WriteResult Processor<EndPoint>::read_data_callback(
         const WriteFnArgs& cb_args,
         const std::vector<uint8_t>& buffer,
-        std::chrono::milliseconds timeout)
+        std::chrono::milliseconds /* timeout */)
 {
-    bool rv = false;
-
-    dds::xrce::DATA_Payload_Data data_payload;
-    data_payload.request_id(cb_args.request_id);
-    data_payload.object_id(cb_args.object_id);
-    data_payload.data().serialized_data(buffer);
+    /* Without a known endpoint the reader retries later, nothing waits here. */
+    WriteResult rv = WriteResult::retry;
 
     OutputPacket<EndPoint> output_packet;
     if (server_.get_endpoint(conversion::clientkey_to_raw(cb_args.client_key), output_packet.destination))
     {
-        rv = cb_args.client->session().push_output_submessage(cb_args.stream_id, dds::xrce::DATA, data_payload, timeout);
+        Session& session = cb_args.client->session();
+        PushResult push_result;
+        if (dds::xrce::FORMAT_DATA == cb_args.data_format)
+        {
+            dds::xrce::DATA_Payload_Data data_payload;
+            data_payload.request_id(cb_args.request_id);
+            data_payload.object_id(cb_args.object_id);
+            data_payload.data().serialized_data(buffer);
+            push_result = session.try_push_output_submessage(
+                cb_args.stream_id, dds::xrce::DATA, data_payload, cb_args.resume, cb_args.data_format);
+        }
+        else
+        {
+            /* The other formats come encoded as a whole DATA payload. */
+            push_result = session.try_push_output_submessage(
+                cb_args.stream_id, dds::xrce::DATA, SerializedPayload{buffer}, cb_args.resume, cb_args.data_format);
+        }
+
+        switch (push_result)
+        {
+            case PushResult::pushed:
+                rv = WriteResult::written;
+                break;
+            case PushResult::window_full:
+                rv = cb_args.resume ? WriteResult::parked : WriteResult::retry;
+                break;
+            default:
+                break;
+        }
 
         while (cb_args.client->session().get_next_output_message(cb_args.stream_id, output_packet.message))
         {
-            server_.push_output_packet(std::move(output_packet));
+            push_output_packet(*cb_args.client, std::move(output_packet));
         }
     }
-    else
-    {
-        std::this_thread::sleep_for(timeout);
-    }
     return rv;
 }
 
@@ -900,55 +1000,48 @@ bool Processor<EndPoint>::process_get_info_packet(
 }
 
 template<typename EndPoint>
-bool Processor<EndPoint>::process_get_info_packet(
-        InputPacket<IPv4EndPoint>&& input_packet,
-        std::vector<dds::xrce::TransportAddress>& address,
-        OutputPacket<IPv4EndPoint>& output_packet) const
+bool Processor<EndPoint>::get_info_submessage(
+        const std::vector<dds::xrce::TransportAddress>& address,
+        std::vector<uint8_t>& submessage) const
 {
     bool rv = false;
 
-    if (input_packet.message->prepare_next_submessage())
+    dds::xrce::ObjectInfo object_info;
+    dds::xrce::ResultStatus result_status = root_.get_info(object_info);
+    if (dds::xrce::STATUS_OK == result_status.status())
     {
-        if (input_packet.message->get_subheader().submessage_id() == dds::xrce::GET_INFO)
+        dds::xrce::AGENT_ActivityInfo agent_info;
+        for (auto &a : address)
         {
-            dds::xrce::GET_INFO_Payload get_info_payload;
-            input_packet.message->get_payload(get_info_payload);
+            agent_info.address_seq().push_back(a);
+        }
+        agent_info.availability(1);
 
-            dds::xrce::ObjectInfo object_info;
-            dds::xrce::ResultStatus result_status = root_.get_info(object_info);
-            if (dds::xrce::STATUS_OK == result_status.status())
-            {
-                dds::xrce::AGENT_ActivityInfo agent_info;
-                for (auto &a : address)
-                {
-                    agent_info.address_seq().push_back(a);
-                }
-                agent_info.availability(1);
-
-                dds::xrce::ActivityInfoVariant info_variant;
-                info_variant.agent(agent_info);
-                object_info.activity(info_variant);
-
-                dds::xrce::INFO_Payload info_payload;
-                info_payload.related_request().request_id(get_info_payload.request_id());
-                info_payload.related_request().object_id(get_info_payload.object_id());
-                info_payload.result(result_status);
-                info_payload.object_info(object_info);
-
-                dds::xrce::SubmessageHeader info_subheader;
-                info_subheader.submessage_id(dds::xrce::INFO);
-                info_subheader.flags(dds::xrce::FLAG_LITTLE_ENDIANNESS);
-                info_subheader.submessage_length(uint16_t(info_payload.getCdrSerializedSize()));
-
-                const size_t message_size = input_packet.message->get_header().getCdrSerializedSize() +
-                                            info_subheader.getCdrSerializedSize() +
-                                            info_payload.getCdrSerializedSize();
-
-                output_packet.destination = input_packet.source;
-                output_packet.message = OutputMessagePtr(new OutputMessage(input_packet.message->get_header(),
-                                                                           message_size));
-                rv = output_packet.message->append_submessage(dds::xrce::INFO, info_payload);
-            }
+        dds::xrce::ActivityInfoVariant info_variant;
+        info_variant.agent(agent_info);
+        object_info.activity(info_variant);
+
+        dds::xrce::INFO_Payload info_payload;
+        info_payload.result(result_status);
+        info_payload.object_info(object_info);
+
+        /* No member is aligned to more than 4 bytes, so it fits after any message header. */
+        dds::xrce::MessageHeader header;
+        header.session_id(dds::xrce::SESSIONID_NONE_WITHOUT_CLIENT_KEY);
+        header.stream_id(dds::xrce::STREAMID_NONE);
+        header.sequence_nr(0x0000);
+
+        dds::xrce::SubmessageHeader info_subheader;
+        const size_t message_size = header.getCdrSerializedSize() +
+                                    info_subheader.getCdrSerializedSize() +
+                                    info_payload.getCdrSerializedSize();
+
+        OutputMessage output_message{header, message_size};
+        if (output_message.append_submessage(dds::xrce::INFO, info_payload, dds::xrce::FLAG_LITTLE_ENDIANNESS))
+        {
+            const uint8_t* buf = output_message.get_buf();
+            submessage.assign(buf + header.getCdrSerializedSize(), buf + output_message.get_len());
+            rv = true;
         }
     }
 
@@ -995,6 +1088,7 @@ void Processor<EndPoint>::check_heartbeats()
                     output_packet.message = OutputMessagePtr(new OutputMessage(header, message_size));
                     output_packet.message->append_submessage(dds::xrce::HEARTBEAT, heartbeat);
 
+                    client->get_link_pacer().consume(output_packet.message->get_len());
                     server_.push_output_packet(std::move(output_packet));
                 }
             }
@@ -1023,6 +1117,7 @@ void Processor<EndPoint>::check_heartbeats()
             output_packet.message = OutputMessagePtr(new OutputMessage(header, get_info_size));
             output_packet.message->append_submessage(dds::xrce::GET_INFO, get_info_payload);
 
+            client->get_link_pacer().consume(output_packet.message->get_len());
             server_.push_output_packet(std::move(output_packet));
         }
         else if (client->has_hard_liveliness_check() &&ProxyClient::State::to_remove == state)
@@ -1041,6 +1136,21 @@ void Processor<EndPoint>::check_heartbeats()
     }
 }
 
+template<typename EndPoint>
+void Processor<EndPoint>::check_acknacks(
+        const std::vector<uint32_t>& raw_client_keys)
+{
+    EndPoint destination;
+    for (const auto& raw_key : raw_client_keys)
+    {
+        std::shared_ptr<ProxyClient> client = root_.get_client(conversion::raw_to_clientkey(raw_key));
+        if (client && server_.get_endpoint(raw_key, destination))
+        {
+            flush_acknacks(*client, destination, false);
+        }
+    }
+}
+
 template class Processor<IPv4EndPoint>;
 template class Processor<IPv6EndPoint>;
 template class Processor<CanEndPoint>;
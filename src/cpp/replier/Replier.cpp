@@ -63,7 +63,17 @@ std::unique_ptr<Replier> Replier::create(
             break;
     }
 
-    return (created_entity ? std::unique_ptr<Replier>(new Replier(object_id, proxy_client)) : nullptr);
+    if (!created_entity)
+    {
+        return nullptr;
+    }
+
+    Replier* replier = new Replier(object_id, proxy_client);
+    if (middleware.set_request_available_callback(raw_object_id, std::bind(&Reader<bool>::notify, &replier->reader_)))
+    {
+        replier->reader_.set_notified(true);
+    }
+    return std::unique_ptr<Replier>(replier);
 }
 
 Replier::Replier(
@@ -72,10 +82,14 @@ Replier::Replier(
     : XRCEObject{object_id}
     , proxy_client_{proxy_client}
     , reader_{}
-{}
+{
+    reader_.set_link_pacer(&proxy_client_->get_link_pacer());
+}
 
 Replier::~Replier()
 {
+    proxy_client_->get_middleware().set_request_available_callback(get_raw_id(), nullptr);
+    reader_.stop_reading();
     proxy_client_->get_middleware().delete_replier(get_raw_id());
 }
 
@@ -174,6 +188,7 @@ bool Replier::read(
     */
 
     write_args.client = proxy_client_;
+    write_args.resume = reader_.get_resume_fn();
 
     using namespace std::placeholders;
     return (reader_.stop_reading() &&
@@ -21,6 +21,8 @@
 #include <fastcdr/FastBuffer.h>
 #include <fastcdr/Cdr.h>
 
+#include <array>
+
 namespace eprosima {
 namespace uxr {
 
@@ -65,7 +67,17 @@ std::unique_ptr<Requester> Requester::create(
             break;
     }
 
-    return (created_entity ? std::unique_ptr<Requester>(new Requester(object_id, proxy_client)) : nullptr);
+    if (!created_entity)
+    {
+        return nullptr;
+    }
+
+    Requester* requester = new Requester(object_id, proxy_client);
+    if (middleware.set_reply_available_callback(raw_object_id, std::bind(&Reader<bool>::notify, &requester->reader_)))
+    {
+        requester->reader_.set_notified(true);
+    }
+    return std::unique_ptr<Requester>(requester);
 }
 
 Requester::Requester(
@@ -74,10 +86,14 @@ Requester::Requester(
     : XRCEObject{object_id}
     , proxy_client_{proxy_client}
     , reader_{}
-{}
+{
+    reader_.set_link_pacer(&proxy_client_->get_link_pacer());
+}
 
 Requester::~Requester()
 {
+    proxy_client_->get_middleware().set_reply_available_callback(get_raw_id(), nullptr);
+    reader_.stop_reading();
     proxy_client_->get_middleware().delete_requester(get_raw_id());
 }
 
@@ -180,6 +196,7 @@ bool Requester::read(
     */
 
     write_args.client = proxy_client_;
+    write_args.resume = reader_.get_resume_fn();
 
     using namespace std::placeholders;
     return (reader_.stop_reading() &&
@@ -194,27 +211,27 @@ bool Requester::read_fn(
 {
     bool rv = false;
     uint32_t sequence_number = 0;
-    dds::xrce::BaseObjectRequest request;
-    std::vector<uint8_t> temp_data;
 
-    if (proxy_client_->get_middleware().read_reply(get_raw_id(), sequence_number, temp_data, timeout))
+    /* The reply is read in place and the request header is put in front of it. */
+    if (proxy_client_->get_middleware().read_reply(get_raw_id(), sequence_number, data, timeout))
     {
+        dds::xrce::BaseObjectRequest request;
         request.object_id() = get_id();
         request.request_id()[0] = uint8_t((sequence_number >> 8) & 0xFF);
         request.request_id()[1] = uint8_t(sequence_number & 0xFF);
 
-        data.resize(request.getMaxCdrSerializedSize() + temp_data.size());
-        fastcdr::FastBuffer fastbuffer{reinterpret_cast<char*>(data.data()), data.size()};
+        std::array<uint8_t, 4> header;
+        fastcdr::FastBuffer fastbuffer{reinterpret_cast<char*>(header.data()), header.size()};
         fastcdr::Cdr serializer(fastbuffer, eprosima::fastcdr::Cdr::DEFAULT_ENDIAN, eprosima::fastcdr::CdrVersion::XCDRv1);
-
         request.serialize(serializer);
-        serializer.serialize_array(temp_data.data(), temp_data.size());
 
         UXR_AGENT_LOG_MESSAGE(
             UXR_DECORATE_YELLOW("[==>> DDS <<==]"),
             get_raw_id(),
-            temp_data.data(),
-            temp_data.size());
+            data.data(),
+            data.size());
+
+        data.insert(data.begin(), header.begin(), header.end());
         rv = true;
     }
     return rv;
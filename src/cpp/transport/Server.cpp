@@ -26,6 +26,7 @@
 #include <uxr/agent/transport/endpoint/CustomEndPoint.hpp>
 
 #include <functional>
+#include <algorithm>
 
 #define RECEIVE_TIMEOUT 1000   // Milliseconds
 
@@ -48,6 +49,9 @@ Server<EndPoint>::Server(Middleware::Kind middleware_kind)
     , transport_rc_{TransportRc::ok}
     , error_mtx_{}
     , error_cv_{}
+    , acknack_timers_{}
+    , acknack_mtx_{}
+    , acknack_cv_{}
 {}
 
 template<typename EndPoint>
@@ -95,6 +99,10 @@ bool Server<EndPoint>::stop()
 
     error_cv_.notify_all();
 
+    std::unique_lock<std::mutex> acknack_lock(acknack_mtx_);
+    acknack_cv_.notify_all();
+    acknack_lock.unlock();
+
     /* Join threads. */
     if (receiver_thread_.joinable())
     {
@@ -283,10 +291,54 @@ void Server<EndPoint>::processing_loop()
 template<typename EndPoint>
 void Server<EndPoint>::heartbeat_loop()
 {
+    /* Sleeps until the next heartbeat or the earliest delayed ACKNACK, whichever comes first. */
+    const std::chrono::milliseconds heartbeat_period{HEARTBEAT_PERIOD};
+    auto next_heartbeat = std::chrono::steady_clock::now();
+    std::vector<uint32_t> due_clients;
+    std::unique_lock<std::mutex> lock(acknack_mtx_);
     while (running_cond_)
     {
-        processor_->check_heartbeats();
-        std::this_thread::sleep_for(std::chrono::milliseconds(HEARTBEAT_PERIOD));
+        auto wake_time = next_heartbeat;
+        if (!acknack_timers_.empty())
+        {
+            wake_time = std::min(wake_time, acknack_timers_.top().first);
+        }
+        acknack_cv_.wait_until(lock, wake_time);
+
+        auto now = std::chrono::steady_clock::now();
+        while (!acknack_timers_.empty() && (acknack_timers_.top().first <= now))
+        {
+            due_clients.push_back(acknack_timers_.top().second);
+            acknack_timers_.pop();
+        }
+        lock.unlock();
+
+        if (!due_clients.empty())
+        {
+            processor_->check_acknacks(due_clients);
+            due_clients.clear();
+        }
+        if (now >= next_heartbeat)
+        {
+            processor_->check_heartbeats();
+            next_heartbeat = now + heartbeat_period;
+        }
+
+        lock.lock();
+    }
+}
+
+template<typename EndPoint>
+void Server<EndPoint>::push_acknack_timer(
+        uint32_t raw_client_key,
+        std::chrono::steady_clock::time_point deadline)
+{
+    std::lock_guard<std::mutex> lock(acknack_mtx_);
+    const bool earliest = acknack_timers_.empty() || (deadline < acknack_timers_.top().first);
+    acknack_timers_.emplace(deadline, raw_client_key);
+    if (earliest)
+    {
+        acknack_cv_.notify_one();
     }
 }
 
@@ -175,7 +175,7 @@ bool CanAgent::recv_message(
             rv = true;
 
             uint32_t raw_client_key;
-            if (Server<CanEndPoint>::get_client_key(input_packet.source, raw_client_key))
+            if (UXR_AGENT_LOG_MESSAGE_ENABLED() && Server<CanEndPoint>::get_client_key(input_packet.source, raw_client_key))
             {
                 UXR_AGENT_LOG_MESSAGE(
                     UXR_DECORATE_YELLOW("[==>> CAN <<==]"),
@@ -229,7 +229,7 @@ bool CanAgent::send_message(
             rv = true;
 
             uint32_t raw_client_key;
-            if (Server<CanEndPoint>::get_client_key(output_packet.destination, raw_client_key))
+            if (UXR_AGENT_LOG_MESSAGE_ENABLED() && Server<CanEndPoint>::get_client_key(output_packet.destination, raw_client_key))
             {
                 UXR_AGENT_LOG_MESSAGE(
                     UXR_DECORATE_YELLOW("[** <<CAN>> **]"),
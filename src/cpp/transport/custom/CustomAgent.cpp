@@ -215,7 +215,10 @@ bool CustomAgent::recv_message(
             input_packet.source = *recv_endpoint_;
 
             uint32_t raw_client_key = 0u;
-            this->get_client_key(input_packet.source, raw_client_key);
+            if (UXR_AGENT_LOG_MESSAGE_ENABLED())
+            {
+                this->get_client_key(input_packet.source, raw_client_key);
+            }
 
             std::stringstream ss;
             ss << UXR_COLOR_YELLOW << "[==>> " << name_ << " <<==]" << UXR_COLOR_RESET;
@@ -281,7 +284,10 @@ bool CustomAgent::send_message(
         if (success)
         {
             uint32_t raw_client_key = 0u;
-            this->get_client_key(output_packet.destination, raw_client_key);
+            if (UXR_AGENT_LOG_MESSAGE_ENABLED())
+            {
+                this->get_client_key(output_packet.destination, raw_client_key);
+            }
 
             std::stringstream ss;
             ss << UXR_COLOR_YELLOW << "[** <<" << name_ << ">> **]" << UXR_COLOR_RESET;
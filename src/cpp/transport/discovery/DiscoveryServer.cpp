@@ -15,10 +15,17 @@
 #include <uxr/agent/transport/discovery/DiscoveryServer.hpp>
 #include <uxr/agent/processor/Processor.hpp>
 
+#include <cstring>
 #include <functional>
 
 #define RECEIVE_TIMEOUT 100
 
+/* Replies per source and second, and at once, enough for clients and agents probing every 100 ms. */
+#define DISCOVERY_SOURCE_RATE 20
+#define DISCOVERY_SOURCE_BURST 20
+#define DISCOVERY_MAX_SOURCES 4096
+#define DISCOVERY_MAX_BATCHED_REPLIES 64
+
 namespace eprosima {
 namespace uxr {
 
@@ -32,6 +39,8 @@ DiscoveryServer<EndPoint>::DiscoveryServer(
     , thread_{}
     , running_cond_{false}
     , processor_{processor}
+    , info_submessage_{}
+    , rate_limiter_{DISCOVERY_SOURCE_RATE, DISCOVERY_SOURCE_BURST, DISCOVERY_MAX_SOURCES}
     , transport_addresses_{}
     , agent_port_{}
     , discovery_port_{}
@@ -52,20 +61,74 @@ bool DiscoveryServer<EndPoint>::stop()
     return close();
 }
 
+template<typename EndPoint>
+bool DiscoveryServer<EndPoint>::build_reply(
+        InputPacket<IPv4EndPoint>& input_packet,
+        InfoReply& reply) const
+{
+    bool rv = false;
+
+    dds::xrce::GET_INFO_Payload get_info_payload;
+    if (!info_submessage_.empty() &&
+        input_packet.message->prepare_next_submessage() &&
+        (dds::xrce::GET_INFO == input_packet.message->get_subheader().submessage_id()) &&
+        input_packet.message->get_payload(get_info_payload))
+    {
+        std::array<uint8_t, 8> header;
+        const size_t header_len = input_packet.message->get_raw_header(header);
+
+        /* Request header, INFO subheader and the related request, the only parts that are not cached. */
+        uint8_t* head = reply.head.data();
+        std::memcpy(head, header.data(), header_len);
+        std::memcpy(head + header_len, info_submessage_.data(), info_tail_offset - 4);
+        head += header_len + info_tail_offset - 4;
+        head[0] = get_info_payload.request_id()[0];
+        head[1] = get_info_payload.request_id()[1];
+        head[2] = get_info_payload.object_id()[0];
+        head[3] = get_info_payload.object_id()[1];
+
+        reply.head_len = header_len + info_tail_offset;
+        reply.destination = input_packet.source;
+        rv = true;
+    }
+
+    return rv;
+}
+
 template<typename EndPoint>
 void DiscoveryServer<EndPoint>::discovery_loop()
 {
     InputPacket<IPv4EndPoint> input_packet;
-    OutputPacket<IPv4EndPoint> output_packet;
+    std::vector<InfoReply> replies;
+    replies.reserve(DISCOVERY_MAX_BATCHED_REPLIES);
+    InfoReply reply{};
+
+    processor_.get_info_submessage(transport_addresses_, info_submessage_);
     while (running_cond_)
     {
-        if (recv_message(input_packet, RECEIVE_TIMEOUT))
+        /* The requests already queued are answered together. */
+        int timeout = RECEIVE_TIMEOUT;
+        while ((replies.size() < DISCOVERY_MAX_BATCHED_REPLIES) && recv_message(input_packet, timeout))
         {
-            if (processor_.process_get_info_packet(std::move(input_packet), transport_addresses_, output_packet))
+            timeout = 0;
+            const uint64_t source = (uint64_t(input_packet.source.get_addr()) << 16) | input_packet.source.get_port();
+            if (rate_limiter_.consume(source) && build_reply(input_packet, reply))
             {
-                send_message(std::move(output_packet));
+                replies.push_back(reply);
             }
         }
+
+        if (!replies.empty())
+        {
+            send_replies(replies, info_submessage_);
+            replies.clear();
+        }
+
+        /* The cached reply is only rebuilt when the interfaces change. */
+        if (update_transport_addresses())
+        {
+            processor_.get_info_submessage(transport_addresses_, info_submessage_);
+        }
     }
 }
 
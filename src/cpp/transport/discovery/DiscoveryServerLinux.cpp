@@ -15,6 +15,7 @@
 #include <uxr/agent/transport/discovery/DiscoveryServerLinux.hpp>
 #include <uxr/agent/transport/endpoint/IPv4EndPoint.hpp>
 #include <uxr/agent/processor/Processor.hpp>
+#include <uxr/agent/transport/util/InterfaceLinux.hpp>
 #include <uxr/agent/logger/Logger.hpp>
 
 #include <sys/socket.h>
@@ -22,6 +23,8 @@
 #include <arpa/inet.h>
 #include <unistd.h>
 #include <ifaddrs.h>
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
 
 #define RECEIVE_TIMEOUT 100
 namespace eprosima {
@@ -32,6 +35,8 @@ DiscoveryServerLinux<EndPoint>::DiscoveryServerLinux(
         const Processor<EndPoint>& processor)
     : DiscoveryServer<EndPoint>(processor)
     , poll_fd_{-1, 0, 0}
+    , netlink_fd_{-1}
+    , interfaces_changed_{false}
     , buffer_{0}
 {}
 
@@ -94,6 +99,25 @@ bool DiscoveryServerLinux<EndPoint>::init(
                 UXR_DECORATE_GREEN("running..."),
                 "Port: {}",
                 discovery_port);
+
+            /* Address changes, otherwise the addresses found at start up are kept. */
+            netlink_fd_ = socket(AF_NETLINK, SOCK_RAW | SOCK_NONBLOCK | SOCK_CLOEXEC, NETLINK_ROUTE);
+            struct sockaddr_nl netlink_address{};
+            netlink_address.nl_family = AF_NETLINK;
+            netlink_address.nl_groups = RTMGRP_IPV4_IFADDR | RTMGRP_IPV6_IFADDR;
+            if ((-1 == netlink_fd_) ||
+                (-1 == bind(netlink_fd_, reinterpret_cast<struct sockaddr*>(&netlink_address), sizeof(netlink_address))))
+            {
+                UXR_AGENT_LOG_WARN(
+                    UXR_DECORATE_YELLOW("netlink error, interface changes will not be advertised"),
+                    "errno: {}",
+                    errno);
+                if (-1 != netlink_fd_)
+                {
+                    ::close(netlink_fd_);
+                    netlink_fd_ = -1;
+                }
+            }
         }
         else
         {
@@ -110,6 +134,12 @@ bool DiscoveryServerLinux<EndPoint>::init(
 template<typename EndPoint>
 bool DiscoveryServerLinux<EndPoint>::close()
 {
+    if (-1 != netlink_fd_)
+    {
+        ::close(netlink_fd_);
+        netlink_fd_ = -1;
+    }
+
     if (-1 == poll_fd_.fd)
     {
         return true;
@@ -144,8 +174,18 @@ bool DiscoveryServerLinux<EndPoint>::recv_message(
     struct sockaddr client_addr;
     socklen_t client_addr_len = sizeof(client_addr);
 
-    int poll_rv = poll(&poll_fd_, 1, timeout);
-    if (0 < poll_rv)
+    struct pollfd poll_fds[2] = {poll_fd_, {netlink_fd_, POLLIN, 0}};
+    int poll_rv = poll(poll_fds, 2, timeout);
+    if ((0 < poll_rv) && (0 != (poll_fds[1].revents & POLLIN)))
+    {
+        /* Every pending notification is consumed, the addresses are got once. */
+        while (0 < recv(netlink_fd_, buffer_, sizeof(buffer_), 0))
+        {
+        }
+        interfaces_changed_ = true;
+    }
+
+    if ((0 < poll_rv) && (0 != (poll_fds[0].revents & POLLIN)))
     {
         ssize_t bytes_received = recvfrom(poll_fd_.fd, buffer_, sizeof(buffer_), 0, &client_addr, &client_addr_len);
         if (0 < bytes_received)
@@ -198,33 +238,76 @@ bool DiscoveryServerLinux<EndPoint>::recv_message(
 }
 
 template<typename EndPoint>
-bool DiscoveryServerLinux<EndPoint>::send_message(
-        OutputPacket<IPv4EndPoint>&& output_packet)
+bool DiscoveryServerLinux<EndPoint>::send_replies(
+        const std::vector<typename DiscoveryServer<EndPoint>::InfoReply>& replies,
+        const std::vector<uint8_t>& info_submessage)
 {
-    bool rv = false;
-    struct sockaddr_in client_addr;
-
-    client_addr.sin_family = AF_INET;
-    client_addr.sin_port = output_packet.destination.get_port();
-    client_addr.sin_addr.s_addr = output_packet.destination.get_addr();
-    ssize_t bytes_sent =
-            sendto(poll_fd_.fd,
-                   output_packet.message->get_buf(),
-                   output_packet.message->get_len(),
-                   0,
-                   reinterpret_cast<struct sockaddr*>(&client_addr),
-                   sizeof(client_addr));
-    if (0 < bytes_sent)
+    constexpr size_t tail_offset = DiscoveryServer<EndPoint>::info_tail_offset;
+
+    /* Each reply gathers its own head and the tail shared by all of them, sent with a single call. */
+    std::vector<struct sockaddr_in> client_addrs(replies.size());
+    std::vector<struct iovec> iovs(2 * replies.size());
+    std::vector<struct mmsghdr> msgs(replies.size());
+    for (size_t i = 0; i < replies.size(); ++i)
     {
-        rv = (size_t(bytes_sent) == output_packet.message->get_len());
+        client_addrs[i].sin_family = AF_INET;
+        client_addrs[i].sin_port = replies[i].destination.get_port();
+        client_addrs[i].sin_addr.s_addr = replies[i].destination.get_addr();
 
-        UXR_AGENT_LOG_MESSAGE(
-            UXR_DECORATE_YELLOW("[** <<UDP>> **]"),
-            output_packet.destination.get_addr(),
-            output_packet.message->get_buf(),
-            output_packet.message->get_len());
+        iovs[2 * i].iov_base = const_cast<uint8_t*>(replies[i].head.data());
+        iovs[2 * i].iov_len = replies[i].head_len;
+        iovs[2 * i + 1].iov_base = const_cast<uint8_t*>(info_submessage.data() + tail_offset);
+        iovs[2 * i + 1].iov_len = info_submessage.size() - tail_offset;
+
+        msgs[i].msg_hdr.msg_name = &client_addrs[i];
+        msgs[i].msg_hdr.msg_namelen = sizeof(client_addrs[i]);
+        msgs[i].msg_hdr.msg_iov = &iovs[2 * i];
+        msgs[i].msg_hdr.msg_iovlen = 2;
     }
 
+    size_t sent = 0;
+    while (sent < msgs.size())
+    {
+        int rv = sendmmsg(poll_fd_.fd, msgs.data() + sent, unsigned(msgs.size() - sent), 0);
+        if (0 >= rv)
+        {
+            break;
+        }
+        sent += size_t(rv);
+    }
+
+    if (UXR_AGENT_LOG_MESSAGE_ENABLED())
+    {
+        for (size_t i = 0; i < sent; ++i)
+        {
+            std::vector<uint8_t> message(replies[i].head.data(), replies[i].head.data() + replies[i].head_len);
+            message.insert(message.end(), info_submessage.begin() + tail_offset, info_submessage.end());
+            UXR_AGENT_LOG_MESSAGE(
+                UXR_DECORATE_YELLOW("[** <<UDP>> **]"),
+                replies[i].destination.get_addr(),
+                message.data(),
+                message.size());
+        }
+    }
+
+    return sent == msgs.size();
+}
+
+template<typename EndPoint>
+bool DiscoveryServerLinux<EndPoint>::update_transport_addresses()
+{
+    bool rv = interfaces_changed_;
+    if (rv)
+    {
+        interfaces_changed_ = false;
+        util::get_transport_interfaces<EndPoint>(
+            DiscoveryServer<EndPoint>::agent_port_,
+            DiscoveryServer<EndPoint>::transport_addresses_);
+        UXR_AGENT_LOG_DEBUG(
+            UXR_DECORATE_GREEN("interfaces changed"),
+            "addresses: {}",
+            DiscoveryServer<EndPoint>::transport_addresses_.size());
+    }
     return rv;
 }
 
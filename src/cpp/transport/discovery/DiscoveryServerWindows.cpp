@@ -191,31 +191,44 @@ bool DiscoveryServerWindows<EndPoint>::recv_message(
 }
 
 template<typename EndPoint>
-bool DiscoveryServerWindows<EndPoint>::send_message(
-        OutputPacket<IPv4EndPoint>&& output_packet)
+bool DiscoveryServerWindows<EndPoint>::send_replies(
+        const std::vector<typename DiscoveryServer<EndPoint>::InfoReply>& replies,
+        const std::vector<uint8_t>& info_submessage)
 {
-    bool rv = false;
-    struct sockaddr_in client_addr;
-
-    client_addr.sin_family = AF_INET;
-    client_addr.sin_port = output_packet.destination.get_port();
-    client_addr.sin_addr.s_addr = output_packet.destination.get_addr();
-    int bytes_sent =
-            sendto(poll_fd_.fd,
-                   reinterpret_cast<char*>(output_packet.message->get_buf()),
-                   int(output_packet.message->get_len()),
-                   0,
-                   reinterpret_cast<struct sockaddr*>(&client_addr),
-                   int(sizeof(client_addr)));
-    if (SOCKET_ERROR != bytes_sent)
+    constexpr size_t tail_offset = DiscoveryServer<EndPoint>::info_tail_offset;
+
+    bool rv = true;
+    std::vector<uint8_t> message;
+    for (const auto& reply : replies)
     {
-        rv = (size_t(bytes_sent) == output_packet.message->get_len());
+        struct sockaddr_in client_addr;
+        client_addr.sin_family = AF_INET;
+        client_addr.sin_port = reply.destination.get_port();
+        client_addr.sin_addr.s_addr = reply.destination.get_addr();
+
+        message.assign(reply.head.data(), reply.head.data() + reply.head_len);
+        message.insert(message.end(), info_submessage.begin() + tail_offset, info_submessage.end());
+        int bytes_sent =
+                sendto(poll_fd_.fd,
+                       reinterpret_cast<char*>(message.data()),
+                       int(message.size()),
+                       0,
+                       reinterpret_cast<struct sockaddr*>(&client_addr),
+                       int(sizeof(client_addr)));
+        if (SOCKET_ERROR != bytes_sent)
+        {
+            rv &= (size_t(bytes_sent) == message.size());
 
-        UXR_AGENT_LOG_MESSAGE(
-            UXR_DECORATE_YELLOW("[** <<UDP>> **]"),
-            output_packet.destination.get_addr(),
-            output_packet.message->get_buf(),
-            output_packet.message->get_len());
+            UXR_AGENT_LOG_MESSAGE(
+                UXR_DECORATE_YELLOW("[** <<UDP>> **]"),
+                reply.destination.get_addr(),
+                message.data(),
+                message.size());
+        }
+        else
+        {
+            rv = false;
+        }
     }
 
     return rv;
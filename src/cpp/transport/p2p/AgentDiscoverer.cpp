@@ -15,9 +15,13 @@
 #include <uxr/agent/transport/p2p/AgentDiscoverer.hpp>
 #include <uxr/agent/p2p/InternalClientManager.hpp>
 
+#include <chrono>
+
 namespace eprosima {
 namespace uxr {
 
+constexpr std::chrono::milliseconds discovery_period(100);
+
 AgentDiscoverer::AgentDiscoverer(
         Agent& agent)
     : agent_(agent)
@@ -63,6 +67,8 @@ bool AgentDiscoverer::stop()
 
 void AgentDiscoverer::loop()
 {
+    using namespace std::chrono;
+
     /* Header. */
     dds::xrce::MessageHeader header;
     header.session_id(dds::xrce::SESSIONID_NONE_WITHOUT_CLIENT_KEY);
@@ -91,11 +97,15 @@ void AgentDiscoverer::loop()
     while (running_cond_)
     {
         send_message(output_message);
-        bool message_received;
-        do
+
+        /* Replies are handled as soon as they arrive, until the next request is due. */
+        const steady_clock::time_point next_request = steady_clock::now() + discovery_period;
+        for (steady_clock::time_point now = steady_clock::now();
+             running_cond_ && (now < next_request);
+             now = steady_clock::now())
         {
-            message_received = recv_message(input_message, 0);
-            if (message_received)
+            const int timeout = int(duration_cast<milliseconds>(next_request - now).count()) + 1;
+            if (recv_message(input_message, timeout))
             {
                 dds::xrce::INFO_Payload info_payload;
                 input_message->prepare_next_submessage();
@@ -105,8 +115,7 @@ void AgentDiscoverer::loop()
                 InternalClientManager& manager = InternalClientManager::instance();
                 manager.create_client(agent_, address.address(), address.port());
             }
-        } while(message_received);
-        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
     }
 }
 
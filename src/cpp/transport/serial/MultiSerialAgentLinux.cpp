@@ -110,7 +110,7 @@ bool MultiSerialAgent::recv_message(
                     rv = true;
 
                     uint32_t raw_client_key;
-                    if (Server<MultiSerialEndPoint>::get_client_key(aux_pack.source, raw_client_key))
+                    if (UXR_AGENT_LOG_MESSAGE_ENABLED() && Server<MultiSerialEndPoint>::get_client_key(aux_pack.source, raw_client_key))
                     {
                         UXR_MULTIAGENT_LOG_MESSAGE(
                             UXR_DECORATE_YELLOW("[==>> SER <<==]"),
@@ -162,7 +162,7 @@ bool MultiSerialAgent::send_message(
         rv = true;
 
         uint32_t raw_client_key;
-        if (Server<MultiSerialEndPoint>::get_client_key(output_packet.destination, raw_client_key))
+        if (UXR_AGENT_LOG_MESSAGE_ENABLED() && Server<MultiSerialEndPoint>::get_client_key(output_packet.destination, raw_client_key))
         {
             UXR_MULTIAGENT_LOG_MESSAGE(
                 UXR_DECORATE_YELLOW("[** <<SER>> **]"),
@@ -102,7 +102,7 @@ bool SerialAgent::recv_message(
         rv = true;
 
         uint32_t raw_client_key;
-        if (Server<SerialEndPoint>::get_client_key(input_packet.source, raw_client_key))
+        if (UXR_AGENT_LOG_MESSAGE_ENABLED() && Server<SerialEndPoint>::get_client_key(input_packet.source, raw_client_key))
         {
             UXR_AGENT_LOG_MESSAGE(
                 UXR_DECORATE_YELLOW("[==>> SER <<==]"),
@@ -131,7 +131,7 @@ bool SerialAgent::send_message(
         rv = true;
 
         uint32_t raw_client_key;
-        if (Server<SerialEndPoint>::get_client_key(output_packet.destination, raw_client_key))
+        if (UXR_AGENT_LOG_MESSAGE_ENABLED() && Server<SerialEndPoint>::get_client_key(output_packet.destination, raw_client_key))
         {
             UXR_AGENT_LOG_MESSAGE(
                 UXR_DECORATE_YELLOW("[** <<SER>> **]"),
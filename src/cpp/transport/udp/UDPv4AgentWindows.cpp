@@ -135,7 +135,7 @@ bool UDPv4Agent::init_discovery(uint16_t discovery_port)
 {
     std::vector<dds::xrce::TransportAddress> transport_addresses;
     util::get_transport_interfaces<IPv4EndPoint>(this->agent_port_, transport_addresses);
-    return discovery_server_.run(discovery_port, transport_addresses);
+    return discovery_server_.run(discovery_port, this->agent_port_, transport_addresses);
 }
 
 bool UDPv4Agent::fini_discovery()
@@ -173,7 +173,10 @@ bool UDPv4Agent::recv_message(
             rv = true;
 
             uint32_t raw_client_key = 0u;
-            Server<IPv4EndPoint>::get_client_key(input_packet.source, raw_client_key);
+            if (UXR_AGENT_LOG_MESSAGE_ENABLED())
+            {
+                Server<IPv4EndPoint>::get_client_key(input_packet.source, raw_client_key);
+            }
             UXR_AGENT_LOG_MESSAGE(
                 UXR_DECORATE_YELLOW("[==>> UDP <<==]"),
                 raw_client_key,
@@ -217,7 +220,10 @@ bool UDPv4Agent::send_message(
         {
             rv = true;
             uint32_t raw_client_key = 0u;
-            Server<IPv4EndPoint>::get_client_key(output_packet.destination, raw_client_key);
+            if (UXR_AGENT_LOG_MESSAGE_ENABLED())
+            {
+                Server<IPv4EndPoint>::get_client_key(output_packet.destination, raw_client_key);
+            }
             UXR_AGENT_LOG_MESSAGE(
                 UXR_DECORATE_YELLOW("[** <<UDP>> **]"),
                 raw_client_key,
@@ -20,6 +20,7 @@
 #include <unistd.h>
 #include <sys/types.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <netinet/in.h>
 #include <arpa/inet.h>
 #include <cstring>
@@ -142,7 +143,7 @@ bool UDPv6Agent::init_discovery(
 {
     std::vector<dds::xrce::TransportAddress> transport_addresses;
     util::get_transport_interfaces<IPv6EndPoint>(this->agent_port_, transport_addresses);
-    return discovery_server_.run(discovery_port, std::move(transport_addresses));
+    return discovery_server_.run(discovery_port, this->agent_port_, std::move(transport_addresses));
 }
 
 bool UDPv6Agent::fini_discovery()
@@ -194,7 +195,10 @@ bool UDPv6Agent::recv_message(
             rv = true;
 
             uint32_t raw_client_key = 0u;
-            Server<IPv6EndPoint>::get_client_key(input_packet.source, raw_client_key);
+            if (UXR_AGENT_LOG_MESSAGE_ENABLED())
+            {
+                Server<IPv6EndPoint>::get_client_key(input_packet.source, raw_client_key);
+            }
             UXR_AGENT_LOG_MESSAGE(
                 UXR_DECORATE_YELLOW("[==>> UDP <<==]"),
                 raw_client_key,
@@ -227,21 +231,30 @@ bool UDPv6Agent::send_message(
     const std::array<uint8_t, 16>& destination = output_packet.destination.get_addr();
     std::copy(destination.begin(), destination.end(), std::begin(client_addr.sin6_addr.s6_addr));
 
-    ssize_t bytes_sent =
-        sendto(
-            poll_fd_.fd,
-            output_packet.message->get_buf(),
-            output_packet.message->get_len(),
-            0,
-            reinterpret_cast<struct sockaddr*>(&client_addr),
-            sizeof(client_addr));
+    /* Gather header and payload slice, fragments are sent without flattening. */
+    struct iovec iov[2];
+    iov[0].iov_base = const_cast<uint8_t*>(output_packet.message->get_head());
+    iov[0].iov_len = output_packet.message->get_head_len();
+    iov[1].iov_base = const_cast<uint8_t*>(output_packet.message->get_payload());
+    iov[1].iov_len = output_packet.message->get_payload_len();
+
+    struct msghdr msg{};
+    msg.msg_name = &client_addr;
+    msg.msg_namelen = sizeof(client_addr);
+    msg.msg_iov = iov;
+    msg.msg_iovlen = (0 != iov[1].iov_len) ? 2 : 1;
+
+    ssize_t bytes_sent = sendmsg(poll_fd_.fd, &msg, 0);
     if (-1 != bytes_sent)
     {
         if (size_t(bytes_sent) == output_packet.message->get_len())
         {
             rv = true;
             uint32_t raw_client_key = 0u;
-            Server<IPv6EndPoint>::get_client_key(output_packet.destination, raw_client_key);
+            if (UXR_AGENT_LOG_MESSAGE_ENABLED())
+            {
+                Server<IPv6EndPoint>::get_client_key(output_packet.destination, raw_client_key);
+            }
             UXR_AGENT_LOG_MESSAGE(
                 UXR_DECORATE_YELLOW("[** <<UDP>> **]"),
                 raw_client_key,
@@ -136,7 +136,7 @@ bool UDPv6Agent::init_discovery(uint16_t discovery_port)
 {
     std::vector<dds::xrce::TransportAddress> transport_addresses;
     util::get_transport_interfaces<IPv6EndPoint>(this->agent_port_, transport_addresses);
-    return discovery_server_.run(discovery_port, transport_addresses);
+    return discovery_server_.run(discovery_port, this->agent_port_, transport_addresses);
 }
 
 bool UDPv6Agent::fini_discovery()
@@ -174,7 +174,10 @@ bool UDPv6Agent::recv_message(
             rv = true;
 
             uint32_t raw_client_key = 0u;
-            Server<IPv6EndPoint>::get_client_key(input_packet.source, raw_client_key);
+            if (UXR_AGENT_LOG_MESSAGE_ENABLED())
+            {
+                Server<IPv6EndPoint>::get_client_key(input_packet.source, raw_client_key);
+            }
             UXR_AGENT_LOG_MESSAGE(
                 UXR_DECORATE_YELLOW("[==>> UDP <<==]"),
                 raw_client_key,
@@ -220,7 +223,10 @@ bool UDPv6Agent::send_message(
         {
             rv = true;
             uint32_t raw_client_key = 0u;
-            Server<IPv6EndPoint>::get_client_key(output_packet.destination, raw_client_key);
+            if (UXR_AGENT_LOG_MESSAGE_ENABLED())
+            {
+                Server<IPv6EndPoint>::get_client_key(output_packet.destination, raw_client_key);
+            }
             UXR_AGENT_LOG_MESSAGE(
                 UXR_DECORATE_YELLOW("[** <<UDP>> **]"),
                 raw_client_key,
@@ -15,15 +15,48 @@
 #include <uxr/agent/types/TopicPubSubType.hpp>
 #include <fastcdr/FastBuffer.h>
 #include <fastcdr/Cdr.h>
+#include <fastrtps/utils/md5.h>
+
+#include <cstring>
+#include <unordered_map>
 
 namespace eprosima {
 namespace uxr {
 
-TopicPubSubType::TopicPubSubType(bool with_key) {
-    m_typeSize = 1024 + 4 /*encapsulation*/;
+namespace {
+
+/* Key layouts per type name, shared by all the participants. */
+struct KeyLayoutRegistry
+{
+    std::mutex mtx;
+    std::unordered_map<std::string, std::shared_ptr<const KeyLayout>> layouts;
+
+    static KeyLayoutRegistry& instance()
+    {
+        static KeyLayoutRegistry registry;
+        return registry;
+    }
+};
+
+/* Bytes left in front of the samples deserialized by this thread, see TopicPubSubType::Headroom. */
+thread_local size_t deserialize_headroom = 0;
+
+} // unnamed namespace
+
+TopicPubSubType::TopicPubSubType(
+        bool with_key,
+        uint32_t max_sample_size)
+    : max_sample_size_(max_sample_size)
+{
+    m_typeSize = ((0 < max_sample_size) ? max_sample_size : 1024) + 4 /*encapsulation*/;
     m_isGetKeyDefined = with_key;
 }
 
+bool TopicPubSubType::is_bounded() const
+{
+    return (0 < max_sample_size_);
+}
+
 bool TopicPubSubType::serialize(void *data, rtps::SerializedPayload_t *payload)
 {
     bool rv = false;
@@ -44,7 +77,8 @@ bool TopicPubSubType::serialize(void *data, rtps::SerializedPayload_t *payload)
 bool TopicPubSubType::deserialize(rtps::SerializedPayload_t* payload, void* data)
 {
     std::vector<unsigned char>* buffer = reinterpret_cast<std::vector<unsigned char>*>(data);
-    buffer->assign(payload->data + 4, payload->data + payload->length);
+    buffer->assign(deserialize_headroom, 0);
+    buffer->insert(buffer->end(), payload->data + 4, payload->data + payload->length);
 
     return true;
 }
@@ -66,11 +100,79 @@ void TopicPubSubType::deleteData(void* data) {
 
 bool TopicPubSubType::getKey(void *data, rtps::InstanceHandle_t* handle, bool force_md5)
 {
-    // TODO.
-    (void) data;
-    (void) handle;
-    (void) force_md5;
-    return m_isGetKeyDefined;
+    /* Without a layout every sample belongs to the same instance. */
+    bool rv = m_isGetKeyDefined;
+    if (rv)
+    {
+        std::call_once(key_layout_flag_, [this]()
+        {
+            key_layout_ = find_key_layout(getName());
+        });
+    }
+
+    if (rv && key_layout_)
+    {
+        static thread_local std::vector<uint8_t> key;
+        std::vector<unsigned char>* buffer = reinterpret_cast<std::vector<unsigned char>*>(data);
+        rv = extract_key(buffer->data(), buffer->size(), *key_layout_, key);
+        if (rv)
+        {
+            if (force_md5 || (16 < key.size()))
+            {
+                MD5 md5;
+                md5.init();
+                md5.update(key.data(), static_cast<unsigned int>(key.size()));
+                md5.finalize();
+                for (uint8_t i = 0; i < 16; ++i)
+                {
+                    handle->value[i] = md5.digest[i];
+                }
+            }
+            else
+            {
+                for (uint8_t i = 0; i < 16; ++i)
+                {
+                    handle->value[i] = (i < key.size()) ? key[i] : 0;
+                }
+            }
+        }
+    }
+    return rv;
+}
+
+void TopicPubSubType::set_key_layout(
+        const std::string& type_name,
+        const KeyLayout& layout)
+{
+    KeyLayoutRegistry& registry = KeyLayoutRegistry::instance();
+    std::lock_guard<std::mutex> lock(registry.mtx);
+    registry.layouts[type_name] = std::make_shared<const KeyLayout>(layout);
+}
+
+std::shared_ptr<const KeyLayout> TopicPubSubType::find_key_layout(
+        const std::string& type_name)
+{
+    std::shared_ptr<const KeyLayout> layout;
+    KeyLayoutRegistry& registry = KeyLayoutRegistry::instance();
+    std::lock_guard<std::mutex> lock(registry.mtx);
+    auto it = registry.layouts.find(type_name);
+    if (registry.layouts.end() != it)
+    {
+        layout = it->second;
+    }
+    return layout;
+}
+
+TopicPubSubType::Headroom::Headroom(
+        size_t size)
+    : previous_size_(deserialize_headroom)
+{
+    deserialize_headroom = size;
+}
+
+TopicPubSubType::Headroom::~Headroom()
+{
+    deserialize_headroom = previous_size_;
 }
 
 } // namespace uxr
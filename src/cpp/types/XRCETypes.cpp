@@ -7195,6 +7195,7 @@ size_t dds::xrce::Sample::getCdrSerializedSize(size_t current_alignment) const
     size_t initial_alignment = current_alignment;
 
     current_alignment += m_info.getCdrSerializedSize(current_alignment);
+    current_alignment += 4 + eprosima::fastcdr::Cdr::alignment(current_alignment, 4);
     current_alignment += m_data.getCdrSerializedSize(current_alignment);
 
     return current_alignment - initial_alignment;
@@ -7203,13 +7204,14 @@ size_t dds::xrce::Sample::getCdrSerializedSize(size_t current_alignment) const
 void dds::xrce::Sample::serialize(eprosima::fastcdr::Cdr &scdr) const
 {
     scdr << m_info;
-    scdr << m_data;
+    /* Unlike the trailing data of DATA_Payload_Data, the sample data is length prefixed here. */
+    scdr << m_data.serialized_data();
 }
 
 void dds::xrce::Sample::deserialize(eprosima::fastcdr::Cdr &dcdr)
 {
     dcdr >> m_info;
-    dcdr >> m_data;
+    dcdr >> m_data.serialized_data();
 }
 
 dds::xrce::SampleDelta::SampleDelta()
@@ -7263,6 +7265,7 @@ size_t dds::xrce::SampleDelta::getCdrSerializedSize(size_t current_alignment) co
     size_t initial_alignment = current_alignment;
 
     current_alignment += m_info_delta.getCdrSerializedSize(current_alignment);
+    current_alignment += 4 + eprosima::fastcdr::Cdr::alignment(current_alignment, 4);
     current_alignment += m_data.getCdrSerializedSize(current_alignment);
 
     return current_alignment - initial_alignment;
@@ -7271,13 +7274,14 @@ size_t dds::xrce::SampleDelta::getCdrSerializedSize(size_t current_alignment) co
 void dds::xrce::SampleDelta::serialize(eprosima::fastcdr::Cdr &scdr) const
 {
     scdr << m_info_delta;
-    scdr << m_data;
+    /* Unlike the trailing data of DATA_Payload_Data, the sample data is length prefixed here. */
+    scdr << m_data.serialized_data();
 }
 
 void dds::xrce::SampleDelta::deserialize(eprosima::fastcdr::Cdr &dcdr)
 {
     dcdr >> m_info_delta;
-    dcdr >> m_data;
+    dcdr >> m_data.serialized_data();
 }
 
 dds::xrce::PackedSamples::PackedSamples()
@@ -8637,6 +8641,7 @@ size_t dds::xrce::WRITE_DATA_Payload_DataSeq::getCdrSerializedSize(size_t curren
     current_alignment += 4 + eprosima::fastcdr::Cdr::alignment(current_alignment, 4);
     for(size_t a = 0; a < m_data_seq.size(); ++a)
     {
+        current_alignment += 4 + eprosima::fastcdr::Cdr::alignment(current_alignment, 4);
         current_alignment += m_data_seq.at(a).getCdrSerializedSize(current_alignment);
     }
 
@@ -8646,13 +8651,26 @@ size_t dds::xrce::WRITE_DATA_Payload_DataSeq::getCdrSerializedSize(size_t curren
 void dds::xrce::WRITE_DATA_Payload_DataSeq::serialize(eprosima::fastcdr::Cdr &scdr) const
 {
     BaseObjectRequest::serialize(scdr);
-    scdr << m_data_seq;
+    /* Every sample data is length prefixed within the sequence. */
+    scdr << uint32_t(m_data_seq.size());
+    for(const auto& data : m_data_seq)
+    {
+        scdr << data.serialized_data();
+    }
 }
 
 void dds::xrce::WRITE_DATA_Payload_DataSeq::deserialize(eprosima::fastcdr::Cdr &dcdr)
 {
     BaseObjectRequest::deserialize(dcdr);
-    dcdr >> m_data_seq;
+    uint32_t data_seq_size = 0;
+    dcdr >> data_seq_size;
+    m_data_seq.clear();
+    for(uint32_t a = 0; a < data_seq_size; ++a)
+    {
+        SampleData data;
+        dcdr >> data.serialized_data();
+        m_data_seq.push_back(std::move(data));
+    }
 }
 
 dds::xrce::WRITE_DATA_Payload_SampleSeq::WRITE_DATA_Payload_SampleSeq()
@@ -8994,6 +9012,7 @@ size_t dds::xrce::DATA_Payload_DataSeq::getCdrSerializedSize(size_t current_alig
     current_alignment += 4 + eprosima::fastcdr::Cdr::alignment(current_alignment, 4);
     for(size_t a = 0; a < m_data_seq.size(); ++a)
     {
+        current_alignment += 4 + eprosima::fastcdr::Cdr::alignment(current_alignment, 4);
         current_alignment += m_data_seq.at(a).getCdrSerializedSize(current_alignment);
     }
 
@@ -9003,13 +9022,26 @@ size_t dds::xrce::DATA_Payload_DataSeq::getCdrSerializedSize(size_t current_alig
 void dds::xrce::DATA_Payload_DataSeq::serialize(eprosima::fastcdr::Cdr &scdr) const
 {
     BaseObjectRequest::serialize(scdr);
-    scdr << m_data_seq;
+    /* Every sample data is length prefixed within the sequence. */
+    scdr << uint32_t(m_data_seq.size());
+    for(const auto& data : m_data_seq)
+    {
+        scdr << data.serialized_data();
+    }
 }
 
 void dds::xrce::DATA_Payload_DataSeq::deserialize(eprosima::fastcdr::Cdr &dcdr)
 {
     BaseObjectRequest::deserialize(dcdr);
-    dcdr >> m_data_seq;
+    uint32_t data_seq_size = 0;
+    dcdr >> data_seq_size;
+    m_data_seq.clear();
+    for(uint32_t a = 0; a < data_seq_size; ++a)
+    {
+        SampleData data;
+        dcdr >> data.serialized_data();
+        m_data_seq.push_back(std::move(data));
+    }
 }
 
 dds::xrce::DATA_Payload_SampleSeq::DATA_Payload_SampleSeq()
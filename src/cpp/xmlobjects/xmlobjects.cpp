@@ -14,6 +14,8 @@
 
 #include "xmlobjects.h"
 
+#include <uxr/agent/utils/LRUCache.hpp>
+
 #include <fastrtps/attributes/all_attributes.h>
 #include <fastrtps/attributes/ReplierAttributes.hpp>
 #include <fastrtps/attributes/RequesterAttributes.hpp>
@@ -31,80 +33,93 @@ using eprosima::fastrtps::xmlparser::DataNode;
 using eprosima::fastrtps::xmlparser::NodeType;
 using eprosima::fastrtps::xmlparser::XMLP_ret;
 using eprosima::fastrtps::xmlparser::XMLParser;
+using eprosima::uxr::utils::LRUCache;
+
+namespace {
+
+/* Parsed profiles per kind, shared by all the clients. */
+constexpr size_t xml_cache_capacity = 128;
 
-bool eprosima::uxr::xmlobjects::parse_participant(const char* source, std::size_t source_size,
-                                                        ParticipantAttributes& participant)
+/* Keys are whole sources, so larger ones are parsed every time to keep the cache bounded. */
+constexpr size_t xml_cache_max_source_size = 4096;
+
+template<typename T>
+bool parse_profile(
+        const char* source,
+        std::size_t source_size,
+        NodeType node_type,
+        T& attrs)
 {
+    static LRUCache<std::string, T> cache(xml_cache_capacity);
+
     bool ret = false;
-    std::unique_ptr<BaseNode> root;
-    if (XMLParser::loadXML(source, source_size, root) == XMLP_ret::XML_OK)
+    const bool cacheable = (source_size <= xml_cache_max_source_size);
+    std::string key;
+    std::shared_ptr<const T> cached;
+    if (cacheable)
+    {
+        key.assign(source, source_size);
+        cached = cache.get(key);
+    }
+    if (cached)
     {
-        for (const auto& profile : root->getChildren())
+        attrs = *cached;
+        ret = true;
+    }
+    else
+    {
+        std::unique_ptr<BaseNode> root;
+        if (XMLParser::loadXML(source, source_size, root) == XMLP_ret::XML_OK)
         {
-            if (profile->getType() == NodeType::PARTICIPANT)
+            for (const auto& profile : root->getChildren())
             {
-                participant = *(dynamic_cast<DataNode<ParticipantAttributes>*>(profile.get())->get());
-                ret         = true;
+                if (profile->getType() == node_type)
+                {
+                    attrs = *(dynamic_cast<DataNode<T>*>(profile.get())->get());
+                    ret = true;
+                }
             }
         }
+        if (ret && cacheable)
+        {
+            cache.put(key, std::make_shared<const T>(attrs));
+        }
     }
     return ret;
 }
 
-bool eprosima::uxr::xmlobjects::parse_publisher(const char* source, size_t source_size,
-                                                      PublisherAttributes& publisher)
+} // unnamed namespace
+
+bool eprosima::uxr::xmlobjects::parse_participant(
+        const char* source,
+        std::size_t source_size,
+        ParticipantAttributes& participant)
 {
-    bool ret = false;
-    std::unique_ptr<BaseNode> root;
-    if (XMLParser::loadXML(source, source_size, root) == XMLP_ret::XML_OK)
-    {
-        for (const auto& profile : root->getChildren())
-        {
-            if (profile->getType() == NodeType::PUBLISHER)
-            {
-                publisher = *(dynamic_cast<DataNode<PublisherAttributes>*>(profile.get())->get());
-                ret       = true;
-            }
-        }
-    }
-    return ret;
+    return parse_profile(source, source_size, NodeType::PARTICIPANT, participant);
 }
 
-bool eprosima::uxr::xmlobjects::parse_subscriber(const char* source, size_t source_size,
-                                                       SubscriberAttributes& subscriber)
+bool eprosima::uxr::xmlobjects::parse_publisher(
+        const char* source,
+        std::size_t source_size,
+        PublisherAttributes& publisher)
 {
-    bool ret = false;
-    std::unique_ptr<BaseNode> root;
-    if (XMLParser::loadXML(source, source_size, root) == XMLP_ret::XML_OK)
-    {
-        for (const auto& profile : root->getChildren())
-        {
-            if (profile->getType() == NodeType::SUBSCRIBER)
-            {
-                subscriber = *(dynamic_cast<DataNode<SubscriberAttributes>*>(profile.get())->get());
-                ret        = true;
-            }
-        }
-    }
-    return ret;
+    return parse_profile(source, source_size, NodeType::PUBLISHER, publisher);
 }
 
-bool eprosima::uxr::xmlobjects::parse_topic(const char* source, std::size_t source_size, TopicAttributes& topic)
+bool eprosima::uxr::xmlobjects::parse_subscriber(
+        const char* source,
+        std::size_t source_size,
+        SubscriberAttributes& subscriber)
 {
-    bool ret = false;
-    std::unique_ptr<BaseNode> root;
-    if (XMLParser::loadXML(source, source_size, root) == XMLP_ret::XML_OK)
-    {
-        for (const auto& profile : root->getChildren())
-        {
-            if (profile->getType() == NodeType::TOPIC)
-            {
-                topic = *(dynamic_cast<DataNode<TopicAttributes>*>(profile.get())->get());
-                ret   = true;
-            }
-        }
-    }
-    return ret;
+    return parse_profile(source, source_size, NodeType::SUBSCRIBER, subscriber);
+}
+
+bool eprosima::uxr::xmlobjects::parse_topic(
+        const char* source,
+        std::size_t source_size,
+        TopicAttributes& topic)
+{
+    return parse_profile(source, source_size, NodeType::TOPIC, topic);
 }
 
 bool eprosima::uxr::xmlobjects::parse_requester(
@@ -112,20 +127,7 @@ bool eprosima::uxr::xmlobjects::parse_requester(
         std::size_t source_size,
         RequesterAttributes& requester)
 {
-    bool ret = false;
-    std::unique_ptr<BaseNode> root;
-    if (XMLParser::loadXML(source, source_size, root) == XMLP_ret::XML_OK)
-    {
-        for (const auto& profile : root->getChildren())
-        {
-            if (profile->getType() == NodeType::REQUESTER)
-            {
-                requester = *(dynamic_cast<DataNode<RequesterAttributes>*>(profile.get())->get());
-                ret   = true;
-            }
-        }
-    }
-    return ret;
+    return parse_profile(source, source_size, NodeType::REQUESTER, requester);
 }
 
 bool eprosima::uxr::xmlobjects::parse_replier(
@@ -133,18 +135,5 @@ bool eprosima::uxr::xmlobjects::parse_replier(
         std::size_t source_size,
         ReplierAttributes& replier)
 {
-    bool ret = false;
-    std::unique_ptr<BaseNode> root;
-    if (XMLParser::loadXML(source, source_size, root) == XMLP_ret::XML_OK)
-    {
-        for (const auto& profile : root->getChildren())
-        {
-            if (profile->getType() == NodeType::REPLIER)
-            {
-                replier = *(dynamic_cast<DataNode<ReplierAttributes>*>(profile.get())->get());
-                ret   = true;
-            }
-        }
-    }
-    return ret;
-}
\ No newline at end of file
+    return parse_profile(source, source_size, NodeType::REPLIER, replier);
+}
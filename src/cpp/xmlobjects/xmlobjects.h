@@ -31,6 +31,7 @@ class ReplierAttributes;
 namespace uxr {
 namespace xmlobjects {
 
+/* Parsed profiles of up to 4 KiB are cached by XML content, so repeated parses of the same XML are cheap. */
 bool parse_participant(
     const char* source,
     std::size_t source_size,
@@ -0,0 +1,169 @@
+// Copyright 2017 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <uxr/agent/middleware/fastdds/FastDDSMiddleware.hpp>
+#include <uxr/agent/middleware/fastdds/FastDDSEntities.hpp>
+#include <uxr/agent/types/TopicPubSubType.hpp>
+#include <fastdds/dds/domain/DomainParticipantFactory.hpp>
+#include <fastdds/dds/subscriber/Subscriber.hpp>
+#include <fastdds/dds/subscriber/DataReader.hpp>
+#include <fastdds/dds/subscriber/SampleInfo.hpp>
+#include <fastrtps/xmlparser/XMLProfileManager.h>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <ctime>
+#include <iostream>
+#include <thread>
+
+namespace eprosima {
+namespace uxr {
+namespace testing {
+
+/* Agent DataWriter and a DDS DataReader of the same process, on the same host. */
+class DataSharingTests : public ::testing::TestWithParam<uint32_t>
+{
+protected:
+    DataSharingTests()
+    {
+        fastrtps::xmlparser::XMLProfileManager::loadXMLFile("./agent.refs");
+        FastDDSTransports::get_default().max_sample_size = GetParam();
+        middleware_.reset(new FastDDSMiddleware(false));
+    }
+
+    ~DataSharingTests() override
+    {
+        if (nullptr != participant_)
+        {
+            participant_->delete_contained_entities();
+            fastdds::dds::DomainParticipantFactory::get_instance()->delete_participant(participant_);
+        }
+        middleware_.reset();
+        FastDDSTransports::get_default().max_sample_size = 0;
+    }
+
+    void SetUp() override
+    {
+        ASSERT_TRUE(middleware_->create_participant_by_ref(0x01, 0, "default_xrce_participant"));
+        ASSERT_TRUE(middleware_->create_topic_by_xml(0x01, 0x01, topic_xml_));
+        ASSERT_TRUE(middleware_->create_publisher_by_xml(0x01, 0x01, ""));
+        ASSERT_TRUE(middleware_->create_datawriter_by_xml(0x01, 0x01, datawriter_xml_));
+
+        participant_ = fastdds::dds::DomainParticipantFactory::get_instance()->create_participant(
+            0, fastdds::dds::PARTICIPANT_QOS_DEFAULT);
+        ASSERT_NE(nullptr, participant_);
+        fastdds::dds::TypeSupport type_support(new TopicPubSubType{false, GetParam()});
+        type_support->setName("HelloWorld");
+        ASSERT_EQ(fastrtps::types::ReturnCode_t::RETCODE_OK, type_support.register_type(participant_));
+        fastdds::dds::Topic* topic = participant_->create_topic(
+            "HelloWorldTopic", "HelloWorld", fastdds::dds::TOPIC_QOS_DEFAULT);
+        ASSERT_NE(nullptr, topic);
+        fastdds::dds::Subscriber* subscriber = participant_->create_subscriber(
+            fastdds::dds::SUBSCRIBER_QOS_DEFAULT);
+        ASSERT_NE(nullptr, subscriber);
+        fastdds::dds::DataReaderQos qos = fastdds::dds::DATAREADER_QOS_DEFAULT;
+        qos.reliability().kind = fastdds::dds::RELIABLE_RELIABILITY_QOS;
+        datareader_ = subscriber->create_datareader(topic, qos);
+        ASSERT_NE(nullptr, datareader_);
+
+        /* Until the agent DataWriter is matched. */
+        fastdds::dds::SubscriptionMatchedStatus status;
+        for (int i = 0; (i < 100) && (0 == status.current_count); ++i)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            datareader_->get_subscription_matched_status(status);
+        }
+        ASSERT_LT(0, status.current_count);
+    }
+
+    std::unique_ptr<FastDDSMiddleware> middleware_;
+    fastdds::dds::DomainParticipant* participant_ = nullptr;
+    fastdds::dds::DataReader* datareader_ = nullptr;
+
+    const std::string topic_xml_ = "<dds>"
+                                       "<topic>"
+                                           "<name>HelloWorldTopic</name>"
+                                           "<dataType>HelloWorld</dataType>"
+                                       "</topic>"
+                                   "</dds>";
+    const std::string datawriter_xml_ = "<dds>"
+                                            "<data_writer>"
+                                                "<topic>"
+                                                    "<kind>NO_KEY</kind>"
+                                                    "<name>HelloWorldTopic</name>"
+                                                    "<dataType>HelloWorld</dataType>"
+                                                "</topic>"
+                                            "</data_writer>"
+                                        "</dds>";
+};
+
+TEST_P(DataSharingTests, Latency)
+{
+    const std::vector<uint8_t> sample(512, 0xAA);
+    std::vector<uint8_t> data;
+    fastdds::dds::SampleInfo info;
+
+    const uint32_t samples = 1000;
+    const std::clock_t start_cpu = std::clock();
+    const auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < samples; ++i)
+    {
+        ASSERT_TRUE(middleware_->write_data(0x01, sample));
+        ASSERT_TRUE(datareader_->wait_for_unread_message(fastrtps::Duration_t(1, 0)));
+        ASSERT_EQ(fastrtps::types::ReturnCode_t::RETCODE_OK, datareader_->take_next_sample(&data, &info));
+        ASSERT_EQ(sample, data);
+    }
+    const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start);
+    const double cpu_us = 1e6 * double(std::clock() - start_cpu) / CLOCKS_PER_SEC;
+
+    const int64_t latency_us = elapsed.count() / samples;
+    const int64_t sample_cpu_us = static_cast<int64_t>(cpu_us / samples);
+    RecordProperty("latency_us", static_cast<int>(latency_us));
+    RecordProperty("cpu_us", static_cast<int>(sample_cpu_us));
+    std::cout << "[DataSharingTests] " << (GetParam() ? "data-sharing" : "baseline") << ", "
+              << samples << " samples of " << sample.size() << " bytes: "
+              << latency_us << " us latency, " << sample_cpu_us << " us CPU each" << std::endl;
+}
+
+TEST_P(DataSharingTests, OversizedSample)
+{
+    /* Larger than the bound of the type, so not published. */
+    if (0 < GetParam())
+    {
+        const std::vector<uint8_t> sample(GetParam() + 1, 0xAA);
+        EXPECT_FALSE(middleware_->write_data(0x01, sample));
+    }
+}
+
+#ifdef INSTANTIATE_TEST_SUITE_P
+#define GTEST_INSTANTIATE_TEST_MACRO(x, y, z) INSTANTIATE_TEST_SUITE_P(x, y, z)
+#else
+#define GTEST_INSTANTIATE_TEST_MACRO(x, y, z) INSTANTIATE_TEST_CASE_P(x, y, z)
+#endif // ifdef INSTANTIATE_TEST_SUITE_P
+
+GTEST_INSTANTIATE_TEST_MACRO(MaxSampleSize,
+                        DataSharingTests,
+                        ::testing::Values(0u, 1024u));
+
+} // namespace testing
+} // namespace uxr
+} // namespace eprosima
+
+int main(int args, char** argv)
+{
+    ::testing::InitGoogleTest(&args, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,133 @@
+// Copyright 2017 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <uxr/agent/middleware/fastdds/FastDDSMiddleware.hpp>
+#include <fastrtps/xmlparser/XMLProfileManager.h>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <unistd.h>
+
+namespace eprosima {
+namespace uxr {
+
+namespace {
+
+/* Resident set size of the process, in KiB. */
+long resident_kib()
+{
+    long size = 0;
+    long resident = 0;
+    std::ifstream statm("/proc/self/statm");
+    statm >> size >> resident;
+    return resident * (sysconf(_SC_PAGESIZE) / 1024);
+}
+
+} // unnamed namespace
+
+namespace testing {
+
+class SharedParticipantsTests : public ::testing::Test
+{
+protected:
+    SharedParticipantsTests()
+    {
+        fastrtps::xmlparser::XMLProfileManager::loadXMLFile("./agent.refs");
+    }
+
+    /* Each client with the same participant QoS and a topic on it. */
+    static bool create_client(
+            FastDDSMiddleware& middleware)
+    {
+        return middleware.create_participant_by_ref(participant_id_, 0, "default_xrce_participant")
+            && middleware.create_topic_by_ref(topic_id_, participant_id_, "shapetype_topic");
+    }
+
+    static const uint16_t participant_id_ = 0x01;
+    static const uint16_t topic_id_ = 0x01;
+};
+
+TEST_F(SharedParticipantsTests, Scaling)
+{
+    for (size_t clients : {1, 8, 32})
+    {
+        for (bool shared : {false, true})
+        {
+            std::vector<std::unique_ptr<FastDDSMiddleware>> middlewares;
+            const long start_kib = resident_kib();
+            const auto start = std::chrono::steady_clock::now();
+            for (size_t i = 0; i < clients; ++i)
+            {
+                middlewares.emplace_back(new FastDDSMiddleware(false, shared));
+                ASSERT_TRUE(create_client(*middlewares.back()));
+            }
+            const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - start);
+            const long grown_kib = resident_kib() - start_kib;
+
+            std::cout << "[SharedParticipantsTests] " << clients << " clients, "
+                      << (shared ? "shared" : "baseline") << ": "
+                      << elapsed.count() << " ms, " << grown_kib << " KiB" << std::endl;
+            RecordProperty(
+                std::string(shared ? "shared_" : "baseline_") + std::to_string(clients) + "_kib",
+                static_cast<int>(grown_kib));
+        }
+    }
+}
+
+TEST_F(SharedParticipantsTests, ConcurrentTopicCreation)
+{
+    const size_t clients = 8;
+    std::vector<std::unique_ptr<FastDDSMiddleware>> middlewares;
+    for (size_t i = 0; i < clients; ++i)
+    {
+        middlewares.emplace_back(new FastDDSMiddleware(false, true));
+        ASSERT_TRUE(middlewares.back()->create_participant_by_ref(participant_id_, 0, "default_xrce_participant"));
+    }
+
+    /* All of them find or create the same topic of the shared participant at once. */
+    std::vector<char> created(clients, false);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < clients; ++i)
+    {
+        threads.emplace_back([&, i]()
+        {
+            created[i] = middlewares[i]->create_topic_by_ref(topic_id_, participant_id_, "shapetype_topic");
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    for (size_t i = 0; i < clients; ++i)
+    {
+        EXPECT_TRUE(created[i]);
+    }
+}
+
+} // namespace testing
+} // namespace uxr
+} // namespace eprosima
+
+int main(int args, char** argv)
+{
+    ::testing::InitGoogleTest(&args, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,109 @@
+// Copyright 2017 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <uxr/agent/middleware/fastdds/FastDDSMiddleware.hpp>
+#include <fastrtps/xmlparser/XMLProfileManager.h>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <iostream>
+
+namespace eprosima {
+namespace uxr {
+namespace testing {
+
+class ServiceTests : public ::testing::Test
+{
+protected:
+    ServiceTests()
+        : middleware_(false)
+    {
+        fastrtps::xmlparser::XMLProfileManager::loadXMLFile("./agent.refs");
+    }
+
+    void SetUp() override
+    {
+        ASSERT_TRUE(middleware_.create_participant_by_ref(participant_id_, 0, "default_xrce_participant"));
+        ASSERT_TRUE(middleware_.create_requester_by_ref(requester_id_, participant_id_, "shapetype_requester"));
+        ASSERT_TRUE(middleware_.create_replier_by_ref(replier_id_, participant_id_, "shapetype_replier"));
+    }
+
+    /* Request, echoed back as its reply by the replier. */
+    bool round_trip(
+            uint32_t sequence_number,
+            const std::vector<uint8_t>& request,
+            std::chrono::milliseconds timeout)
+    {
+        bool rv = middleware_.write_request(requester_id_, sequence_number, request)
+            && middleware_.read_request(replier_id_, request_data_, timeout)
+            && middleware_.write_reply(replier_id_, request_data_);
+
+        uint32_t reply_sequence_number = sequence_number + 1;
+        while (rv && (sequence_number != reply_sequence_number))
+        {
+            rv = middleware_.read_reply(requester_id_, reply_sequence_number, reply_data_, timeout);
+        }
+        return rv;
+    }
+
+    FastDDSMiddleware middleware_;
+    const uint16_t participant_id_ = 0x01;
+    const uint16_t requester_id_ = 0x01;
+    const uint16_t replier_id_ = 0x02;
+    std::vector<uint8_t> request_data_;
+    std::vector<uint8_t> reply_data_;
+};
+
+TEST_F(ServiceTests, RoundTrip)
+{
+    const std::vector<uint8_t> request(64, 0xAA);
+
+    /* Until the requester and the replier match. */
+    uint32_t sequence_number = 0;
+    bool matched = false;
+    for (; !matched && (sequence_number < 100); ++sequence_number)
+    {
+        matched = round_trip(sequence_number, request, std::chrono::milliseconds(100));
+    }
+    ASSERT_TRUE(matched);
+
+    /* The identity of the request travels in front of it, and the reply carries the payload alone. */
+    ASSERT_EQ(24 + request.size(), request_data_.size());
+    EXPECT_EQ(request, reply_data_);
+
+    const uint32_t round_trips = 1000;
+    const auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < round_trips; ++i, ++sequence_number)
+    {
+        ASSERT_TRUE(round_trip(sequence_number, request, std::chrono::milliseconds(1000)));
+    }
+    const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start);
+
+    const int64_t mean_us = elapsed.count() / round_trips;
+    RecordProperty("round_trip_us", static_cast<int>(mean_us));
+    std::cout << "[ServiceTests] " << round_trips << " round trips of "
+              << request.size() << " bytes, " << mean_us << " us each" << std::endl;
+}
+
+} // namespace testing
+} // namespace uxr
+} // namespace eprosima
+
+int main(int args, char** argv)
+{
+    ::testing::InitGoogleTest(&args, argv);
+    return RUN_ALL_TESTS();
+}
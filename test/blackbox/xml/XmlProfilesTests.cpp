@@ -0,0 +1,114 @@
+// Copyright 2017 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <uxr/agent/middleware/fastdds/FastDDSMiddleware.hpp>
+#include <fastrtps/xmlparser/XMLProfileManager.h>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <iostream>
+
+namespace eprosima {
+namespace uxr {
+namespace testing {
+
+class XmlProfilesTests : public ::testing::Test
+{
+protected:
+    XmlProfilesTests()
+        : middleware_(false)
+    {
+        fastrtps::xmlparser::XMLProfileManager::loadXMLFile("./agent.refs");
+    }
+
+    void SetUp() override
+    {
+        ASSERT_TRUE(middleware_.create_participant_by_ref(participant_id_, 0, "default_xrce_participant"));
+    }
+
+    /* Topic XML, carrying the given comment. */
+    static std::string topic_xml(
+            const std::string& comment = "")
+    {
+        return "<dds>"
+                   "<!--" + comment + "-->"
+                   "<topic>"
+                       "<name>HelloWorldTopic</name>"
+                       "<dataType>HelloWorld</dataType>"
+                   "</topic>"
+               "</dds>";
+    }
+
+    /* Mean time of creating and deleting a topic from each XML, in microseconds. */
+    int64_t create_topics(
+            const std::vector<std::string>& xmls)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        for (const auto& xml : xmls)
+        {
+            EXPECT_TRUE(middleware_.create_topic_by_xml(topic_id_, participant_id_, xml));
+            EXPECT_TRUE(middleware_.delete_topic(topic_id_));
+        }
+        const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start);
+        return elapsed.count() / int64_t(xmls.size());
+    }
+
+    FastDDSMiddleware middleware_;
+    const uint16_t participant_id_ = 0x01;
+    const uint16_t topic_id_ = 0x01;
+};
+
+TEST_F(XmlProfilesTests, RepeatedCreateByXml)
+{
+    const size_t iterations = 1000;
+
+    /* Every XML different, so that each one is parsed. */
+    std::vector<std::string> distinct_xmls;
+    for (size_t i = 0; i < iterations; ++i)
+    {
+        distinct_xmls.push_back(topic_xml(std::to_string(i)));
+    }
+    const int64_t parsed_us = create_topics(distinct_xmls);
+
+    /* The same XML every time, as clients recreating their entities send it. */
+    const int64_t cached_us = create_topics(std::vector<std::string>(iterations, topic_xml()));
+
+    RecordProperty("parsed_us", static_cast<int>(parsed_us));
+    RecordProperty("cached_us", static_cast<int>(cached_us));
+    std::cout << "[XmlProfilesTests] create_topic_by_xml, " << iterations << " times: "
+              << parsed_us << " us parsed, " << cached_us << " us cached" << std::endl;
+}
+
+TEST_F(XmlProfilesTests, LargeXml)
+{
+    /* Over the cache source size limit, parsed every time. */
+    const std::string xml = topic_xml(std::string(8192, ' '));
+    for (int i = 0; i < 2; ++i)
+    {
+        EXPECT_TRUE(middleware_.create_topic_by_xml(topic_id_, participant_id_, xml));
+        EXPECT_TRUE(middleware_.delete_topic(topic_id_));
+    }
+}
+
+} // namespace testing
+} // namespace uxr
+} // namespace eprosima
+
+int main(int args, char** argv)
+{
+    ::testing::InitGoogleTest(&args, argv);
+    return RUN_ALL_TESTS();
+}
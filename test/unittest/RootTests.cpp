@@ -19,9 +19,14 @@
 #include <uxr/agent/client/ProxyClient.hpp>
 #include <uxr/agent/types/MessageHeader.hpp>
 #include <uxr/agent/types/SubMessageHeader.hpp>
+#include <uxr/agent/utils/Conversion.hpp>
 
 #include <gtest/gtest.h>
 
+#include <atomic>
+#include <thread>
+#include <vector>
+
 namespace eprosima {
 namespace uxr {
 namespace testing {
@@ -121,6 +126,103 @@ TEST_F(RootTests, DeleteNoExistingClient)
     ASSERT_EQ(dds::xrce::STATUS_ERR_UNKNOWN_REFERENCE, response.status());
 }
 
+TEST_F(RootTests, GetNextClient)
+{
+    dds::xrce::CREATE_CLIENT_Payload create_data = generate_create_client_payload();
+    dds::xrce::AGENT_Representation agent_representation;
+    const size_t n_clients = 64;
+    for (size_t i = 0; i < n_clients; ++i)
+    {
+        create_data.client_representation().client_key(conversion::raw_to_clientkey(uint32_t(i + 1)));
+        ASSERT_EQ(dds::xrce::STATUS_OK, root_.create_client(
+                create_data.client_representation(),
+                agent_representation,
+                Middleware::Kind::FAST).status());
+    }
+
+    std::shared_ptr<ProxyClient> client;
+    size_t count = 0;
+    while (root_.get_next_client(client))
+    {
+        ++count;
+    }
+    ASSERT_EQ(n_clients, count);
+}
+
+TEST_F(RootTests, GetNextClientSkipsDeleted)
+{
+    dds::xrce::CREATE_CLIENT_Payload create_data = generate_create_client_payload();
+    dds::xrce::AGENT_Representation agent_representation;
+    const size_t n_clients = 8;
+    for (size_t i = 0; i < n_clients; ++i)
+    {
+        create_data.client_representation().client_key(conversion::raw_to_clientkey(uint32_t(i + 1)));
+        ASSERT_EQ(dds::xrce::STATUS_OK, root_.create_client(
+                create_data.client_representation(),
+                agent_representation,
+                Middleware::Kind::FAST).status());
+    }
+
+    /* Every client but the first one is deleted while iterating. */
+    std::shared_ptr<ProxyClient> client;
+    ASSERT_TRUE(root_.get_next_client(client));
+    for (size_t i = 0; i < n_clients; ++i)
+    {
+        const dds::xrce::ClientKey key = conversion::raw_to_clientkey(uint32_t(i + 1));
+        if (key != client->get_client_key())
+        {
+            ASSERT_EQ(dds::xrce::STATUS_OK, root_.delete_client(key).status());
+        }
+    }
+    ASSERT_FALSE(root_.get_next_client(client));
+
+    ASSERT_TRUE(root_.get_next_client(client));
+    ASSERT_FALSE(client->is_released());
+    ASSERT_FALSE(root_.get_next_client(client));
+}
+
+TEST_F(RootTests, ConcurrentGetClient)
+{
+    dds::xrce::CREATE_CLIENT_Payload create_data = generate_create_client_payload();
+    dds::xrce::AGENT_Representation agent_representation;
+    ASSERT_EQ(dds::xrce::STATUS_OK, root_.create_client(
+            create_data.client_representation(),
+            agent_representation,
+            Middleware::Kind::FAST).status());
+
+    std::atomic<bool> running{true};
+    std::atomic<size_t> misses{0};
+    std::vector<std::thread> readers;
+    for (size_t i = 0; i < 4; ++i)
+    {
+        readers.emplace_back([&]()
+        {
+            while (running)
+            {
+                if (!root_.get_client(client_key))
+                {
+                    ++misses;
+                }
+            }
+        });
+    }
+
+    /* Churn other clients, possibly in the same bucket. */
+    for (uint32_t i = 1; i <= 256; ++i)
+    {
+        create_data.client_representation().client_key(conversion::raw_to_clientkey(i));
+        root_.create_client(create_data.client_representation(), agent_representation, Middleware::Kind::FAST);
+        root_.delete_client(conversion::raw_to_clientkey(i));
+    }
+
+    running = false;
+    for (auto& reader : readers)
+    {
+        reader.join();
+    }
+    ASSERT_EQ(0u, misses.load());
+}
+
 /*
 class ProxyClientTests : public CommonData, public ::testing::Test
 {
@@ -0,0 +1,276 @@
+// Copyright 2019 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <uxr/agent/client/session/Session.hpp>
+
+#include <cstring>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+namespace eprosima {
+namespace uxr {
+namespace testing {
+
+constexpr dds::xrce::SessionId session_id = 0x01;
+constexpr dds::xrce::ClientKey client_key = {0xAA, 0xBB, 0xCC, 0xDD};
+constexpr size_t mtu = 512;
+constexpr dds::xrce::StreamId reliable_stream_id = dds::xrce::STREAMID_BUILTIN_RELIABLE;
+
+/****************************************************************************************
+ * ACKNACK policy.
+ ****************************************************************************************/
+class SessionAckNackTest : public ::testing::Test
+{
+public:
+    SessionAckNackTest()
+        : session_info_{client_key, session_id, mtu}
+    {}
+
+public:
+    SessionInfo session_info_;
+};
+
+/**
+ * @brief   This test checks that best-effort streams are never acknowledged.
+ */
+TEST_F(SessionAckNackTest, BestEffortStream)
+{
+    Session session{session_info_};
+    std::vector<dds::xrce::ACKNACK_Payload> acknacks;
+
+    session.schedule_acknack(dds::xrce::STREAMID_BUILTIN_BEST_EFFORTS);
+    ASSERT_FALSE(session.pop_acknacks(acknacks, true));
+    ASSERT_TRUE(acknacks.empty());
+}
+
+/**
+ * @brief   This test checks that an ACKNACK is released once max_pending messages are pending.
+ */
+TEST_F(SessionAckNackTest, MaxPending)
+{
+    Session session{session_info_, AckPolicy{3, std::chrono::milliseconds(60000)}};
+    std::vector<dds::xrce::ACKNACK_Payload> acknacks;
+
+    session.schedule_acknack(reliable_stream_id);
+    session.schedule_acknack(reliable_stream_id);
+    ASSERT_FALSE(session.pop_acknacks(acknacks, false));
+
+    session.schedule_acknack(reliable_stream_id);
+    ASSERT_TRUE(session.pop_acknacks(acknacks, false));
+    ASSERT_EQ(1u, acknacks.size());
+    ASSERT_EQ(reliable_stream_id, acknacks.front().stream_id());
+
+    acknacks.clear();
+    ASSERT_FALSE(session.pop_acknacks(acknacks, false));
+}
+
+/**
+ * @brief   This test checks that an ACKNACK is released once the oldest pending message is max_delay old.
+ */
+TEST_F(SessionAckNackTest, MaxDelay)
+{
+    Session session{session_info_, AckPolicy{UINT16_MAX, std::chrono::milliseconds(10)}};
+    std::vector<dds::xrce::ACKNACK_Payload> acknacks;
+
+    session.schedule_acknack(reliable_stream_id);
+    ASSERT_FALSE(session.pop_acknacks(acknacks, false));
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    ASSERT_TRUE(session.pop_acknacks(acknacks, false));
+    ASSERT_EQ(1u, acknacks.size());
+}
+
+/**
+ * @brief   This test checks that forced pops, as piggybacking does, release every pending ACKNACK.
+ */
+TEST_F(SessionAckNackTest, Force)
+{
+    Session session{session_info_, AckPolicy{UINT16_MAX, std::chrono::milliseconds(60000)}};
+    std::vector<dds::xrce::ACKNACK_Payload> acknacks;
+
+    session.schedule_acknack(reliable_stream_id);
+    session.schedule_acknack(dds::xrce::StreamId(reliable_stream_id + 1));
+    ASSERT_TRUE(session.pop_acknacks(acknacks, true));
+    ASSERT_EQ(2u, acknacks.size());
+
+    std::chrono::steady_clock::time_point deadline;
+    ASSERT_FALSE(session.pop_acknack_deadline(deadline));
+}
+
+/**
+ * @brief   This test checks that a timer is only requested when a delayed ACKNACK has none armed,
+ *          and that its deadline is the one of the session policy.
+ */
+TEST_F(SessionAckNackTest, Deadline)
+{
+    const std::chrono::milliseconds max_delay(50);
+    Session session{session_info_, AckPolicy{UINT16_MAX, max_delay}};
+    std::chrono::steady_clock::time_point deadline;
+
+    ASSERT_FALSE(session.pop_acknack_deadline(deadline));
+
+    auto before = std::chrono::steady_clock::now();
+    session.schedule_acknack(reliable_stream_id);
+    auto after = std::chrono::steady_clock::now();
+    ASSERT_TRUE(session.pop_acknack_deadline(deadline));
+    ASSERT_LE(before + max_delay, deadline);
+    ASSERT_GE(after + max_delay, deadline);
+
+    /* Already armed. */
+    session.schedule_acknack(reliable_stream_id);
+    session.schedule_acknack(dds::xrce::StreamId(reliable_stream_id + 1));
+    ASSERT_FALSE(session.pop_acknack_deadline(deadline));
+
+    /* Once the timer goes off the ACKNACKs left get a new one. */
+    std::this_thread::sleep_for(max_delay + std::chrono::milliseconds(10));
+    std::vector<dds::xrce::ACKNACK_Payload> acknacks;
+    ASSERT_TRUE(session.pop_acknacks(acknacks, false));
+    ASSERT_FALSE(session.pop_acknack_deadline(deadline));
+
+    session.schedule_acknack(reliable_stream_id);
+    ASSERT_TRUE(session.pop_acknack_deadline(deadline));
+}
+
+/**
+ * @brief   This test checks that a zero delay policy never leaves ACKNACKs to a timer.
+ */
+TEST_F(SessionAckNackTest, NoDelay)
+{
+    Session session{session_info_, AckPolicy{UINT16_MAX, std::chrono::milliseconds(0)}};
+    std::vector<dds::xrce::ACKNACK_Payload> acknacks;
+    std::chrono::steady_clock::time_point deadline;
+
+    session.schedule_acknack(reliable_stream_id);
+    ASSERT_TRUE(session.pop_acknacks(acknacks, false));
+    ASSERT_FALSE(session.pop_acknack_deadline(deadline));
+}
+
+/****************************************************************************************
+ * ACKNACK piggybacking.
+ ****************************************************************************************/
+class PiggybackTest : public ::testing::Test
+{
+public:
+    PiggybackTest()
+        : session_info_{client_key, session_id, mtu}
+        , header_len_{}
+        , acknacks_(1)
+    {
+        dds::xrce::MessageHeader header;
+        header.session_id(session_id);
+        header_len_ = header.getCdrSerializedSize();
+        acknacks_.front().first_unacked_seq_num(0x0102);
+        acknacks_.front().stream_id(reliable_stream_id);
+    }
+
+public:
+    SessionInfo session_info_;
+    size_t header_len_;
+    std::vector<dds::xrce::ACKNACK_Payload> acknacks_;
+};
+
+/**
+ * @brief   This test checks that the ACKNACKs go between the message header and the submessages,
+ *          which are shared with the original message instead of being copied.
+ */
+TEST_F(PiggybackTest, Message)
+{
+    ReliableOutputStream stream;
+    dds::xrce::WRITE_DATA_Payload_Data write_data{};
+    write_data.data().serialized_data().resize(64, 0xAB);
+    ASSERT_TRUE(stream.push_submessage(
+        session_info_, reliable_stream_id, dds::xrce::WRITE_DATA, write_data, std::chrono::milliseconds(0)));
+
+    OutputMessagePtr original;
+    ASSERT_TRUE(stream.get_next_message(original));
+    const size_t prepended_len = OutputMessage::get_prepended_len(*original, header_len_, acknacks_);
+
+    OutputMessagePtr message(new OutputMessage(original, header_len_, dds::xrce::ACKNACK, acknacks_));
+    ASSERT_EQ(prepended_len, message->get_len());
+    ASSERT_EQ(original->get_head() + header_len_, message->get_payload());
+    ASSERT_EQ(original->get_len() - header_len_, message->get_payload_len());
+    ASSERT_EQ(0u, message->get_head_len() % 4);
+
+    const uint8_t* buf = message->get_buf();
+    ASSERT_EQ(0, memcmp(buf, original->get_buf(), header_len_));
+    ASSERT_EQ(dds::xrce::ACKNACK, buf[header_len_]);
+    ASSERT_EQ(0, memcmp(buf + message->get_head_len(),
+                        original->get_buf() + header_len_,
+                        original->get_len() - header_len_));
+
+    /* The retained message is untouched and outlives the stream. */
+    const size_t original_len = original->get_len();
+    original.reset();
+    stream.reset();
+    ASSERT_EQ(original_len - header_len_, message->get_payload_len());
+    ASSERT_EQ(0xAB, message->get_payload()[message->get_payload_len() - 1]);
+}
+
+/**
+ * @brief   This test checks that ACKNACKs pending while a fragmented sample is sent are not put
+ *          in front of its fragments, whose first submessage has to stay FRAGMENT.
+ */
+TEST_F(PiggybackTest, Fragment)
+{
+    Session session{session_info_, AckPolicy{UINT16_MAX, std::chrono::milliseconds(60000)}};
+    session.schedule_acknack(reliable_stream_id);
+
+    ReliableOutputStream stream;
+    dds::xrce::WRITE_DATA_Payload_Data write_data{};
+    write_data.data().serialized_data().resize(2 * mtu, 0xCD);
+    ASSERT_TRUE(stream.push_submessage(
+        session_info_, reliable_stream_id, dds::xrce::WRITE_DATA, write_data, std::chrono::milliseconds(0)));
+
+    size_t fragments = 0;
+    OutputMessagePtr message;
+    while (stream.get_next_message(message))
+    {
+        ASSERT_FALSE(OutputMessage::is_prependable(*message, header_len_));
+        ASSERT_EQ(dds::xrce::FRAGMENT, message->get_buf()[header_len_]);
+        ++fragments;
+    }
+    ASSERT_LT(1u, fragments);
+
+    /* The ACKNACKs are left for a message of their own. */
+    std::vector<dds::xrce::ACKNACK_Payload> acknacks;
+    ASSERT_TRUE(session.pop_acknacks(acknacks, true));
+    ASSERT_EQ(1u, acknacks.size());
+}
+
+/**
+ * @brief   This test checks that complete messages take the ACKNACKs in front of their submessages.
+ */
+TEST_F(PiggybackTest, Prependable)
+{
+    ReliableOutputStream stream;
+    dds::xrce::WRITE_DATA_Payload_Data write_data{};
+    write_data.data().serialized_data().resize(64, 0xAB);
+    ASSERT_TRUE(stream.push_submessage(
+        session_info_, reliable_stream_id, dds::xrce::WRITE_DATA, write_data, std::chrono::milliseconds(0)));
+
+    OutputMessagePtr message;
+    ASSERT_TRUE(stream.get_next_message(message));
+    ASSERT_TRUE(OutputMessage::is_prependable(*message, header_len_));
+}
+
+} // namespace testing
+} // namespace uxr
+} // namespace eprosima
+
+int main(int args, char** argv)
+{
+    ::testing::InitGoogleTest(&args, argv);
+    return RUN_ALL_TESTS();
+}
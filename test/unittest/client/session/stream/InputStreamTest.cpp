@@ -340,6 +340,31 @@ TEST_F(ReliableInputStreamTest, FillAcknack)
     }
 }
 
+TEST_F(ReliableInputStreamTest, FragmentReassembly)
+{
+    /* Inner submessage: WRITE_DATA subheader (little endian) + 10 bytes of payload, split in two fragments. */
+    const uint8_t inner[14] = {0x07, 0x01, 0x0A, 0x00, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    const uint8_t first[16] = {0x81, 0x80, 0x00, 0x00, 0x0D, 0x01, 0x08, 0x00, 0x07, 0x01, 0x0A, 0x00, 0, 1, 2, 3};
+    const uint8_t last[14] = {0x81, 0x80, 0x01, 0x00, 0x0D, 0x03, 0x06, 0x00, 4, 5, 6, 7, 8, 9};
+
+    InputMessagePtr input_message;
+    input_message.reset(new InputMessage(const_cast<uint8_t*>(first), sizeof(first)));
+    ASSERT_TRUE(input_message->prepare_next_submessage());
+    reliable_stream_.push_fragment(input_message);
+    ASSERT_FALSE(reliable_stream_.pop_fragment_message(input_message));
+
+    input_message.reset(new InputMessage(const_cast<uint8_t*>(last), sizeof(last)));
+    ASSERT_TRUE(input_message->prepare_next_submessage());
+    reliable_stream_.push_fragment(input_message);
+    ASSERT_TRUE(reliable_stream_.pop_fragment_message(input_message));
+    ASSERT_FALSE(reliable_stream_.pop_fragment_message(input_message));
+
+    ASSERT_TRUE(input_message->is_valid_xrce_message());
+    ASSERT_EQ(input_message->get_len(), 4 + sizeof(inner));
+    ASSERT_EQ(0, memcmp(input_message->get_buf(), first, 4));
+    ASSERT_EQ(0, memcmp(input_message->get_buf() + 4, inner, sizeof(inner)));
+}
+
 } // namespace testing
 } // namespace uxr
 } // namespace eprosima
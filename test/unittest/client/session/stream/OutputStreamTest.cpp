@@ -193,6 +193,49 @@ TEST_F(ReliableOutputStreamTest, StreamCapacity)
     ASSERT_FALSE(reliable_stream_.get_next_message(output_message));
 }
 
+/**
+ * @brief   This test checks the non-blocking push on a full window.
+ *          The stream shall report the full window and run the callback once an ACKNACK frees it.
+ */
+TEST_F(ReliableOutputStreamTest, WindowFull)
+{
+    dds::xrce::WRITE_DATA_Payload_Data write_data{};
+    int resumed = 0;
+    auto on_window = [&resumed](){ ++resumed; };
+
+    for (int i = 0; i < RELIABLE_STREAM_DEPTH; ++i)
+    {
+        ASSERT_EQ(PushResult::pushed, reliable_stream_.try_push_submessage(
+            session_info_,
+            stream_id_,
+            dds::xrce::WRITE_DATA,
+            write_data,
+            on_window));
+    }
+    ASSERT_EQ(PushResult::window_full, reliable_stream_.try_push_submessage(
+        session_info_,
+        stream_id_,
+        dds::xrce::WRITE_DATA,
+        write_data,
+        on_window));
+    ASSERT_EQ(0, resumed);
+
+    OutputMessagePtr output_message;
+    ASSERT_TRUE(reliable_stream_.get_next_message(output_message));
+    reliable_stream_.update_from_acknack(0x0001);
+    ASSERT_EQ(1, resumed);
+
+    /* The callback runs once. */
+    reliable_stream_.update_from_acknack(0x0001);
+    ASSERT_EQ(1, resumed);
+    ASSERT_EQ(PushResult::pushed, reliable_stream_.try_push_submessage(
+        session_info_,
+        stream_id_,
+        dds::xrce::WRITE_DATA,
+        write_data,
+        on_window));
+}
+
 /**
  * @brief   This test checks the maximum message size of the stream.
  *          The reliable stream shall be able to push messages larger than the MTU.
@@ -300,6 +343,42 @@ TEST_F(ReliableOutputStreamTest, Fragmentation)
     }
 }
 
+TEST_F(ReliableOutputStreamTest, FragmentsSharePayload)
+{
+    dds::xrce::MessageHeader header{};
+    header.session_id(session_id);
+    header.client_key(client_key);
+    dds::xrce::SubmessageHeader subheader{};
+    dds::xrce::WRITE_DATA_Payload_Data write_data{};
+
+    const size_t headers_size = header.getCdrSerializedSize() + subheader.getCdrSerializedSize();
+    const size_t max_fragment_size =  size_t(mtu - headers_size);
+
+    write_data.data().serialized_data().resize(max_fragment_size + 1, 0xAA);
+    ASSERT_TRUE(reliable_stream_.push_submessage(
+        session_info_,
+        stream_id_,
+        dds::xrce::WRITE_DATA,
+        write_data,
+        std::chrono::milliseconds(500)));
+
+    OutputMessagePtr first_fragment;
+    OutputMessagePtr last_fragment;
+    ASSERT_TRUE(reliable_stream_.get_next_message(first_fragment));
+    ASSERT_TRUE(reliable_stream_.get_next_message(last_fragment));
+
+    ASSERT_EQ(first_fragment->get_head_len(), headers_size);
+    ASSERT_EQ(first_fragment->get_payload_len(), max_fragment_size);
+    ASSERT_EQ(first_fragment->get_len(), mtu);
+    ASSERT_EQ(last_fragment->get_head_len(), headers_size);
+    ASSERT_EQ(last_fragment->get_payload(), first_fragment->get_payload() + max_fragment_size);
+
+    /* Contiguous view. */
+    const uint8_t* buf = last_fragment->get_buf();
+    ASSERT_EQ(0, memcmp(buf, last_fragment->get_head(), headers_size));
+    ASSERT_EQ(0, memcmp(buf + headers_size, last_fragment->get_payload(), last_fragment->get_payload_len()));
+}
+
 /**
  * @brief   This test checks the initial conditions of the reliable stream.
  */
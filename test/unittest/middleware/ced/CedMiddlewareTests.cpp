@@ -16,6 +16,11 @@
 
 #include <gtest/gtest.h>
 
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <thread>
+
 namespace eprosima {
 namespace uxr {
 namespace testing {
@@ -897,6 +902,250 @@ TEST_F(CedMiddlewareUnitTests, WriteReadData)
     EXPECT_FALSE(middleware_.read_data(1, input_data, std::chrono::milliseconds(100)));
 }
 
+TEST_F(CedMiddlewareUnitTests, DataWriterHandle)
+{
+    middleware_.create_participant_by_ref(0, 0, "Participant");
+    middleware_.create_topic_by_ref(0, 0, "Topic");
+    middleware_.create_subscriber_by_xml(0, 0, "Subscriber");
+    middleware_.create_publisher_by_xml(0, 0, "Publisher");
+    middleware_.create_datareader_by_ref(0, 0, "Topic");
+    middleware_.create_datawriter_by_ref(0, 0, "Topic");
+
+    EXPECT_EQ(nullptr, middleware_.get_datawriter_handle(1));
+    Middleware::DataWriterHandle* handle = middleware_.get_datawriter_handle(0);
+    ASSERT_NE(nullptr, handle);
+
+    std::vector<uint8_t> output_data{0, 1, 2};
+    std::vector<uint8_t> input_data{};
+    EXPECT_TRUE(handle->write(output_data));
+    EXPECT_TRUE(middleware_.read_data(0, input_data, std::chrono::milliseconds(0)));
+    EXPECT_EQ(output_data, input_data);
+
+    EXPECT_TRUE(middleware_.delete_datawriter(0));
+    EXPECT_EQ(nullptr, middleware_.get_datawriter_handle(0));
+}
+
+TEST_F(CedMiddlewareUnitTests, DataAvailableCallback)
+{
+    middleware_.create_participant_by_ref(0, 0, "Participant");
+    middleware_.create_topic_by_ref(0, 0, "Topic");
+    middleware_.create_subscriber_by_xml(0, 0, "Subscriber");
+    middleware_.create_publisher_by_xml(0, 0, "Publisher");
+    middleware_.create_datareader_by_ref(0, 0, "Topic");
+    middleware_.create_datawriter_by_ref(0, 0, "Topic");
+
+    size_t notifications = 0;
+    EXPECT_FALSE(middleware_.set_data_available_callback(1, [&](){ ++notifications; }));
+    EXPECT_TRUE(middleware_.set_data_available_callback(0, [&](){ ++notifications; }));
+
+    EXPECT_TRUE(middleware_.write_data(0, std::vector<uint8_t>{0}));
+    EXPECT_TRUE(middleware_.write_data(0, std::vector<uint8_t>{1}));
+    EXPECT_EQ(2u, notifications);
+
+    /* Cleared, and released with its DataReader. */
+    EXPECT_TRUE(middleware_.set_data_available_callback(0, nullptr));
+    EXPECT_TRUE(middleware_.write_data(0, std::vector<uint8_t>{2}));
+    EXPECT_EQ(2u, notifications);
+
+    EXPECT_TRUE(middleware_.set_data_available_callback(0, [&](){ ++notifications; }));
+    EXPECT_TRUE(middleware_.delete_datareader(0));
+    EXPECT_TRUE(middleware_.write_data(0, std::vector<uint8_t>{3}));
+    EXPECT_EQ(2u, notifications);
+}
+
+TEST_F(CedMiddlewareUnitTests, HistoryDepth)
+{
+    CedTopicManager::set_history_depth("ShortTopic", 4);
+
+    middleware_.create_participant_by_ref(0, 0, "Participant");
+    middleware_.create_topic_by_ref(0, 0, "ShortTopic");
+    middleware_.create_subscriber_by_xml(0, 0, "Subscriber");
+    middleware_.create_publisher_by_xml(0, 0, "Publisher");
+    middleware_.create_datareader_by_ref(0, 0, "ShortTopic");
+    middleware_.create_datawriter_by_ref(0, 0, "ShortTopic");
+
+    /* Only the last 4 samples are kept. */
+    for (uint8_t i = 0; i < 6; ++i)
+    {
+        EXPECT_TRUE(middleware_.write_data(0, std::vector<uint8_t>{i}));
+    }
+
+    std::vector<uint8_t> input_data{};
+    for (uint8_t i = 2; i < 6; ++i)
+    {
+        EXPECT_TRUE(middleware_.read_data(0, input_data, std::chrono::milliseconds(0)));
+        EXPECT_EQ(std::vector<uint8_t>{i}, input_data);
+    }
+    EXPECT_FALSE(middleware_.read_data(0, input_data, std::chrono::milliseconds(0)));
+}
+
+TEST_F(CedMiddlewareUnitTests, ConcurrentReaders)
+{
+    constexpr uint16_t readers = 4;
+    constexpr uint16_t samples = 1000;
+
+    CedTopicManager::set_history_depth("BigTopic", samples);
+
+    middleware_.create_participant_by_ref(0, 0, "Participant");
+    middleware_.create_topic_by_ref(0, 0, "BigTopic");
+    middleware_.create_subscriber_by_xml(0, 0, "Subscriber");
+    middleware_.create_publisher_by_xml(0, 0, "Publisher");
+    for (uint16_t i = 0; i < readers; ++i)
+    {
+        middleware_.create_datareader_by_ref(i, 0, "BigTopic");
+    }
+    middleware_.create_datawriter_by_ref(0, 0, "BigTopic");
+
+    /* Each reader blocks waiting for data and gets every sample in order. */
+    std::vector<std::thread> threads;
+    std::vector<uint16_t> received(readers, 0);
+    for (uint16_t i = 0; i < readers; ++i)
+    {
+        threads.emplace_back([this, i, &received]()
+        {
+            std::vector<uint8_t> input_data{};
+            while ((received[i] < samples) && middleware_.read_data(i, input_data, std::chrono::milliseconds(1000)))
+            {
+                EXPECT_EQ(uint8_t(received[i]), input_data.at(0));
+                ++received[i];
+            }
+        });
+    }
+
+    for (uint16_t i = 0; i < samples; ++i)
+    {
+        EXPECT_TRUE(middleware_.write_data(0, std::vector<uint8_t>{uint8_t(i)}));
+    }
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    EXPECT_EQ(std::vector<uint16_t>(readers, samples), received);
+}
+
+TEST_F(CedMiddlewareUnitTests, OverwrittenWhileReading)
+{
+    constexpr uint16_t readers = 4;
+    constexpr uint16_t samples = 2000;
+
+    CedTopicManager::set_history_depth("SmallTopic", 2);
+
+    middleware_.create_participant_by_ref(0, 0, "Participant");
+    middleware_.create_topic_by_ref(0, 0, "SmallTopic");
+    middleware_.create_subscriber_by_xml(0, 0, "Subscriber");
+    middleware_.create_publisher_by_xml(0, 0, "Publisher");
+    for (uint16_t i = 0; i < readers; ++i)
+    {
+        middleware_.create_datareader_by_ref(i, 0, "SmallTopic");
+    }
+    middleware_.create_datawriter_by_ref(0, 0, "SmallTopic");
+
+    /* Samples may be lost, but never read torn: all their bytes are their index, and their size grows with it. */
+    std::atomic<bool> running{true};
+    std::vector<std::thread> threads;
+    for (uint16_t i = 0; i < readers; ++i)
+    {
+        threads.emplace_back([this, i, &running]()
+        {
+            std::vector<uint8_t> input_data{};
+            while (running)
+            {
+                if (middleware_.read_data(i, input_data, std::chrono::milliseconds(10)))
+                {
+                    const uint8_t index = input_data.at(0);
+                    EXPECT_EQ(std::vector<uint8_t>(input_data.size(), index), input_data);
+                }
+            }
+        });
+    }
+
+    for (uint16_t i = 0; i < samples; ++i)
+    {
+        EXPECT_TRUE(middleware_.write_data(0, std::vector<uint8_t>(1 + i, uint8_t(i))));
+    }
+
+    running = false;
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+}
+
+TEST_F(CedMiddlewareUnitTests, ConcurrentTopicRegistration)
+{
+    constexpr int threads_count = 8;
+    constexpr int topics_count = 64;
+
+    std::mutex mtx;
+    std::set<std::pair<int16_t, std::string>> notified;
+    CedTopicManager::register_on_new_topic_cb(0x01020304, [&](int16_t domain_id, const std::string& topic_name)
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        EXPECT_TRUE(notified.emplace(domain_id, topic_name).second);
+    });
+
+    /* Every thread registers the same topics, all of them get the same instances. */
+    std::vector<std::vector<std::shared_ptr<CedGlobalTopic>>> topics(threads_count);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < threads_count; ++i)
+    {
+        threads.emplace_back([i, &topics]()
+        {
+            for (int j = 0; j < topics_count; ++j)
+            {
+                std::shared_ptr<CedGlobalTopic> topic;
+                EXPECT_TRUE(CedTopicManager::register_topic("Topic" + std::to_string(j), int16_t(j % 4), topic));
+                topics[i].push_back(topic);
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    CedTopicManager::unregister_on_new_topic_cb(0x01020304);
+
+    EXPECT_EQ(size_t(topics_count), notified.size());
+    for (int i = 1; i < threads_count; ++i)
+    {
+        EXPECT_EQ(topics[0], topics[i]);
+    }
+}
+
+TEST_F(CedMiddlewareUnitTests, UnregisterWaitsForCallback)
+{
+    std::atomic<bool> entered{false};
+    std::atomic<bool> finished{false};
+    std::atomic<int> calls{0};
+    CedTopicManager::register_on_new_topic_cb(0x05060708, [&](int16_t, const std::string&)
+    {
+        ++calls;
+        entered = true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        finished = true;
+    });
+
+    std::shared_ptr<CedGlobalTopic> topic;
+    std::thread thread([&topic]()
+    {
+        EXPECT_TRUE(CedTopicManager::register_topic("UnregisterWaitsTopic", 9, topic));
+    });
+    while (!entered)
+    {
+        std::this_thread::yield();
+    }
+
+    /* The callback in flight may still use what the registrant is about to destroy. */
+    CedTopicManager::unregister_on_new_topic_cb(0x05060708);
+    EXPECT_TRUE(finished);
+    thread.join();
+
+    std::shared_ptr<CedGlobalTopic> other_topic;
+    EXPECT_TRUE(CedTopicManager::register_topic("UnregisterWaitsOtherTopic", 9, other_topic));
+    EXPECT_EQ(1, calls);
+}
+
 } // namespace testing
 } // namespace uxr
 } // namespace testing
@@ -0,0 +1,219 @@
+// Copyright 2019 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <uxr/agent/middleware/ced/CedSharedRing.hpp>
+#include <uxr/agent/middleware/ced/CedMiddleware.hpp>
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <thread>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace eprosima {
+namespace uxr {
+namespace testing {
+
+class CedSharedRingUnitTests : public ::testing::Test
+{
+public:
+    CedSharedRingUnitTests()
+        : topic_name_("SharedTopic_" + std::to_string(getpid()))
+    {}
+
+    ~CedSharedRingUnitTests() = default;
+
+protected:
+    /* Unique per test process, segments are host wide. */
+    const std::string topic_name_;
+};
+
+TEST_F(CedSharedRingUnitTests, WriteRead)
+{
+    std::unique_ptr<CedSharedRing> writer = CedSharedRing::open(topic_name_, 0, 4, 8);
+    ASSERT_TRUE(writer);
+
+    /* An existing ring keeps its parameters. */
+    std::unique_ptr<CedSharedRing> reader = CedSharedRing::open(topic_name_, 0, 16, 64);
+    ASSERT_TRUE(reader);
+    EXPECT_EQ(4u, reader->depth());
+    EXPECT_EQ(8u, reader->slot_size());
+
+    /* Other domains are other rings. */
+    std::unique_ptr<CedSharedRing> other = CedSharedRing::open(topic_name_, 1, 4, 8);
+    ASSERT_TRUE(other);
+    EXPECT_NE(writer->name(), other->name());
+
+    EXPECT_FALSE(writer->write(std::vector<uint8_t>(9, 0), TopicSource::INTERNAL));
+    for (uint8_t i = 0; i < 6; ++i)
+    {
+        EXPECT_TRUE(writer->write(std::vector<uint8_t>{i, i}, (0 == i % 2) ? TopicSource::INTERNAL : TopicSource::EXTERNAL));
+    }
+
+    /* Only the last 4 samples are kept. */
+    uint64_t next_read = 0;
+    std::vector<uint8_t> data;
+    TopicSource topic_src;
+    for (uint8_t i = 2; i < 6; ++i)
+    {
+        ASSERT_TRUE(reader->read(data, topic_src, next_read));
+        EXPECT_EQ((std::vector<uint8_t>{i, i}), data);
+        EXPECT_EQ((0 == i % 2) ? TopicSource::INTERNAL : TopicSource::EXTERNAL, topic_src);
+    }
+    EXPECT_FALSE(reader->read(data, topic_src, next_read));
+    EXPECT_FALSE(reader->wait(next_read, std::chrono::steady_clock::now() + std::chrono::milliseconds(10)));
+    EXPECT_FALSE(other->read(data, topic_src, next_read = 0));
+
+    /* Removed with its last user. */
+    writer.reset();
+    reader.reset();
+    reader = CedSharedRing::open(topic_name_, 0, 16, 64);
+    ASSERT_TRUE(reader);
+    EXPECT_EQ(16u, reader->depth());
+    EXPECT_FALSE(reader->read(data, topic_src, next_read = 0));
+}
+
+TEST_F(CedSharedRingUnitTests, ConcurrentOpen)
+{
+    /* Whoever comes first creates the ring, the rest see it whole. */
+    constexpr size_t openers = 8;
+    std::vector<std::unique_ptr<CedSharedRing>> rings(openers);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < openers; ++i)
+    {
+        threads.emplace_back([&, i](){ rings[i] = CedSharedRing::open(topic_name_, 0, uint16_t(4 + i), 8); });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    for (auto& ring : rings)
+    {
+        ASSERT_TRUE(ring);
+        EXPECT_EQ(rings.front()->depth(), ring->depth());
+    }
+
+    /* Every slot is mapped by every user. */
+    for (uint16_t i = 0; i < rings.front()->depth(); ++i)
+    {
+        EXPECT_TRUE(rings[i % openers]->write(std::vector<uint8_t>(8, uint8_t(i)), TopicSource::INTERNAL));
+    }
+    for (auto& ring : rings)
+    {
+        uint64_t next_read = 0;
+        std::vector<uint8_t> data;
+        TopicSource topic_src;
+        for (uint16_t i = 0; i < ring->depth(); ++i)
+        {
+            ASSERT_TRUE(ring->read(data, topic_src, next_read));
+            EXPECT_EQ(std::vector<uint8_t>(8, uint8_t(i)), data);
+        }
+    }
+}
+
+TEST_F(CedSharedRingUnitTests, CrossProcess)
+{
+    constexpr uint8_t samples = 100;
+
+    std::unique_ptr<CedSharedRing> reader = CedSharedRing::open(topic_name_, 0, samples, 16);
+    ASSERT_TRUE(reader);
+
+    pid_t pid = fork();
+    ASSERT_NE(-1, pid);
+    if (0 == pid)
+    {
+        /* Second process, with its own mapping. */
+        std::unique_ptr<CedSharedRing> writer = CedSharedRing::open(topic_name_, 0, samples, 16);
+        bool written = bool(writer);
+        for (uint8_t i = 0; written && (i < samples); ++i)
+        {
+            written = writer->write(std::vector<uint8_t>{i}, TopicSource::INTERNAL);
+            usleep(100);
+        }
+        writer.reset();
+        _exit(written ? 0 : 1);
+    }
+
+    /* Readers block on the futex until the other process writes. */
+    uint64_t next_read = 0;
+    std::vector<uint8_t> data;
+    TopicSource topic_src;
+    for (uint8_t i = 0; i < samples; ++i)
+    {
+        ASSERT_TRUE(reader->wait(next_read, std::chrono::steady_clock::now() + std::chrono::seconds(5)));
+        ASSERT_TRUE(reader->read(data, topic_src, next_read));
+        EXPECT_EQ(std::vector<uint8_t>{i}, data);
+    }
+
+    int status = -1;
+    ASSERT_EQ(pid, waitpid(pid, &status, 0));
+    EXPECT_TRUE(WIFEXITED(status));
+    EXPECT_EQ(0, WEXITSTATUS(status));
+}
+
+TEST_F(CedSharedRingUnitTests, CrossProcessMiddleware)
+{
+    ASSERT_TRUE(CedTopicManager::set_shared_memory(64));
+
+    /* Keeps the ring alive until both processes have opened it. */
+    std::unique_ptr<CedSharedRing> ring = CedSharedRing::open(topic_name_, 0, CedTopicManager::default_history_depth, 64);
+    ASSERT_TRUE(ring);
+
+    pid_t pid = fork();
+    ASSERT_NE(-1, pid);
+    if (0 == pid)
+    {
+        /* Client of a second agent process, publishing on the same topic. */
+        bool written = false;
+        {
+            CedMiddleware middleware(0xAABBCCDD);
+            written = middleware.create_participant_by_ref(0, 0, "Participant")
+                && middleware.create_topic_by_ref(0, 0, topic_name_)
+                && middleware.create_publisher_by_xml(0, 0, "Publisher")
+                && middleware.create_datawriter_by_ref(0, 0, topic_name_);
+            for (uint8_t i = 0; written && (i < 10); ++i)
+            {
+                written = middleware.write_data(0, std::vector<uint8_t>{i});
+                usleep(1000);
+            }
+        }
+        _exit(written ? 0 : 1);
+    }
+
+    CedMiddleware middleware(0x11223344);
+    ASSERT_TRUE(middleware.create_participant_by_ref(0, 0, "Participant"));
+    ASSERT_TRUE(middleware.create_topic_by_ref(0, 0, topic_name_));
+    ASSERT_TRUE(middleware.create_subscriber_by_xml(0, 0, "Subscriber"));
+    ASSERT_TRUE(middleware.create_datareader_by_ref(0, 0, topic_name_));
+    ring.reset();
+
+    std::vector<uint8_t> data;
+    for (uint8_t i = 0; i < 10; ++i)
+    {
+        ASSERT_TRUE(middleware.read_data(0, data, std::chrono::milliseconds(5000)));
+        EXPECT_EQ(std::vector<uint8_t>{i}, data);
+    }
+
+    int status = -1;
+    ASSERT_EQ(pid, waitpid(pid, &status, 0));
+    EXPECT_EQ(0, WEXITSTATUS(status));
+    CedTopicManager::set_shared_memory(0);
+}
+
+} // namespace testing
+} // namespace uxr
+} // namespace eprosima
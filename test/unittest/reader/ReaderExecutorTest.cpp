@@ -0,0 +1,151 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <uxr/agent/reader/ReaderExecutor.hpp>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+
+namespace eprosima {
+namespace uxr {
+namespace testing {
+
+class ReaderExecutorTest : public ::testing::Test
+{
+protected:
+    ReaderExecutorTest()
+        : executor_{2}
+    {}
+
+    ~ReaderExecutorTest() override = default;
+
+    ReaderExecutor executor_;
+};
+
+TEST_F(ReaderExecutorTest, Post)
+{
+    std::atomic<int> count{0};
+    ReaderExecutor::TaskId id = executor_.add([&](){ ++count; });
+
+    /* A task only runs when posted. */
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    ASSERT_EQ(0, count);
+
+    executor_.post(id);
+    while (1 > count)
+    {
+        std::this_thread::yield();
+    }
+
+    executor_.remove(id);
+    executor_.post(id);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    ASSERT_EQ(1, count);
+}
+
+TEST_F(ReaderExecutorTest, PostAt)
+{
+    std::atomic<bool> done{false};
+    ReaderExecutor::TaskId id = executor_.add([&](){ done = true; });
+
+    auto init_time = std::chrono::steady_clock::now();
+    executor_.post_at(id, init_time + std::chrono::milliseconds(50));
+    while (!done)
+    {
+        std::this_thread::yield();
+    }
+    ASSERT_LE(std::chrono::milliseconds(50), std::chrono::steady_clock::now() - init_time);
+
+    /* Re-arming replaces the previous timer. */
+    done = false;
+    executor_.post_at(id, std::chrono::steady_clock::now() + std::chrono::milliseconds(10));
+    executor_.post_at(id, std::chrono::steady_clock::time_point::max());
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    ASSERT_FALSE(done);
+
+    executor_.remove(id);
+}
+
+TEST_F(ReaderExecutorTest, NoSelfConcurrency)
+{
+    std::atomic<int> running{0};
+    std::atomic<int> max_running{0};
+    std::atomic<int> count{0};
+    ReaderExecutor::TaskId id = executor_.add([&]()
+    {
+        int current = ++running;
+        max_running = std::max(max_running.load(), current);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        --running;
+        ++count;
+    });
+
+    /* Posts received while running are coalesced into a single extra run. */
+    for (int i = 0; i < 100; ++i)
+    {
+        executor_.post(id);
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    executor_.remove(id);
+
+    ASSERT_EQ(1, max_running);
+    ASSERT_LE(1, count);
+    ASSERT_GE(2, count);
+}
+
+TEST_F(ReaderExecutorTest, RemoveWaitsForRunningTask)
+{
+    std::atomic<bool> started{false};
+    std::atomic<bool> finished{false};
+    ReaderExecutor::TaskId id = executor_.add([&]()
+    {
+        started = true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        finished = true;
+    });
+
+    executor_.post(id);
+    while (!started)
+    {
+        std::this_thread::yield();
+    }
+    executor_.remove(id);
+    ASSERT_TRUE(finished);
+}
+
+TEST_F(ReaderExecutorTest, Cancel)
+{
+    std::atomic<int> count{0};
+    ReaderExecutor::TaskId id = executor_.add([&](){ ++count; });
+
+    /* Cancelling drops queued runs and timers, but the task can be posted again. */
+    executor_.post_at(id, std::chrono::steady_clock::now() + std::chrono::milliseconds(10));
+    executor_.cancel(id);
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    ASSERT_EQ(0, count);
+
+    executor_.post(id);
+    while (1 > count)
+    {
+        std::this_thread::yield();
+    }
+
+    executor_.remove(id);
+}
+
+} // namespace testing
+} // namespace uxr
+} // namespace eprosima
@@ -0,0 +1,216 @@
+// Copyright 2018 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <uxr/agent/reader/Reader.hpp>
+
+#include <gtest/gtest.h>
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace eprosima {
+namespace uxr {
+namespace testing {
+
+/* Every sample adds a 4-byte length prefix and its bytes to the batch. */
+constexpr size_t sample_overhead = 4;
+
+class ReaderBatchingTest : public ::testing::Test
+{
+protected:
+    ReaderBatchingTest()
+        : mtx_{}
+        , cv_{}
+        , samples_{}
+        , batches_{}
+        , batch_times_{}
+        , sample_count_{0}
+        , reader_{}
+    {
+        reader_.set_batching(
+            [this](std::vector<std::vector<uint8_t>>& samples,
+                   const std::vector<Reader<bool>::SampleTime>& sample_times,
+                   std::vector<uint8_t>& data)
+            {
+                /* The number of samples of the batch, followed by their first bytes. */
+                data.assign(1, uint8_t(samples.size()));
+                for (const auto& sample : samples)
+                {
+                    data.push_back(sample.front());
+                }
+                std::lock_guard<std::mutex> lock(mtx_);
+                batch_times_.push_back(sample_times);
+            },
+            [](size_t batch_size, size_t sample_size)
+            {
+                return batch_size + sample_overhead + sample_size;
+            },
+            max_batch_samples,
+            max_batch_bytes,
+            [this]()
+            {
+                /* Samples are timestamped one second apart, in the order they are read. */
+                return Reader<bool>::SampleTime(std::chrono::seconds(sample_count_++));
+            });
+    }
+
+    ~ReaderBatchingTest() override
+    {
+        reader_.stop_reading();
+    }
+
+    void push_samples(
+            uint8_t count,
+            size_t size)
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        for (uint8_t i = 0; i < count; ++i)
+        {
+            samples_.emplace_back(size, uint8_t(samples_.size()));
+        }
+    }
+
+    bool start(
+            uint16_t max_samples)
+    {
+        dds::xrce::DataDeliveryControl delivery_control;
+        delivery_control.max_samples(max_samples);
+        delivery_control.max_elapsed_time(0);
+        delivery_control.max_bytes_per_second(0);
+        delivery_control.min_pace_period() = 0;
+        return reader_.start_reading(
+            delivery_control,
+            [this](bool, std::vector<uint8_t>& data, std::chrono::milliseconds)
+            {
+                std::lock_guard<std::mutex> lock(mtx_);
+                bool rv = !samples_.empty();
+                if (rv)
+                {
+                    data = std::move(samples_.front());
+                    samples_.pop_front();
+                }
+                return rv;
+            },
+            false,
+            [this](const WriteFnArgs&, const std::vector<uint8_t>& data, std::chrono::milliseconds)
+            {
+                std::lock_guard<std::mutex> lock(mtx_);
+                batches_.push_back(data);
+                cv_.notify_all();
+                return WriteResult::written;
+            },
+            WriteFnArgs{});
+    }
+
+    bool wait_batches(
+            size_t count)
+    {
+        std::unique_lock<std::mutex> lock(mtx_);
+        return cv_.wait_for(lock, std::chrono::seconds(5), [&](){ return count <= batches_.size(); });
+    }
+
+    static constexpr uint16_t max_batch_samples = 4;
+    static constexpr size_t max_batch_bytes = 64;
+
+    std::mutex mtx_;
+    std::condition_variable cv_;
+    std::deque<std::vector<uint8_t>> samples_;
+    std::vector<std::vector<uint8_t>> batches_;
+    std::vector<std::vector<Reader<bool>::SampleTime>> batch_times_;
+    int64_t sample_count_;
+    Reader<bool> reader_;
+};
+
+constexpr uint16_t ReaderBatchingTest::max_batch_samples;
+constexpr size_t ReaderBatchingTest::max_batch_bytes;
+
+TEST_F(ReaderBatchingTest, MaxBatchSamples)
+{
+    push_samples(6, 1);
+    ASSERT_TRUE(start(0xFFFF));
+    ASSERT_TRUE(wait_batches(2));
+
+    std::lock_guard<std::mutex> lock(mtx_);
+    ASSERT_EQ((std::vector<uint8_t>{4, 0, 1, 2, 3}), batches_[0]);
+    ASSERT_EQ((std::vector<uint8_t>{2, 4, 5}), batches_[1]);
+}
+
+TEST_F(ReaderBatchingTest, MaxBatchBytes)
+{
+    /* Encoded sizes 20, 40, 60 and 80: the fourth sample opens the next batch. */
+    push_samples(5, 16);
+    ASSERT_TRUE(start(0xFFFF));
+    ASSERT_TRUE(wait_batches(2));
+
+    std::lock_guard<std::mutex> lock(mtx_);
+    ASSERT_EQ((std::vector<uint8_t>{3, 0, 1, 2}), batches_[0]);
+    ASSERT_EQ((std::vector<uint8_t>{2, 3, 4}), batches_[1]);
+}
+
+TEST_F(ReaderBatchingTest, OversizedSample)
+{
+    /* A sample larger than the batch limit still goes, alone. */
+    push_samples(1, 2 * max_batch_bytes);
+    push_samples(1, 1);
+    ASSERT_TRUE(start(0xFFFF));
+    ASSERT_TRUE(wait_batches(2));
+
+    std::lock_guard<std::mutex> lock(mtx_);
+    ASSERT_EQ((std::vector<uint8_t>{1, 0}), batches_[0]);
+    ASSERT_EQ((std::vector<uint8_t>{1, 1}), batches_[1]);
+}
+
+TEST_F(ReaderBatchingTest, MaxSamples)
+{
+    /* Batches count as many samples as they carry, the rest is left to the middleware. */
+    push_samples(6, 1);
+    ASSERT_TRUE(start(5));
+    ASSERT_TRUE(wait_batches(2));
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    std::lock_guard<std::mutex> lock(mtx_);
+    ASSERT_EQ(2u, batches_.size());
+    ASSERT_EQ((std::vector<uint8_t>{4, 0, 1, 2, 3}), batches_[0]);
+    ASSERT_EQ((std::vector<uint8_t>{1, 4}), batches_[1]);
+    ASSERT_EQ(1u, samples_.size());
+}
+
+TEST_F(ReaderBatchingTest, SampleTimes)
+{
+    /* The sample opening the next batch keeps its own time. */
+    push_samples(5, 16);
+    ASSERT_TRUE(start(0xFFFF));
+    ASSERT_TRUE(wait_batches(2));
+
+    using std::chrono::seconds;
+    std::lock_guard<std::mutex> lock(mtx_);
+    ASSERT_EQ(2u, batch_times_.size());
+    ASSERT_EQ((std::vector<Reader<bool>::SampleTime>{
+        Reader<bool>::SampleTime(seconds(0)), Reader<bool>::SampleTime(seconds(1)),
+        Reader<bool>::SampleTime(seconds(2))}), batch_times_[0]);
+    ASSERT_EQ((std::vector<Reader<bool>::SampleTime>{
+        Reader<bool>::SampleTime(seconds(3)), Reader<bool>::SampleTime(seconds(4))}), batch_times_[1]);
+}
+
+} // namespace testing
+} // namespace uxr
+} // namespace eprosima
+
+int main(int args, char** argv)
+{
+    ::testing::InitGoogleTest(&args, argv);
+    return RUN_ALL_TESTS();
+}
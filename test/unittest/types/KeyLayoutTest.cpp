@@ -0,0 +1,75 @@
+// Copyright 2017 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <uxr/agent/types/KeyLayout.hpp>
+
+#include <gtest/gtest.h>
+
+namespace eprosima {
+namespace uxr {
+namespace testing {
+
+class KeyLayoutTest : public ::testing::Test
+{
+protected:
+    KeyLayoutTest() = default;
+    ~KeyLayoutTest() override = default;
+};
+
+TEST_F(KeyLayoutTest, Parse)
+{
+    std::string type_name;
+    KeyLayout layout;
+    ASSERT_TRUE(parse_key_layout("ns::Type_=0:4:4,8:16", type_name, layout));
+    EXPECT_EQ("ns::Type_", type_name);
+    ASSERT_EQ(2u, layout.size());
+    EXPECT_EQ(0u, layout[0].offset);
+    EXPECT_EQ(4u, layout[0].length);
+    EXPECT_EQ(4u, layout[0].element_size);
+    EXPECT_EQ(8u, layout[1].offset);
+    EXPECT_EQ(16u, layout[1].length);
+    EXPECT_EQ(1u, layout[1].element_size);
+}
+
+TEST_F(KeyLayoutTest, ParseInvalid)
+{
+    std::string type_name;
+    KeyLayout layout;
+    EXPECT_FALSE(parse_key_layout("Type", type_name, layout));
+    EXPECT_FALSE(parse_key_layout("=0:4", type_name, layout));
+    EXPECT_FALSE(parse_key_layout("Type=", type_name, layout));
+    EXPECT_FALSE(parse_key_layout("Type=0", type_name, layout));
+    EXPECT_FALSE(parse_key_layout("Type=0:x", type_name, layout));
+    EXPECT_FALSE(parse_key_layout("Type=0:0", type_name, layout));
+    EXPECT_FALSE(parse_key_layout("Type=0:6:4", type_name, layout));
+    EXPECT_FALSE(parse_key_layout("Type=0:4:4:1", type_name, layout));
+}
+
+TEST_F(KeyLayoutTest, Extract)
+{
+    const uint8_t sample[] = {0x01, 0x02, 0x03, 0x04, 0xAA, 0xBB, 'i', 'd'};
+    const KeyLayout layout{{0, 4, 2}, {6, 2, 1}};
+
+    std::vector<uint8_t> key;
+    ASSERT_TRUE(extract_key(sample, sizeof(sample), layout, key));
+    const std::vector<uint8_t> expected{0x02, 0x01, 0x04, 0x03, 'i', 'd'};
+    EXPECT_EQ(expected, key);
+
+    EXPECT_FALSE(extract_key(sample, 7, layout, key));
+    EXPECT_FALSE(extract_key(sample, sizeof(sample), KeyLayout{{16, 1, 1}}, key));
+}
+
+} // namespace testing
+} // namespace uxr
+} // namespace eprosima
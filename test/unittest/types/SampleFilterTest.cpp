@@ -0,0 +1,86 @@
+// Copyright 2017 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <uxr/agent/types/SampleFilter.hpp>
+
+#include <gtest/gtest.h>
+
+namespace eprosima {
+namespace uxr {
+namespace testing {
+
+class SampleFilterTest : public ::testing::Test
+{
+protected:
+    SampleFilterTest() = default;
+    ~SampleFilterTest() override = default;
+
+    /* u16 = 300, i32 = -5, f32 = 2.5. */
+    const uint8_t sample_[12] = {0x2C, 0x01, 0x00, 0x00, 0xFB, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x20, 0x40};
+};
+
+TEST_F(SampleFilterTest, Parse)
+{
+    SampleFilter filter;
+    ASSERT_TRUE(parse_sample_filter("0:u16 >= 0x100 AND 4:i32 <> -1 AND 8:f32 < 3.5", filter));
+    ASSERT_EQ(3u, filter.size());
+    EXPECT_EQ(0u, filter[0].offset);
+    EXPECT_EQ(2u, filter[0].size);
+    EXPECT_EQ(FilterCondition::UINT, filter[0].kind);
+    EXPECT_EQ(FilterCondition::GREATER_EQUAL, filter[0].op);
+    EXPECT_EQ(0x100u, filter[0].uint_value);
+    EXPECT_EQ(FilterCondition::INT, filter[1].kind);
+    EXPECT_EQ(-1, filter[1].int_value);
+    EXPECT_EQ(FilterCondition::FLOAT, filter[2].kind);
+    EXPECT_DOUBLE_EQ(3.5, filter[2].float_value);
+
+    EXPECT_TRUE(parse_sample_filter("", filter));
+    EXPECT_TRUE(filter.empty());
+}
+
+TEST_F(SampleFilterTest, ParseInvalid)
+{
+    SampleFilter filter;
+    EXPECT_FALSE(parse_sample_filter("0:u16", filter));
+    EXPECT_FALSE(parse_sample_filter("0:u16 >=", filter));
+    EXPECT_FALSE(parse_sample_filter("0:u24 = 1", filter));
+    EXPECT_FALSE(parse_sample_filter("x:u8 = 1", filter));
+    EXPECT_FALSE(parse_sample_filter("0:u8 == 1", filter));
+    EXPECT_FALSE(parse_sample_filter("0:u8 = one", filter));
+    EXPECT_FALSE(parse_sample_filter("0:u8 = 1 OR 1:u8 = 1", filter));
+    EXPECT_FALSE(parse_sample_filter("0:u8 = 1 AND", filter));
+}
+
+TEST_F(SampleFilterTest, Match)
+{
+    SampleFilter filter;
+    ASSERT_TRUE(parse_sample_filter("0:u16 = 300 AND 4:i32 < 0 AND 8:f32 > 2", filter));
+    EXPECT_TRUE(match_sample_filter(sample_, sizeof(sample_), filter));
+
+    ASSERT_TRUE(parse_sample_filter("4:i32 >= -4", filter));
+    EXPECT_FALSE(match_sample_filter(sample_, sizeof(sample_), filter));
+
+    ASSERT_TRUE(parse_sample_filter("4:i8 = -5 AND 8:f32 <= 2.5", filter));
+    EXPECT_TRUE(match_sample_filter(sample_, sizeof(sample_), filter));
+
+    /* Too short for the member. */
+    ASSERT_TRUE(parse_sample_filter("8:f32 > 0", filter));
+    EXPECT_FALSE(match_sample_filter(sample_, 11, filter));
+
+    EXPECT_TRUE(match_sample_filter(sample_, 0, SampleFilter{}));
+}
+
+} // namespace testing
+} // namespace uxr
+} // namespace eprosima
@@ -243,6 +243,136 @@ TEST_F(SerializerDeserializerTests, DataSubmessage)
     ASSERT_EQ(data_payload.data().serialized_data(), deserialized_data.data().serialized_data());
 }
 
+/* Batched DATA formats, odd sized samples so that the length prefixes have to be aligned. */
+TEST_F(SerializerDeserializerTests, DataSampleSubmessage)
+{
+    dds::xrce::MessageHeader message_header = generate_message_header();
+    dds::xrce::DATA_Payload_Sample data_payload;
+    data_payload.request_id(request_id);
+    data_payload.object_id(object_id);
+    data_payload.sample().info().sequence_number(7);
+    data_payload.sample().data().serialized_data(std::vector<uint8_t>{1, 2, 3});
+    dds::xrce::SubmessageHeader submessage_header;
+    size_t message_size = message_header.getCdrSerializedSize() +
+                          submessage_header.getCdrSerializedSize() +
+                          data_payload.getCdrSerializedSize();
+
+    OutputMessage output(message_header, message_size);
+    ASSERT_TRUE(output.append_submessage(dds::xrce::DATA, data_payload));
+    ASSERT_EQ(message_size, output.get_len());
+
+    dds::xrce::DATA_Payload_Sample deserialized_data;
+    InputMessage input(output.get_buf(), output.get_len());
+    ASSERT_TRUE(input.prepare_next_submessage());
+    ASSERT_TRUE(input.get_payload(deserialized_data));
+
+    ASSERT_EQ(data_payload.request_id(), deserialized_data.request_id());
+    ASSERT_EQ(7u, deserialized_data.sample().info().sequence_number());
+    ASSERT_EQ(data_payload.sample().data().serialized_data(), deserialized_data.sample().data().serialized_data());
+}
+
+TEST_F(SerializerDeserializerTests, DataSeqSubmessage)
+{
+    dds::xrce::MessageHeader message_header = generate_message_header();
+    dds::xrce::DATA_Payload_DataSeq data_payload;
+    data_payload.request_id(request_id);
+    data_payload.object_id(object_id);
+    data_payload.data_seq().resize(2);
+    data_payload.data_seq()[0].serialized_data(std::vector<uint8_t>{1, 2, 3});
+    data_payload.data_seq()[1].serialized_data(std::vector<uint8_t>{4, 5, 6, 7, 8});
+    dds::xrce::SubmessageHeader submessage_header;
+    size_t message_size = message_header.getCdrSerializedSize() +
+                          submessage_header.getCdrSerializedSize() +
+                          data_payload.getCdrSerializedSize();
+
+    /* Object request, sequence length, then length prefixed data padded to 4 bytes. */
+    ASSERT_EQ(4u + 4u + (4u + 3u + 1u) + (4u + 5u), data_payload.getCdrSerializedSize());
+
+    OutputMessage output(message_header, message_size);
+    ASSERT_TRUE(output.append_submessage(dds::xrce::DATA, data_payload));
+    ASSERT_EQ(message_size, output.get_len());
+
+    dds::xrce::DATA_Payload_DataSeq deserialized_data;
+    InputMessage input(output.get_buf(), output.get_len());
+    ASSERT_TRUE(input.prepare_next_submessage());
+    ASSERT_TRUE(input.get_payload(deserialized_data));
+
+    ASSERT_EQ(data_payload.object_id(), deserialized_data.object_id());
+    ASSERT_EQ(2u, deserialized_data.data_seq().size());
+    ASSERT_EQ(data_payload.data_seq()[0].serialized_data(), deserialized_data.data_seq()[0].serialized_data());
+    ASSERT_EQ(data_payload.data_seq()[1].serialized_data(), deserialized_data.data_seq()[1].serialized_data());
+}
+
+TEST_F(SerializerDeserializerTests, DataSampleSeqSubmessage)
+{
+    dds::xrce::MessageHeader message_header = generate_message_header();
+    dds::xrce::DATA_Payload_SampleSeq data_payload;
+    data_payload.request_id(request_id);
+    data_payload.object_id(object_id);
+    data_payload.sample_seq().resize(2);
+    data_payload.sample_seq()[0].info().sequence_number(1);
+    data_payload.sample_seq()[0].data().serialized_data(std::vector<uint8_t>{1});
+    data_payload.sample_seq()[1].info().sequence_number(2);
+    data_payload.sample_seq()[1].data().serialized_data(std::vector<uint8_t>{2, 3});
+    dds::xrce::SubmessageHeader submessage_header;
+    size_t message_size = message_header.getCdrSerializedSize() +
+                          submessage_header.getCdrSerializedSize() +
+                          data_payload.getCdrSerializedSize();
+
+    OutputMessage output(message_header, message_size);
+    ASSERT_TRUE(output.append_submessage(dds::xrce::DATA, data_payload));
+    ASSERT_EQ(message_size, output.get_len());
+
+    dds::xrce::DATA_Payload_SampleSeq deserialized_data;
+    InputMessage input(output.get_buf(), output.get_len());
+    ASSERT_TRUE(input.prepare_next_submessage());
+    ASSERT_TRUE(input.get_payload(deserialized_data));
+
+    ASSERT_EQ(2u, deserialized_data.sample_seq().size());
+    for (size_t i = 0; i < 2; ++i)
+    {
+        ASSERT_EQ(data_payload.sample_seq()[i].info().sequence_number(),
+                  deserialized_data.sample_seq()[i].info().sequence_number());
+        ASSERT_EQ(data_payload.sample_seq()[i].data().serialized_data(),
+                  deserialized_data.sample_seq()[i].data().serialized_data());
+    }
+}
+
+TEST_F(SerializerDeserializerTests, DataPackedSamplesSubmessage)
+{
+    dds::xrce::MessageHeader message_header = generate_message_header();
+    dds::xrce::DATA_Payload_PackedSamples data_payload;
+    data_payload.request_id(request_id);
+    data_payload.object_id(object_id);
+    data_payload.packed_samples().info_base().sequence_number(10);
+    data_payload.packed_samples().sample_delta_seq().resize(2);
+    data_payload.packed_samples().sample_delta_seq()[0].data().serialized_data(std::vector<uint8_t>{1, 2, 3});
+    data_payload.packed_samples().sample_delta_seq()[1].info_delta().seq_number_delta(1);
+    data_payload.packed_samples().sample_delta_seq()[1].data().serialized_data(std::vector<uint8_t>{4});
+    dds::xrce::SubmessageHeader submessage_header;
+    size_t message_size = message_header.getCdrSerializedSize() +
+                          submessage_header.getCdrSerializedSize() +
+                          data_payload.getCdrSerializedSize();
+
+    OutputMessage output(message_header, message_size);
+    ASSERT_TRUE(output.append_submessage(dds::xrce::DATA, data_payload));
+    ASSERT_EQ(message_size, output.get_len());
+
+    dds::xrce::DATA_Payload_PackedSamples deserialized_data;
+    InputMessage input(output.get_buf(), output.get_len());
+    ASSERT_TRUE(input.prepare_next_submessage());
+    ASSERT_TRUE(input.get_payload(deserialized_data));
+
+    const dds::xrce::PackedSamples& packed_samples = deserialized_data.packed_samples();
+    ASSERT_EQ(10u, packed_samples.info_base().sequence_number());
+    ASSERT_EQ(2u, packed_samples.sample_delta_seq().size());
+    ASSERT_EQ(1u, packed_samples.sample_delta_seq()[1].info_delta().seq_number_delta());
+    ASSERT_EQ(data_payload.packed_samples().sample_delta_seq()[0].data().serialized_data(),
+              packed_samples.sample_delta_seq()[0].data().serialized_data());
+    ASSERT_EQ(data_payload.packed_samples().sample_delta_seq()[1].data().serialized_data(),
+              packed_samples.sample_delta_seq()[1].data().serialized_data());
+}
+
 TEST_F(SerializerDeserializerTests, DeleteSubmessage)
 {
     dds::xrce::MessageHeader message_header = generate_message_header();
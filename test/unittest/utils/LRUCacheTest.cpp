@@ -0,0 +1,117 @@
+// Copyright 2017 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <uxr/agent/utils/LRUCache.hpp>
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace eprosima {
+namespace uxr {
+namespace testing {
+
+using eprosima::uxr::utils::LRUCache;
+
+class LRUCacheTest : public ::testing::Test
+{
+protected:
+    LRUCacheTest()
+        : cache_(capacity)
+    {}
+
+    ~LRUCacheTest() override = default;
+
+    static constexpr size_t capacity = 4;
+    LRUCache<std::string, int> cache_;
+};
+
+constexpr size_t LRUCacheTest::capacity;
+
+TEST_F(LRUCacheTest, GetPut)
+{
+    EXPECT_EQ(nullptr, cache_.get("a"));
+
+    cache_.put("a", std::make_shared<const int>(1));
+    auto value = cache_.get("a");
+    ASSERT_NE(nullptr, value);
+    EXPECT_EQ(1, *value);
+
+    /* Replacing keeps the size. */
+    cache_.put("a", std::make_shared<const int>(2));
+    EXPECT_EQ(2, *cache_.get("a"));
+    EXPECT_EQ(1u, cache_.get_size());
+    EXPECT_EQ(1, *value);
+}
+
+TEST_F(LRUCacheTest, EvictLeastRecentlyUsed)
+{
+    for (int i = 0; i < int(capacity); ++i)
+    {
+        cache_.put(std::to_string(i), std::make_shared<const int>(i));
+    }
+    EXPECT_EQ(capacity, cache_.get_size());
+
+    /* "0" becomes the most recently used, so "1" is evicted. */
+    ASSERT_NE(nullptr, cache_.get("0"));
+    cache_.put("new", std::make_shared<const int>(-1));
+
+    EXPECT_EQ(capacity, cache_.get_size());
+    EXPECT_NE(nullptr, cache_.get("0"));
+    EXPECT_EQ(nullptr, cache_.get("1"));
+    EXPECT_NE(nullptr, cache_.get("2"));
+    EXPECT_NE(nullptr, cache_.get("new"));
+
+    cache_.clear();
+    EXPECT_EQ(0u, cache_.get_size());
+    EXPECT_EQ(nullptr, cache_.get("0"));
+}
+
+TEST_F(LRUCacheTest, ZeroCapacity)
+{
+    LRUCache<std::string, int> cache(0);
+    cache.put("a", std::make_shared<const int>(1));
+    EXPECT_EQ(nullptr, cache.get("a"));
+    EXPECT_EQ(0u, cache.get_size());
+}
+
+TEST_F(LRUCacheTest, Concurrent)
+{
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+    {
+        threads.emplace_back([this, t]()
+        {
+            for (int i = 0; i < 1000; ++i)
+            {
+                const std::string key = std::to_string((i + t) % 8);
+                if (!cache_.get(key))
+                {
+                    cache_.put(key, std::make_shared<const int>(i));
+                }
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    EXPECT_EQ(capacity, cache_.get_size());
+}
+
+} // namespace testing
+} // namespace uxr
+} // namespace eprosima
@@ -0,0 +1,93 @@
+// Copyright 2017 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <uxr/agent/utils/Pacer.hpp>
+
+#include <gtest/gtest.h>
+
+namespace eprosima {
+namespace uxr {
+namespace testing {
+
+using eprosima::uxr::utils::Pacer;
+using std::chrono::milliseconds;
+using std::chrono::steady_clock;
+
+class PacerTest : public ::testing::Test
+{
+protected:
+    PacerTest() = default;
+    ~PacerTest() override = default;
+
+    const steady_clock::time_point start_ = steady_clock::now();
+};
+
+TEST_F(PacerTest, unlimited)
+{
+    Pacer pacer;
+
+    pacer.consume(1000000, start_);
+    ASSERT_EQ(pacer.get_eligible_time(start_), start_);
+}
+
+TEST_F(PacerTest, rate)
+{
+    Pacer pacer{1000};
+
+    ASSERT_EQ(pacer.get_eligible_time(start_), start_);
+    pacer.consume(100, start_);
+    ASSERT_EQ(pacer.get_eligible_time(start_), start_ + milliseconds(100));
+
+    /* Bytes sent while not eligible are accounted as well. */
+    pacer.consume(50, start_ + milliseconds(20));
+    ASSERT_EQ(pacer.get_eligible_time(start_ + milliseconds(20)), start_ + milliseconds(150));
+    ASSERT_EQ(pacer.get_eligible_time(start_ + milliseconds(200)), start_ + milliseconds(200));
+
+    /* Idle time is not saved up beyond the burst. */
+    pacer.consume(100, start_ + milliseconds(1000));
+    ASSERT_EQ(pacer.get_eligible_time(start_ + milliseconds(1000)), start_ + milliseconds(1100));
+}
+
+TEST_F(PacerTest, burst)
+{
+    Pacer pacer{1000, 200};
+
+    /* Eligible while less than the burst is left to drain. */
+    pacer.consume(150, start_);
+    ASSERT_EQ(pacer.get_eligible_time(start_), start_);
+    pacer.consume(150, start_);
+    ASSERT_EQ(pacer.get_eligible_time(start_), start_ + milliseconds(100));
+
+    /* Samples larger than the burst go through once the link is drained. */
+    pacer.consume(5000, start_ + milliseconds(100));
+    ASSERT_EQ(pacer.get_eligible_time(start_ + milliseconds(100)), start_ + milliseconds(5100));
+}
+
+TEST_F(PacerTest, reset)
+{
+    Pacer pacer{1000};
+
+    pacer.consume(1000, start_);
+    pacer.reset(0);
+    ASSERT_EQ(pacer.get_eligible_time(start_), start_);
+    ASSERT_EQ(pacer.get_rate(), 0u);
+
+    pacer.reset(2000);
+    pacer.consume(1000, start_);
+    ASSERT_EQ(pacer.get_eligible_time(start_), start_ + milliseconds(500));
+}
+
+} // namespace testing
+} // namespace uxr
+} // namespace eprosima
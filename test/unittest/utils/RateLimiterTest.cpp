@@ -0,0 +1,88 @@
+// Copyright 2017 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <uxr/agent/utils/RateLimiter.hpp>
+
+#include <gtest/gtest.h>
+
+namespace eprosima {
+namespace uxr {
+namespace testing {
+
+using eprosima::uxr::utils::RateLimiter;
+using std::chrono::milliseconds;
+using std::chrono::steady_clock;
+
+class RateLimiterTest : public ::testing::Test
+{
+protected:
+    RateLimiterTest() = default;
+    ~RateLimiterTest() override = default;
+
+    const steady_clock::time_point start_ = steady_clock::now();
+};
+
+TEST_F(RateLimiterTest, burst)
+{
+    RateLimiter<uint32_t> limiter{10, 3, 16};
+
+    /* Up to the burst at once. */
+    for (int i = 0; i < 3; ++i)
+    {
+        ASSERT_TRUE(limiter.consume(1, start_));
+    }
+    ASSERT_FALSE(limiter.consume(1, start_));
+
+    /* Other sources are limited on their own. */
+    ASSERT_TRUE(limiter.consume(2, start_));
+    ASSERT_EQ(limiter.get_size(), 2u);
+}
+
+TEST_F(RateLimiterTest, rate)
+{
+    RateLimiter<uint32_t> limiter{10, 1, 16};
+
+    ASSERT_TRUE(limiter.consume(1, start_));
+    ASSERT_FALSE(limiter.consume(1, start_ + milliseconds(50)));
+    ASSERT_TRUE(limiter.consume(1, start_ + milliseconds(100)));
+    ASSERT_FALSE(limiter.consume(1, start_ + milliseconds(150)));
+
+    /* Denied events do not delay the next allowed one. */
+    ASSERT_TRUE(limiter.consume(1, start_ + milliseconds(200)));
+
+    /* After being idle, a full burst is allowed again. */
+    ASSERT_TRUE(limiter.consume(1, start_ + milliseconds(1000)));
+}
+
+TEST_F(RateLimiterTest, max_sources)
+{
+    RateLimiter<uint32_t> limiter{10, 1, 2};
+
+    ASSERT_TRUE(limiter.consume(1, start_));
+    ASSERT_TRUE(limiter.consume(2, start_));
+
+    /* No room for a third source, it is let through untracked. */
+    ASSERT_TRUE(limiter.consume(3, start_));
+    ASSERT_TRUE(limiter.consume(3, start_));
+    ASSERT_EQ(limiter.get_size(), 2u);
+
+    /* Idle sources are forgotten to track new ones. */
+    ASSERT_TRUE(limiter.consume(3, start_ + milliseconds(100)));
+    ASSERT_FALSE(limiter.consume(3, start_ + milliseconds(100)));
+    ASSERT_EQ(limiter.get_size(), 1u);
+}
+
+} // namespace testing
+} // namespace uxr
+} // namespace eprosima
@@ -0,0 +1,121 @@
+// Copyright 2017 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <uxr/agent/utils/RcuMap.hpp>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace eprosima {
+namespace uxr {
+namespace testing {
+
+using eprosima::uxr::utils::RcuMap;
+
+TEST(RcuMapTest, AssignFindErase)
+{
+    /* Few buckets, so that keys share them. */
+    RcuMap<uint32_t, uint32_t, std::hash<uint32_t>, 4> map;
+    for (uint32_t i = 0; i < 16; ++i)
+    {
+        map.assign(i, i * 10);
+    }
+
+    uint32_t value = 0;
+    ASSERT_TRUE(map.get(5, value));
+    ASSERT_EQ(50u, value);
+    ASSERT_FALSE(map.get(16, value));
+
+    map.assign(5, 55);
+    ASSERT_TRUE(map.get(5, value));
+    ASSERT_EQ(55u, value);
+
+    ASSERT_TRUE(map.erase(5));
+    ASSERT_FALSE(map.erase(5));
+    ASSERT_FALSE(map.get(5, value));
+    ASSERT_TRUE(map.get(9, value));
+    ASSERT_EQ(90u, value);
+
+    size_t count = 0;
+    map.for_each([&](uint32_t){ ++count; });
+    ASSERT_EQ(15u, count);
+
+    map.clear();
+    count = 0;
+    map.for_each([&](uint32_t){ ++count; });
+    ASSERT_EQ(0u, count);
+}
+
+TEST(RcuMapTest, ConcurrentReaders)
+{
+    /* Values must never be seen destroyed, even while being replaced or erased. */
+    RcuMap<uint32_t, std::shared_ptr<uint32_t>, std::hash<uint32_t>, 4> map;
+    const uint32_t stable_key = 1000;
+    map.assign(stable_key, std::make_shared<uint32_t>(stable_key));
+
+    std::atomic<bool> running{true};
+    std::atomic<size_t> errors{0};
+    std::vector<std::thread> readers;
+    for (uint32_t i = 0; i < 4; ++i)
+    {
+        readers.emplace_back([&, i]()
+        {
+            while (running)
+            {
+                const uint32_t key = i % 2;
+                map.find(key, [&](const std::shared_ptr<uint32_t>& value)
+                {
+                    if (key != *value % 2)
+                    {
+                        ++errors;
+                    }
+                });
+                if (!map.find(stable_key, [](const std::shared_ptr<uint32_t>&){}))
+                {
+                    ++errors;
+                }
+            }
+        });
+    }
+
+    for (uint32_t i = 0; i < 10000; ++i)
+    {
+        map.assign(i % 2, std::make_shared<uint32_t>(i));
+        if (0 == i % 3)
+        {
+            map.erase(i % 2);
+        }
+    }
+
+    running = false;
+    for (auto& reader : readers)
+    {
+        reader.join();
+    }
+    ASSERT_EQ(0u, errors.load());
+}
+
+} // namespace testing
+} // namespace uxr
+} // namespace eprosima
+
+int main(int args, char** argv)
+{
+    ::testing::InitGoogleTest(&args, argv);
+    return RUN_ALL_TESTS();
+}